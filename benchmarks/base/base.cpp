@@ -79,8 +79,11 @@ static uint64_t BenchmarkNative()
     return hash;
 }
 
-static uint64_t BenchmarkFFRT()
+static uint64_t BenchmarkFFRT(bool nonblocking)
 {
+    ffrt::task_attr attr;
+    attr.nonblocking(nonblocking);
+
     uint64_t* arr = new uint64_t[sz];
     std::mt19937_64 rnd(0);
     // initialize the array
@@ -96,10 +99,53 @@ static uint64_t BenchmarkFFRT()
 
         // submit a task
         ffrt::submit([idx, &arr]() { arr[idx[2]] = func(arr[idx[0]], arr[idx[1]]); }, {&arr[idx[0]], &arr[idx[1]]},
-            {&arr[idx[2]]});
+            {&arr[idx[2]]}, attr);
+    }
+    ffrt::wait();
+    TIME_END_INFO(t, nonblocking ? "benchmark_ffrt_nonblocking" : "benchmark_ffrt");
+
+    // calculate FNV hash of the array
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint64_t i = 0; i < sz; i++) {
+        hash = (hash * 1099511628211ULL) ^ arr[i];
+    }
+    delete[] arr;
+    return hash;
+}
+
+static uint64_t BenchmarkFFRTBatch()
+{
+    constexpr uint64_t batch = 1000;
+
+    uint64_t* arr = new uint64_t[sz];
+    std::mt19937_64 rnd(0);
+    // initialize the array
+    for (uint64_t i = 0; i < sz; i++) {
+        arr[i] = rnd();
+    }
+    // do computation randomly
+    TIME_BEGIN(t);
+    std::vector<std::function<void()>> funcs;
+    std::vector<std::vector<const void*>> ins;
+    std::vector<std::vector<const void*>> outs;
+    for (uint64_t i = 0; i < iter; i++) {
+        // generate 3 different indexes
+        uint64_t idx[3] = {};
+        GenerateIndexes(rnd, idx);
+
+        // collect the task, submit every batch tasks
+        funcs.emplace_back([idx, &arr]() { arr[idx[2]] = func(arr[idx[0]], arr[idx[1]]); });
+        ins.push_back({&arr[idx[0]], &arr[idx[1]]});
+        outs.push_back({&arr[idx[2]]});
+        if (funcs.size() == batch || i == iter - 1) {
+            ffrt::submit_n(std::move(funcs), ins, outs);
+            funcs.clear();
+            ins.clear();
+            outs.clear();
+        }
     }
     ffrt::wait();
-    TIME_END_INFO(t, "benchmark_ffrt");
+    TIME_END_INFO(t, "benchmark_ffrt_batch");
 
     // calculate FNV hash of the array
     uint64_t hash = 14695981039346656037ULL;
@@ -114,5 +160,7 @@ int main()
 {
     GetEnvs();
     BenchmarkNative();
-    BenchmarkFFRT();
+    BenchmarkFFRT(false);
+    BenchmarkFFRT(true); // tasks run on the worker stack
+    BenchmarkFFRTBatch();
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "ffrt.h"
+#include "common.h"
+
+constexpr uint32_t BLOCKING_READER_NUM = 12; // more than the default max concurrency of a qos, less than its hard limit
+constexpr uint32_t BLOCKING_CPU_TASK_NUM = 400;
+constexpr uint32_t BLOCKING_CPU_TASK_US = 100;
+constexpr uint32_t BLOCKING_WRITE_TIMEOUT_MS = 2000;
+
+/*
+ * The readers block in read() on their own pipe until all cpu tasks are done, or until the writer gives up
+ * waiting. Without compensation for workers blocked in the kernel the cpu tasks queue behind the readers and
+ * only run once the writer times out.
+ */
+void PipeBlock()
+{
+    PreHotFFRT();
+
+    std::vector<int> fds(BLOCKING_READER_NUM * 2);
+    for (uint32_t i = 0; i < BLOCKING_READER_NUM; i++) {
+        if (pipe(&fds[i * 2]) != 0) {
+            printf("create pipe failed\n");
+            return;
+        }
+    }
+
+    std::atomic<uint32_t> cpuDone {0};
+    std::thread writer([&]() {
+        auto deadline = CLOCK + std::chrono::milliseconds(BLOCKING_WRITE_TIMEOUT_MS);
+        while (cpuDone.load() < BLOCKING_CPU_TASK_NUM && CLOCK < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        char c = 0;
+        for (uint32_t i = 0; i < BLOCKING_READER_NUM; i++) {
+            EXPECT(write(fds[i * 2 + 1], &c, 1) == 1);
+        }
+    });
+
+    TIME_BEGIN(t);
+    for (uint32_t i = 0; i < BLOCKING_READER_NUM; i++) {
+        int fd = fds[i * 2];
+        ffrt::submit([fd]() {
+            char c;
+            EXPECT(read(fd, &c, 1) == 1);
+        }, {}, {});
+    }
+    for (uint32_t i = 0; i < BLOCKING_CPU_TASK_NUM; i++) {
+        ffrt::submit([&cpuDone]() {
+            simulate_task_compute_time(BLOCKING_CPU_TASK_US);
+            cpuDone++;
+        }, {}, {});
+    }
+    while (cpuDone.load() < BLOCKING_CPU_TASK_NUM) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    TIME_END_INFO(t, "blocking_io_cpu_tasks");
+    ffrt::wait();
+    TIME_END_INFO(t, "blocking_io_total");
+
+    writer.join();
+    for (auto fd : fds) {
+        close(fd);
+    }
+}
+
+int main()
+{
+    GetEnvs();
+    for (uint64_t i = 0; i < REPEAT; i++) {
+        PipeBlock();
+    }
+}
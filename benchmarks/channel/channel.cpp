@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <queue>
+#include <mutex>
+#include "ffrt.h"
+#include "common.h"
+
+constexpr uint32_t CHANNEL_ITEM_NUM = 200000;
+constexpr size_t CHANNEL_CAPACITY = 256;
+constexpr uint32_t CHANNEL_BATCH = 32;
+constexpr uint32_t CHANNEL_PINGPONG_NUM = 20000;
+constexpr uint32_t CHANNEL_TASK_NUMS[] = {1, 4, 16};
+
+// the bounded queue a channel replaces: a deque under a mutex with a condition variable per direction
+template <typename T>
+class LockedQueue {
+public:
+    explicit LockedQueue(size_t capacity) : cap(capacity)
+    {
+    }
+
+    void Send(const T& v)
+    {
+        std::unique_lock<ffrt::mutex> lk(mtx);
+        notFull.wait(lk, [this] { return q.size() < cap; });
+        q.push(v);
+        notEmpty.notify_one();
+    }
+
+    bool Recv(T& v)
+    {
+        std::unique_lock<ffrt::mutex> lk(mtx);
+        notEmpty.wait(lk, [this] { return !q.empty() || closed; });
+        if (q.empty()) {
+            return false;
+        }
+        v = q.front();
+        q.pop();
+        notFull.notify_one();
+        return true;
+    }
+
+    void Close()
+    {
+        std::lock_guard<ffrt::mutex> lk(mtx);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    ffrt::mutex mtx;
+    ffrt::condition_variable notEmpty;
+    ffrt::condition_variable notFull;
+    std::queue<T> q;
+    size_t cap;
+    bool closed = false;
+};
+
+// taskNum producers and as many consumers move CHANNEL_ITEM_NUM items in total
+template <typename Send, typename Recv, typename Close>
+static void Throughput(const char* name, uint32_t taskNum, Send&& send, Recv&& recv, Close&& close)
+{
+    char info[64];
+    snprintf(info, sizeof(info), "%s tasks %u", name, taskNum);
+    std::atomic<uint64_t> sum {0};
+    std::atomic<uint32_t> producing {taskNum};
+    uint32_t perTask = CHANNEL_ITEM_NUM / taskNum;
+
+    TIME_BEGIN(t);
+    for (uint32_t i = 0; i < taskNum; i++) {
+        ffrt::submit([&]() { sum += recv(); }, {}, {});
+        ffrt::submit([&]() {
+            send(perTask);
+            if (--producing == 0) {
+                close();
+            }
+        }, {}, {});
+    }
+    ffrt::wait();
+    TIME_END_INFO(t, info);
+    EXPECT(sum.load() == static_cast<uint64_t>(perTask) * taskNum);
+}
+
+static void ThroughputChannel(uint32_t taskNum)
+{
+    ffrt::channel<uint32_t> ch(CHANNEL_CAPACITY);
+    Throughput("channel", taskNum,
+        [&](uint32_t n) {
+            for (uint32_t i = 0; i < n; i++) {
+                ch.send(1);
+            }
+        },
+        [&]() {
+            uint64_t got = 0;
+            uint32_t v = 0;
+            while (ch.recv(v)) {
+                got += v;
+            }
+            return got;
+        },
+        [&]() { ch.close(); });
+}
+
+static void ThroughputChannelBatch(uint32_t taskNum)
+{
+    ffrt::channel<uint32_t> ch(CHANNEL_CAPACITY);
+    Throughput("channel_batch", taskNum,
+        [&](uint32_t n) {
+            uint32_t items[CHANNEL_BATCH];
+            std::fill(items, items + CHANNEL_BATCH, 1);
+            for (uint32_t i = 0; i < n; i += CHANNEL_BATCH) {
+                ch.send_n(items, std::min(CHANNEL_BATCH, n - i));
+            }
+        },
+        [&]() {
+            uint64_t got = 0;
+            uint32_t items[CHANNEL_BATCH];
+            size_t k;
+            while ((k = ch.recv_n(items, CHANNEL_BATCH)) != 0) {
+                for (size_t i = 0; i < k; i++) {
+                    got += items[i];
+                }
+            }
+            return got;
+        },
+        [&]() { ch.close(); });
+}
+
+static void ThroughputLocked(uint32_t taskNum)
+{
+    LockedQueue<uint32_t> q(CHANNEL_CAPACITY);
+    Throughput("mutex_cond", taskNum,
+        [&](uint32_t n) {
+            for (uint32_t i = 0; i < n; i++) {
+                q.Send(1);
+            }
+        },
+        [&]() {
+            uint64_t got = 0;
+            uint32_t v = 0;
+            while (q.Recv(v)) {
+                got += v;
+            }
+            return got;
+        },
+        [&]() { q.Close(); });
+}
+
+// two tasks bounce a token back and forth, every hop blocks the receiver: the cost of one wake up
+template <typename Ping, typename Pong>
+static void Latency(const char* name, Ping& ping, Pong& pong)
+{
+    TIME_BEGIN(t);
+    ffrt::submit([&]() {
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < CHANNEL_PINGPONG_NUM; i++) {
+            ping.Recv(v);
+            pong.Send(v + 1);
+        }
+    }, {}, {});
+    ffrt::submit([&]() {
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < CHANNEL_PINGPONG_NUM; i++) {
+            ping.Send(v);
+            pong.Recv(v);
+        }
+        EXPECT(v == CHANNEL_PINGPONG_NUM);
+    }, {}, {});
+    ffrt::wait();
+    char info[64];
+    snprintf(info, sizeof(info), "%s pingpong %u", name, CHANNEL_PINGPONG_NUM);
+    TIME_END_INFO(t, info);
+}
+
+struct ChannelEnd {
+    ffrt::channel<uint32_t> ch {1};
+
+    void Send(uint32_t v)
+    {
+        ch.send(v);
+    }
+
+    void Recv(uint32_t& v)
+    {
+        ch.recv(v);
+    }
+};
+
+void Channel()
+{
+    PreHotFFRT();
+
+    for (uint32_t taskNum : CHANNEL_TASK_NUMS) {
+        ThroughputLocked(taskNum);
+        ThroughputChannel(taskNum);
+        ThroughputChannelBatch(taskNum);
+    }
+
+    LockedQueue<uint32_t> lockedPing(1);
+    LockedQueue<uint32_t> lockedPong(1);
+    Latency("mutex_cond", lockedPing, lockedPong);
+    ChannelEnd ping;
+    ChannelEnd pong;
+    Latency("channel", ping, pong);
+}
+
+int main()
+{
+    GetEnvs();
+    for (uint64_t i = 0; i < REPEAT; i++) {
+        Channel();
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include "ffrt.h"
+#include "common.h"
+
+constexpr uint32_t BROADCAST_ROUND_NUM = 500;
+constexpr uint32_t BROADCAST_CONSUMER_NUMS[] = {4, 16, 64};
+
+static long ContextSwitches()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+/*
+ * Every round the producer bumps a generation under the mutex, broadcasts it and waits until all consumers
+ * acknowledged it, so each broadcast wakes every consumer while the producer still holds the mutex.
+ */
+template <typename Mutex, typename Cond>
+struct Broadcast {
+    Mutex mtx;
+    Cond cv;
+    Cond cvDone;
+    uint32_t gen = 0;
+    uint32_t acked = 0;
+    uint32_t consumerNum;
+
+    explicit Broadcast(uint32_t num) : consumerNum(num)
+    {
+    }
+
+    void Produce()
+    {
+        std::unique_lock<Mutex> lk(mtx);
+        for (uint32_t round = 1; round <= BROADCAST_ROUND_NUM + 1; round++) {
+            gen = round;
+            acked = 0;
+            cv.notify_all();
+            if (round <= BROADCAST_ROUND_NUM) {
+                cvDone.wait(lk, [this] { return acked == consumerNum; });
+            }
+        }
+    }
+
+    void Consume()
+    {
+        std::unique_lock<Mutex> lk(mtx);
+        uint32_t seen = 0;
+        for (;;) {
+            cv.wait(lk, [this, seen] { return gen != seen; });
+            seen = gen;
+            if (seen > BROADCAST_ROUND_NUM) {
+                break;
+            }
+            if (++acked == consumerNum) {
+                cvDone.notify_one();
+            }
+        }
+    }
+};
+
+static void BroadcastFFRT(uint32_t consumerNum)
+{
+    Broadcast<ffrt::mutex, ffrt::condition_variable> b(consumerNum);
+    char info[64];
+    snprintf(info, sizeof(info), "ffrt_cond consumers %u", consumerNum);
+
+    long csw = ContextSwitches();
+    TIME_BEGIN(t);
+    for (uint32_t i = 0; i < consumerNum; i++) {
+        ffrt::submit([&b]() { b.Consume(); }, {}, {});
+    }
+    ffrt::submit([&b]() { b.Produce(); }, {}, {});
+    ffrt::wait();
+    TIME_END_INFO(t, info);
+    ffrt_mutex_stat_t s = b.mtx.stat();
+    printf("%s contended %u parked %u context switches %ld\n", info, s.contended, s.parked,
+        ContextSwitches() - csw);
+}
+
+static void BroadcastStd(uint32_t consumerNum)
+{
+    Broadcast<std::mutex, std::condition_variable> b(consumerNum);
+    char info[64];
+    snprintf(info, sizeof(info), "std_cond consumers %u", consumerNum);
+
+    long csw = ContextSwitches();
+    TIME_BEGIN(t);
+    std::vector<std::thread> consumers;
+    for (uint32_t i = 0; i < consumerNum; i++) {
+        consumers.emplace_back([&b]() { b.Consume(); });
+    }
+    b.Produce();
+    for (auto& c : consumers) {
+        c.join();
+    }
+    TIME_END_INFO(t, info);
+    printf("%s context switches %ld\n", info, ContextSwitches() - csw);
+}
+
+void CondBroadcast()
+{
+    PreHotFFRT();
+
+    for (uint32_t consumerNum : BROADCAST_CONSUMER_NUMS) {
+        BroadcastStd(consumerNum);
+        BroadcastFFRT(consumerNum);
+    }
+}
+
+int main()
+{
+    GetEnvs();
+    for (uint64_t i = 0; i < REPEAT; i++) {
+        CondBroadcast();
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ffrt.h"
+#include "common.h"
+
+constexpr uint32_t EDF_FRAME_NUM = 300;
+constexpr uint32_t EDF_FRAME_INTERVAL_US = 1000;
+constexpr uint32_t EDF_BG_PER_CPU = 6; // background work per frame is 1.2 frames per cpu, the qos is overloaded
+constexpr uint32_t EDF_BG_TASK_US = 200;
+constexpr uint64_t EDF_BG_DEADLINE_US = 100000;
+constexpr uint32_t EDF_URGENT_PER_FRAME = 2;
+constexpr uint32_t EDF_URGENT_TASK_US = 50;
+constexpr uint64_t EDF_URGENT_DEADLINE_US = 2000;
+
+static inline int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(CLOCK.time_since_epoch()).count();
+}
+
+/*
+ * Every frame submits a burst of background tasks with a loose deadline and a few urgent ones with a tight
+ * deadline to the same qos. Run with FFRT_SCHED_POLICY=fifo and FFRT_SCHED_POLICY=edf to compare the latency
+ * of the urgent tasks.
+ */
+void FrameLatency()
+{
+    PreHotFFRT();
+
+    uint32_t bgNum = std::max(1U, std::thread::hardware_concurrency()) * EDF_BG_PER_CPU;
+    std::vector<int64_t> latency(EDF_FRAME_NUM * EDF_URGENT_PER_FRAME);
+    std::atomic<uint32_t> bgMiss {0};
+    TIME_BEGIN(t);
+    for (uint32_t f = 0; f < EDF_FRAME_NUM; f++) {
+        int64_t frameStart = NowUs();
+        for (uint32_t i = 0; i < bgNum; i++) {
+            ffrt::submit([frameStart, &bgMiss]() {
+                simulate_task_compute_time(EDF_BG_TASK_US);
+                if (NowUs() - frameStart > static_cast<int64_t>(EDF_BG_DEADLINE_US)) {
+                    bgMiss++;
+                }
+            }, {}, {}, ffrt::task_attr().deadline(EDF_BG_DEADLINE_US));
+        }
+        for (uint32_t i = 0; i < EDF_URGENT_PER_FRAME; i++) {
+            int64_t* lat = &latency[f * EDF_URGENT_PER_FRAME + i];
+            ffrt::submit([frameStart, lat]() {
+                simulate_task_compute_time(EDF_URGENT_TASK_US);
+                *lat = NowUs() - frameStart;
+            }, {}, {}, ffrt::task_attr().deadline(EDF_URGENT_DEADLINE_US));
+        }
+        std::this_thread::sleep_until(CLOCK + std::chrono::microseconds(EDF_FRAME_INTERVAL_US));
+    }
+    ffrt::wait();
+    TIME_END_INFO(t, "edf_frame_total");
+
+    std::sort(latency.begin(), latency.end());
+    auto urgentMiss = latency.end() - std::upper_bound(latency.begin(), latency.end(), EDF_URGENT_DEADLINE_US);
+    printf("urgent latency p50 %" PRId64 " us p99 %" PRId64 " us max %" PRId64 " us, missed %ld/%zu\n",
+        latency[latency.size() / 2], latency[latency.size() * 99 / 100], latency.back(),
+        static_cast<long>(urgentMiss), latency.size());
+    printf("background missed %u/%u\n", bgMiss.load(), bgNum * EDF_FRAME_NUM);
+}
+
+int main()
+{
+    GetEnvs();
+    FrameLatency();
+}
@@ -78,7 +78,15 @@ void FibDataWait()
     TIME_END_INFO(t, "fib_data_wait");
 }
 
-void FibFFRTNoWait(int x, int* y)
+const ffrt::task_attr& NoWaitAttr(bool nonblocking)
+{
+    // none of the no wait tasks blocks, they may all run on the worker stack
+    static ffrt::task_attr attrs[2];
+    static ffrt::task_attr& nonblockingAttr = attrs[1].nonblocking(true);
+    return nonblocking ? nonblockingAttr : attrs[0];
+}
+
+void FibFFRTNoWait(int x, int* y, bool nonblocking)
 {
     if (x <= 1) {
         *y = x;
@@ -86,20 +94,21 @@ void FibFFRTNoWait(int x, int* y)
         int *y1, *y2;
         y1 = reinterpret_cast<int *>(malloc(sizeof(int)));
         y2 = reinterpret_cast<int *>(malloc(sizeof(int)));
-        ffrt::submit([=]() { FibFFRTNoWait(x - 1, y1); }, {}, {y1});
-        ffrt::submit([=]() { FibFFRTNoWait(x - 2, y2); }, {}, {y2});
+        const ffrt::task_attr& attr = NoWaitAttr(nonblocking);
+        ffrt::submit([=]() { FibFFRTNoWait(x - 1, y1, nonblocking); }, {}, {y1}, attr);
+        ffrt::submit([=]() { FibFFRTNoWait(x - 2, y2, nonblocking); }, {}, {y2}, attr);
         ffrt::submit(
             [=]() {
                 *y = *y1 + *y2;
                 free(y1);
                 free(y2);
             },
-            {y1, y2}, {y});
+            {y1, y2}, {y}, attr);
     }
     simulate_task_compute_time(COMPUTE_TIME_US);
 }
 
-void FibNoWait()
+void FibNoWait(bool nonblocking)
 {
     PreHotFFRT();
 
@@ -112,10 +121,11 @@ void FibNoWait()
 
     TIME_BEGIN(t);
     for (uint64_t i = 0; i < REPEAT; ++i) {
-        ffrt::submit([&]() { FibFFRTNoWait(FIB_NUM, &output); }, {}, {&output});
+        ffrt::submit([&]() { FibFFRTNoWait(FIB_NUM, &output, nonblocking); }, {}, {&output},
+            NoWaitAttr(nonblocking));
         ffrt::wait({&output});
     }
-    TIME_END_INFO(t, "fib_no_wait");
+    TIME_END_INFO(t, nonblocking ? "fib_no_wait_nonblocking" : "fib_no_wait");
 }
 
 void FibChildWait()
@@ -141,5 +151,6 @@ int main()
     GetEnvs();
     FibDataWait();
     FibChildWait();
-    FibNoWait();
+    FibNoWait(false);
+    FibNoWait(true);
 }
\ No newline at end of file
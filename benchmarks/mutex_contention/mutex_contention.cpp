@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <mutex>
+#include "ffrt.h"
+#include "common.h"
+
+constexpr uint32_t MUTEX_LOCK_PER_TASK = 2000;
+constexpr uint32_t MUTEX_CRITICAL_WORK = 50; // loop iterations inside the critical section
+constexpr uint32_t MUTEX_TASK_NUMS[] = {2, 4, 8, 16, 32, 64};
+
+static inline void CriticalWork(uint64_t& counter)
+{
+    for (uint32_t i = 0; i < MUTEX_CRITICAL_WORK; i++) {
+        counter = counter * 31 + i;
+    }
+}
+
+template <typename Mutex>
+static void Contend(Mutex& mtx, uint32_t taskNum, const char* name)
+{
+    uint64_t counter = 0;
+    char info[64];
+    snprintf(info, sizeof(info), "%s tasks %u", name, taskNum);
+
+    TIME_BEGIN(t);
+    for (uint32_t i = 0; i < taskNum; i++) {
+        ffrt::submit([&]() {
+            for (uint32_t j = 0; j < MUTEX_LOCK_PER_TASK; j++) {
+                std::lock_guard<Mutex> lk(mtx);
+                CriticalWork(counter);
+            }
+        }, {}, {});
+    }
+    ffrt::wait();
+    TIME_END_INFO(t, info);
+}
+
+static void ContendFFRT(ffrt_mutex_type_t type, uint32_t taskNum, const char* name)
+{
+    ffrt::mutex mtx(type);
+    Contend(mtx, taskNum, name);
+    ffrt_mutex_stat_t s = mtx.stat();
+    printf("%s tasks %u contended %u spun %u parked %u handoff %u\n", name, taskNum, s.contended, s.spun, s.parked,
+        s.handoff);
+}
+
+/*
+ * Tasks hammering one mutex around a short critical section. FFRT_MUTEX_SPIN_MAX=0 gives the ffrt mutex
+ * without spinning, which parks every contended lock.
+ */
+void MutexContention()
+{
+    PreHotFFRT();
+
+    for (uint32_t taskNum : MUTEX_TASK_NUMS) {
+        std::mutex stdMtx;
+        Contend(stdMtx, taskNum, "std_mutex");
+        ContendFFRT(ffrt_mutex_normal, taskNum, "ffrt_mutex");
+        ContendFFRT(ffrt_mutex_handoff, taskNum, "ffrt_mutex_handoff");
+    }
+}
+
+int main()
+{
+    GetEnvs();
+    for (uint64_t i = 0; i < REPEAT; i++) {
+        MutexContention();
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include "ffrt.h"
+#include "common.h"
+
+constexpr uint64_t PARALLEL_FOR_SIZE = 1000000;
+constexpr uint64_t PARALLEL_FOR_GRAIN = 1000;
+
+static inline uint64_t Work(uint64_t i)
+{
+    uint64_t x = i;
+    for (int k = 0; k < 16; k++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    simulate_task_compute_time(COMPUTE_TIME_US);
+    return x >> 32;
+}
+
+// the loop the parallel primitives replace: a task per grain sized chunk
+void SubmitLoop()
+{
+    PreHotFFRT();
+
+    std::atomic<uint64_t> sum {0};
+    TIME_BEGIN(t);
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        for (uint64_t b = 0; b < PARALLEL_FOR_SIZE; b += PARALLEL_FOR_GRAIN) {
+            ffrt::submit([b, &sum]() {
+                uint64_t acc = 0;
+                for (uint64_t i = b; i < b + PARALLEL_FOR_GRAIN; i++) {
+                    acc += Work(i);
+                }
+                sum += acc;
+            }, {}, {});
+        }
+        ffrt::wait();
+    }
+    TIME_END_INFO(t, "parallel_for_submit_loop");
+    printf("sum %" PRIu64 "\n", sum.load());
+}
+
+void ParallelFor()
+{
+    PreHotFFRT();
+
+    std::atomic<uint64_t> sum {0};
+    TIME_BEGIN(t);
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        ffrt::parallel_for(0, PARALLEL_FOR_SIZE, PARALLEL_FOR_GRAIN, [&sum](uint64_t i) { sum += Work(i); });
+    }
+    TIME_END_INFO(t, "parallel_for");
+    printf("sum %" PRIu64 "\n", sum.load());
+}
+
+void ParallelReduce()
+{
+    PreHotFFRT();
+
+    uint64_t sum = 0;
+    TIME_BEGIN(t);
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        sum += ffrt::parallel_reduce(0, PARALLEL_FOR_SIZE, 0, uint64_t(0), Work,
+            [](uint64_t a, uint64_t b) { return a + b; });
+    }
+    TIME_END_INFO(t, "parallel_reduce");
+    printf("sum %" PRIu64 "\n", sum);
+}
+
+int main()
+{
+    GetEnvs();
+    SubmitLoop();
+    ParallelFor();
+    ParallelReduce();
+}
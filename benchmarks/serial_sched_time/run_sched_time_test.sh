@@ -36,7 +36,13 @@ FFRT_LOG_LEVEL=0 ./benchmarks/serial_sched_time/serial_sched_time_test |tee seri
 rm -f ${benchmark_dir}/output/serial_sched_time_test.csv
 echo duration sched_time >> ${benchmark_dir}/output/serial_sched_time_test.csv
 # use spaces and ':' to split log lines
-awk -F '[ :]' '{print $6,$12}' serial_sched_time_test.log >>${benchmark_dir}/output/serial_sched_time_test.csv
+awk -F '[ :]' '/^completely serial/ {print $6,$12}' serial_sched_time_test.log \
+    >>${benchmark_dir}/output/serial_sched_time_test.csv
+
+rm -f ${benchmark_dir}/output/serial_queue_sched_time_test.csv
+echo duration sched_time >> ${benchmark_dir}/output/serial_queue_sched_time_test.csv
+awk -F '[ :]' '/^serial queue/ {print $6,$12}' serial_sched_time_test.log \
+    >>${benchmark_dir}/output/serial_queue_sched_time_test.csv
 
 cd ${benchmark_dir}/output
 ${benchmark_dir}/serial_sched_time/plot.py ${benchmark_dir}/output/serial_sched_time_test.csv ${benchmark_dir}/serial_sched_time/base.csv
@@ -18,6 +18,20 @@
 
 static std::vector<uint32_t> duration_sample = {50, 60, 70, 80, 90, 100, 120, 140, 160, 180, 200, 500, 1000};
 
+// zero delay tasks posted to a serial queue back to back, the last one is waited for
+static void serial_queue(uint32_t count, uint32_t duration, int64_t& time)
+{
+    ffrt::queue q("serial_sched_time");
+    uint32_t loop = count - 1;
+    auto start = std::chrono::steady_clock::now();
+    while (loop--) {
+        q.submit([duration]() { simulate_task_compute_time(duration); });
+    }
+    ffrt::task_handle last = q.submit_h([duration]() { simulate_task_compute_time(duration); });
+    q.wait(last);
+    time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 int main()
 {
     int64_t ffrt_time;
@@ -33,5 +47,14 @@ int main()
                "sched_time:%.2f\n",
             count, duration_sample[i], ffrt_time, single_t_time, sched_time);
     }
+
+    for (uint32_t i = 0; i < duration_sample.size(); i++) {
+        single_thread(count, duration_sample[i], single_t_time);
+        serial_queue(count, duration_sample[i], ffrt_time);
+        float sched_time = (1.0f * ffrt_time - single_t_time) / count;
+        printf("serial queue count:%u duration:%u ffrt_time:%ld single_t_time:%ld "
+               "sched_time:%.2f\n",
+            count, duration_sample[i], ffrt_time, single_t_time, sched_time);
+    }
     return 0;
 }
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "ffrt.h"
+#include "common.h"
+
+constexpr uint32_t TASK_CYCLE_COUNT = 200000;
+constexpr uint32_t TASK_CYCLE_DATA = 64;
+
+// submit -> run -> done of empty tasks, the cost is dominated by TaskCtx setup and recycling
+void TaskCycle(uint32_t depNum, const char* info)
+{
+    PreHotFFRT();
+
+    std::vector<uint64_t> data(TASK_CYCLE_DATA);
+    TIME_BEGIN(t);
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        for (uint32_t i = 0; i < TASK_CYCLE_COUNT; i++) {
+            std::vector<const void*> ins;
+            for (uint32_t d = 1; d < depNum; d++) {
+                ins.push_back(&data[(i + d) % TASK_CYCLE_DATA]);
+            }
+            std::vector<const void*> outs;
+            if (depNum > 0) {
+                outs.push_back(&data[i % TASK_CYCLE_DATA]);
+            }
+            ffrt::submit([]() {}, ins, outs);
+        }
+        ffrt::wait();
+    }
+    TIME_END_INFO(t, info);
+}
+
+void NestedTaskCycle()
+{
+    PreHotFFRT();
+
+    TIME_BEGIN(t);
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        ffrt::submit([]() {
+            for (uint32_t i = 0; i < TASK_CYCLE_COUNT; i++) {
+                ffrt::submit([]() {}, {}, {});
+            }
+            ffrt::wait();
+        }, {}, {});
+        ffrt::wait();
+    }
+    TIME_END_INFO(t, "task_cycle_nested");
+}
+
+int main()
+{
+    GetEnvs();
+    TaskCycle(0, "task_cycle_no_dep");
+    TaskCycle(1, "task_cycle_1_dep");
+    TaskCycle(4, "task_cycle_4_dep");
+    NestedTaskCycle();
+}
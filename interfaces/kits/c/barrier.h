@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_API_C_BARRIER_H
+#define FFRT_API_C_BARRIER_H
+#include "type_def.h"
+
+typedef void (*ffrt_barrier_completion_t)(void* arg);
+
+FFRT_C_API int ffrt_latch_init(ffrt_latch_t* latch, uint32_t count);
+FFRT_C_API int ffrt_latch_count_down(ffrt_latch_t* latch, uint32_t n);
+FFRT_C_API int ffrt_latch_try_wait(const ffrt_latch_t* latch);
+FFRT_C_API int ffrt_latch_wait(ffrt_latch_t* latch);
+FFRT_C_API int ffrt_latch_arrive_and_wait(ffrt_latch_t* latch, uint32_t n);
+FFRT_C_API int ffrt_latch_destroy(ffrt_latch_t* latch);
+
+/*
+ * Reusable barrier of count participants. Arrivals are counted in a combining tree, so large participant
+ * counts do not all update one counter. The completion runs on the last arrival of every phase before the
+ * others are released. An arrival beyond count in a phase fails with ffrt_error_inval and does not wait.
+ */
+FFRT_C_API int ffrt_barrier_init(ffrt_barrier_t* barrier, uint32_t count, ffrt_barrier_completion_t completion,
+    void* arg);
+FFRT_C_API int ffrt_barrier_arrive_and_wait(ffrt_barrier_t* barrier);
+// arrives for this phase and leaves the participants of the next ones
+FFRT_C_API int ffrt_barrier_arrive_and_drop(ffrt_barrier_t* barrier);
+FFRT_C_API int ffrt_barrier_destroy(ffrt_barrier_t* barrier);
+#endif
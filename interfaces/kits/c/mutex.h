@@ -16,9 +16,29 @@
 #define FFRT_API_C_MUTEX_H
 #include "type_def.h"
 
+typedef enum {
+    ffrt_mutex_normal,
+    // unlock passes the mutex to the longest waiter instead of releasing it, bounding the wait of each waiter
+    ffrt_mutex_handoff,
+} ffrt_mutex_type_t;
+
+// slow path events of one mutex since its init
+typedef struct {
+    uint32_t contended; // lock calls finding the mutex taken
+    uint32_t spun; // contended lock calls that got the mutex while spinning
+    uint32_t parked; // times a waiter was switched out or blocked
+    uint32_t handoff; // unlocks passing the mutex to a waiter
+} ffrt_mutex_stat_t;
+
+FFRT_C_API int ffrt_mutexattr_init(ffrt_mutexattr_t* attr);
+FFRT_C_API int ffrt_mutexattr_settype(ffrt_mutexattr_t* attr, int type);
+FFRT_C_API int ffrt_mutexattr_gettype(const ffrt_mutexattr_t* attr, int* type);
+FFRT_C_API int ffrt_mutexattr_destroy(ffrt_mutexattr_t* attr);
+
 FFRT_C_API int ffrt_mutex_init(ffrt_mutex_t* mutex, const ffrt_mutexattr_t* attr);
 FFRT_C_API int ffrt_mutex_lock(ffrt_mutex_t* mutex);
 FFRT_C_API int ffrt_mutex_unlock(ffrt_mutex_t* mutex);
 FFRT_C_API int ffrt_mutex_trylock(ffrt_mutex_t* mutex);
 FFRT_C_API int ffrt_mutex_destroy(ffrt_mutex_t* mutex);
+FFRT_C_API int ffrt_mutex_get_stat(ffrt_mutex_t* mutex, ffrt_mutex_stat_t* stat);
 #endif
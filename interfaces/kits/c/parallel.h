@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_API_C_PARALLEL_H
+#define FFRT_API_C_PARALLEL_H
+#include "type_def.h"
+
+typedef void (*ffrt_parallel_func_t)(void* arg, uint64_t begin, uint64_t end);
+
+/*
+ * Run func over [begin, end) split into chunks, the caller runs chunks as well and returns when all of them are done.
+ * grain is the smallest chunk, chunks grow while they finish faster than the target chunk time. 0 means 1.
+ */
+FFRT_C_API void ffrt_parallel_for(uint64_t begin, uint64_t end, uint64_t grain, ffrt_parallel_func_t func, void* arg,
+    const ffrt_task_attr_t* attr);
+#endif
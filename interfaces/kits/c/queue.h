@@ -17,7 +17,7 @@
 
 #include "type_def.h"
 
-typedef enum { ffrt_queue_serial, ffrt_queue_max } ffrt_queue_type_t;
+typedef enum { ffrt_queue_serial, ffrt_queue_concurrent, ffrt_queue_max } ffrt_queue_type_t;
 typedef void* ffrt_queue_t;
 
 // attr
@@ -29,22 +29,25 @@ FFRT_C_API void ffrt_queue_attr_set_timeout(ffrt_queue_attr_t* attr, uint64_t ti
 FFRT_C_API uint64_t ffrt_queue_attr_get_timeout(const ffrt_queue_attr_t* attr);
 FFRT_C_API void ffrt_queue_attr_set_timeoutCb(ffrt_queue_attr_t* attr, ffrt_function_header_t* f);
 FFRT_C_API ffrt_function_header_t* ffrt_queue_attr_get_timeoutCb(const ffrt_queue_attr_t* attr);
+// tasks of a concurrent queue running at once, 1 by default
+FFRT_C_API void ffrt_queue_attr_set_max_concurrency(ffrt_queue_attr_t* attr, const int max_concurrency);
+FFRT_C_API int ffrt_queue_attr_get_max_concurrency(const ffrt_queue_attr_t* attr);
 
-// create serial queue
+// create queue
 FFRT_C_API ffrt_queue_t ffrt_queue_create(ffrt_queue_type_t type, const char* name, const ffrt_queue_attr_t* attr);
 
-// destroy serial queue
+// destroy queue
 FFRT_C_API void ffrt_queue_destroy(ffrt_queue_t queue);
 
-// submit to serial queue
+// submit to queue
 FFRT_C_API void ffrt_queue_submit(ffrt_queue_t queue, ffrt_function_header_t* f, const ffrt_task_attr_t* attr);
 FFRT_C_API ffrt_task_handle_t ffrt_queue_submit_h(
     ffrt_queue_t queue, ffrt_function_header_t* f, const ffrt_task_attr_t* attr);
 
-// wait serial task
+// wait queue task
 FFRT_C_API void ffrt_queue_wait(ffrt_task_handle_t handle);
 
-// cancel serial task
+// cancel queue task
 FFRT_C_API int ffrt_queue_cancel(ffrt_task_handle_t handle);
 
 #endif // FFRT_API_C_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_API_C_SEMAPHORE_H
+#define FFRT_API_C_SEMAPHORE_H
+#include "type_def.h"
+
+FFRT_C_API int ffrt_sem_init(ffrt_sem_t* sem, uint32_t value);
+FFRT_C_API int ffrt_sem_wait(ffrt_sem_t* sem);
+FFRT_C_API int ffrt_sem_trywait(ffrt_sem_t* sem);
+// hands the permits to waiters in arrival order, the rest raise the value
+FFRT_C_API int ffrt_sem_post(ffrt_sem_t* sem, uint32_t count);
+FFRT_C_API int ffrt_sem_getvalue(const ffrt_sem_t* sem, int* value);
+FFRT_C_API int ffrt_sem_destroy(ffrt_sem_t* sem);
+#endif
@@ -25,9 +25,26 @@ FFRT_C_API void ffrt_task_attr_set_qos(ffrt_task_attr_t* attr, ffrt_qos_t qos);
 FFRT_C_API ffrt_qos_t ffrt_task_attr_get_qos(const ffrt_task_attr_t* attr);
 FFRT_C_API void ffrt_task_attr_set_delay(ffrt_task_attr_t* attr, uint64_t delay_us);
 FFRT_C_API uint64_t ffrt_task_attr_get_delay(const ffrt_task_attr_t* attr);
+FFRT_C_API void ffrt_task_attr_set_stack_size(ffrt_task_attr_t* attr, uint64_t size);
+FFRT_C_API uint64_t ffrt_task_attr_get_stack_size(const ffrt_task_attr_t* attr);
+FFRT_C_API void ffrt_task_attr_set_nonblocking(ffrt_task_attr_t* attr, bool nonblocking);
+FFRT_C_API bool ffrt_task_attr_get_nonblocking(const ffrt_task_attr_t* attr);
+FFRT_C_API void ffrt_task_attr_set_deadline(ffrt_task_attr_t* attr, uint64_t deadline_us);
+FFRT_C_API uint64_t ffrt_task_attr_get_deadline(const ffrt_task_attr_t* attr);
+FFRT_C_API void ffrt_task_attr_set_queue_priority(ffrt_task_attr_t* attr, ffrt_queue_priority_t priority);
+FFRT_C_API ffrt_queue_priority_t ffrt_task_attr_get_queue_priority(const ffrt_task_attr_t* attr);
+FFRT_C_API void ffrt_task_attr_set_cancel_token(ffrt_task_attr_t* attr, ffrt_cancel_token_t token);
+FFRT_C_API ffrt_cancel_token_t ffrt_task_attr_get_cancel_token(const ffrt_task_attr_t* attr);
+// a detached task is no child of the submitting task and does not inherit its cancel token
+FFRT_C_API void ffrt_task_attr_set_detached(ffrt_task_attr_t* attr, bool detached);
+FFRT_C_API bool ffrt_task_attr_get_detached(const ffrt_task_attr_t* attr);
 
 FFRT_C_API int ffrt_this_task_update_qos(ffrt_qos_t qos);
 FFRT_C_API uint64_t ffrt_this_task_get_id();
+// borrowed from the running task and only valid until it returns, never destroy it; derive a token with
+// ffrt_cancel_token_create to keep one beyond that
+FFRT_C_API ffrt_cancel_token_t ffrt_this_task_get_cancel_token(void);
+FFRT_C_API bool ffrt_this_task_is_cancelled(void);
 
 // deps
 #define ffrt_deps_define(name, dep1, ...) const void* __v_##name[] = {dep1, ##__VA_ARGS__}; \
@@ -39,13 +56,24 @@ FFRT_C_API void ffrt_submit_base(ffrt_function_header_t* f, const ffrt_deps_t* i
     const ffrt_task_attr_t* attr);
 FFRT_C_API ffrt_task_handle_t ffrt_submit_h_base(ffrt_function_header_t* f, const ffrt_deps_t* in_deps,
     const ffrt_deps_t* out_deps, const ffrt_task_attr_t* attr);
+FFRT_C_API void ffrt_submit_batch(ffrt_function_header_t** fs, const ffrt_deps_t* in_deps,
+    const ffrt_deps_t* out_deps, uint32_t num, const ffrt_task_attr_t* attr);
 FFRT_C_API void ffrt_task_handle_destroy(ffrt_task_handle_t handle);
 
 // skip task
 FFRT_C_API int ffrt_skip(ffrt_task_handle_t handle);
 
+// cancel, a token derived from a parent is cancelled with it, tasks inherit the token of the task submitting them
+// unless they are detached
+FFRT_C_API ffrt_cancel_token_t ffrt_cancel_token_create(ffrt_cancel_token_t parent);
+FFRT_C_API void ffrt_cancel_token_destroy(ffrt_cancel_token_t token);
+FFRT_C_API void ffrt_cancel_token_cancel(ffrt_cancel_token_t token);
+FFRT_C_API bool ffrt_cancel_token_is_cancelled(ffrt_cancel_token_t token);
+
 // wait
 FFRT_C_API void ffrt_wait_deps(const ffrt_deps_t* deps);
+// the producers of deps inherit the deadline, it moves them up on an edf qos only and never changes their qos
+FFRT_C_API void ffrt_wait_deps_with_deadline(const ffrt_deps_t* deps, uint64_t deadline_us);
 FFRT_C_API void ffrt_wait(void);
 
 // config
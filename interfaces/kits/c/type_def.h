@@ -15,6 +15,7 @@
 #ifndef FFRT_API_C_TYPE_DEF_H
 #define FFRT_API_C_TYPE_DEF_H
 #include <stdint.h>
+#include <stdbool.h>
 #include <errno.h>
 
 #ifdef __cplusplus
@@ -34,6 +35,14 @@ typedef enum {
     ffrt_qos_defined_ive,
 } ffrt_qos_t;
 
+// order of tasks within a concurrent queue, ignored by serial queues
+typedef enum {
+    ffrt_queue_priority_immediate,
+    ffrt_queue_priority_high,
+    ffrt_queue_priority_low,
+    ffrt_queue_priority_idle,
+} ffrt_queue_priority_t;
+
 typedef enum {
     ffrt_stack_protect_weak,
     ffrt_stack_protect_strong
@@ -51,6 +60,10 @@ typedef enum {
     ffrt_auto_managed_function_storage_size = 64 + sizeof(ffrt_function_header_t),
     ffrt_mutex_storage_size = 64,
     ffrt_cond_storage_size = 64,
+    ffrt_rwlock_storage_size = 64,
+    ffrt_sem_storage_size = 64,
+    ffrt_latch_storage_size = 64,
+    ffrt_barrier_storage_size = 64,
     ffrt_thread_attr_storage_size = 64,
     ffrt_queue_attr_storage_size = 128,
 } ffrt_storage_size_t;
@@ -74,6 +87,7 @@ typedef struct {
 } ffrt_queue_attr_t;
 
 typedef void* ffrt_task_handle_t;
+typedef void* ffrt_cancel_token_t;
 
 typedef enum {
     ffrt_error = -1,
@@ -92,6 +106,10 @@ typedef struct {
     long storage;
 } ffrt_mutexattr_t;
 
+typedef struct {
+    long storage;
+} ffrt_rwlockattr_t;
+
 typedef struct {
     uint32_t storage[(ffrt_thread_attr_storage_size + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
 } ffrt_thread_attr_t;
@@ -104,6 +122,22 @@ typedef struct {
     uint32_t storage[(ffrt_cond_storage_size + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
 } ffrt_cond_t;
 
+typedef struct {
+    uint32_t storage[(ffrt_rwlock_storage_size + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+} ffrt_rwlock_t;
+
+typedef struct {
+    uint32_t storage[(ffrt_sem_storage_size + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+} ffrt_sem_t;
+
+typedef struct {
+    uint32_t storage[(ffrt_latch_storage_size + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+} ffrt_latch_t;
+
+typedef struct {
+    uint32_t storage[(ffrt_barrier_storage_size + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+} ffrt_barrier_t;
+
 constexpr unsigned int MAX_CPUMAP_LENGTH = 100; // this is in c and code style
 typedef struct {
     int shares;
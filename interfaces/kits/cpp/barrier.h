@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_API_CPP_BARRIER_H
+#define FFRT_API_CPP_BARRIER_H
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "c/barrier.h"
+
+namespace ffrt {
+class latch : public ffrt_latch_t {
+public:
+    explicit latch(ptrdiff_t expected)
+    {
+        ffrt_latch_init(this, static_cast<uint32_t>(expected));
+    }
+
+    ~latch()
+    {
+        ffrt_latch_destroy(this);
+    }
+
+    latch(latch const&) = delete;
+    void operator=(latch const&) = delete;
+
+    inline void count_down(ptrdiff_t n = 1)
+    {
+        ffrt_latch_count_down(this, static_cast<uint32_t>(n));
+    }
+
+    inline bool try_wait() const noexcept
+    {
+        return ffrt_latch_try_wait(this) == ffrt_success;
+    }
+
+    inline void wait()
+    {
+        ffrt_latch_wait(this);
+    }
+
+    inline void arrive_and_wait(ptrdiff_t n = 1)
+    {
+        ffrt_latch_arrive_and_wait(this, static_cast<uint32_t>(n));
+    }
+};
+
+struct barrier_noop {
+    void operator()() noexcept
+    {
+    }
+};
+
+template <typename CompletionFunction = barrier_noop>
+class barrier : public ffrt_barrier_t {
+public:
+    explicit barrier(ptrdiff_t expected, CompletionFunction f = CompletionFunction()) : completion(std::move(f))
+    {
+        if constexpr (std::is_same_v<CompletionFunction, barrier_noop>) {
+            initialized = ffrt_barrier_init(this, static_cast<uint32_t>(expected), nullptr, nullptr) == ffrt_success;
+        } else {
+            initialized = ffrt_barrier_init(this, static_cast<uint32_t>(expected), Complete, this) == ffrt_success;
+        }
+    }
+
+    ~barrier()
+    {
+        // a barrier of no participants is never constructed
+        if (initialized) {
+            ffrt_barrier_destroy(this);
+        }
+    }
+
+    barrier(barrier const&) = delete;
+    void operator=(barrier const&) = delete;
+
+    inline void arrive_and_wait()
+    {
+        if (initialized) {
+            ffrt_barrier_arrive_and_wait(this);
+        }
+    }
+
+    inline void arrive_and_drop()
+    {
+        if (initialized) {
+            ffrt_barrier_arrive_and_drop(this);
+        }
+    }
+
+private:
+    static void Complete(void* arg)
+    {
+        static_cast<barrier*>(arg)->completion();
+    }
+
+    CompletionFunction completion;
+    bool initialized;
+};
+} // namespace ffrt
+#endif
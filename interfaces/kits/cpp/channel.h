@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_API_CPP_CHANNEL_H
+#define FFRT_API_CPP_CHANNEL_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include "mutex.h"
+#include "condition_variable.h"
+
+namespace ffrt {
+namespace detail {
+// woken by any channel of a select that gets an item or is closed
+struct channel_selector {
+    void signal()
+    {
+        std::lock_guard<mutex> lk(m_mtx);
+        m_signaled = true;
+        m_cv.notify_one();
+    }
+
+    void wait()
+    {
+        std::unique_lock<mutex> lk(m_mtx);
+        m_cv.wait(lk, [this] { return m_signaled; });
+        m_signaled = false;
+    }
+
+private:
+    mutex m_mtx;
+    condition_variable m_cv;
+    bool m_signaled {false};
+};
+
+// bounded lock-free multi producer multi consumer ring, a cell is free for position pos at sequence 2 * pos and
+// full at 2 * pos + 1, so even a ring of one cell tells both apart
+template <typename T>
+class channel_ring {
+public:
+    explicit channel_ring(size_t capacity) : m_cells(new cell[capacity]), m_cap(capacity)
+    {
+        for (size_t i = 0; i < capacity; i++) {
+            m_cells[i].seq.store(i * 2, std::memory_order_relaxed);
+        }
+    }
+
+    ~channel_ring()
+    {
+        for (size_t pos = m_head.load(); pos != m_tail.load(); pos++) {
+            m_cells[pos % m_cap].value()->~T();
+        }
+    }
+
+    channel_ring(const channel_ring&) = delete;
+    channel_ring& operator=(const channel_ring&) = delete;
+
+    // false when full, or when the receiver of the cell a lap ago has not finished yet
+    template <typename U>
+    bool try_push(U&& v)
+    {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = m_cells[pos % m_cap];
+            intptr_t diff = static_cast<intptr_t>(c.seq.load(std::memory_order_acquire) - pos * 2);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (c.storage) T(std::forward<U>(v));
+                    c.seq.store(pos * 2 + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& out)
+    {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = m_cells[pos % m_cap];
+            intptr_t diff = static_cast<intptr_t>(c.seq.load(std::memory_order_acquire) - (pos * 2 + 1));
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(*c.value());
+                    c.value()->~T();
+                    c.seq.store((pos + m_cap) * 2, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct cell {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    std::unique_ptr<cell[]> m_cells;
+    size_t m_cap;
+    alignas(64) std::atomic<size_t> m_head {0};
+    alignas(64) std::atomic<size_t> m_tail {0};
+};
+} // namespace detail
+
+/*
+ * Multi producer multi consumer channel. A bounded one passes items through a lock-free ring, an unbounded
+ * one (capacity 0) through a deque under its own mutex. Only a sender or receiver that has to block takes the
+ * channel mutex and waits on a condition variable, so blocked tasks are switched out instead of their worker.
+ * After close, sends fail and receives drain the items left, then fail.
+ */
+template <typename T>
+class channel {
+public:
+    explicit channel(size_t capacity = 0)
+        : m_ring(capacity != 0 ? std::make_unique<detail::channel_ring<T>>(capacity) : nullptr)
+    {
+    }
+
+    channel(const channel&) = delete;
+    channel& operator=(const channel&) = delete;
+
+    bool send(const T& v)
+    {
+        return send_impl(v);
+    }
+
+    bool send(T&& v)
+    {
+        return send_impl(std::move(v));
+    }
+
+    bool try_send(const T& v)
+    {
+        if (closed() || !try_push(v)) {
+            return false;
+        }
+        notify_receivers(1);
+        return true;
+    }
+
+    // blocks until all are sent, fewer only when the channel is closed
+    size_t send_n(const T* items, size_t n)
+    {
+        size_t sent = 0;
+        while (sent < n && !closed()) {
+            size_t k = 0;
+            while (sent + k < n && try_push(items[sent + k])) {
+                k++;
+            }
+            if (k != 0) {
+                sent += k;
+                notify_receivers(k);
+            } else if (send_impl(items[sent])) {
+                sent++;
+            }
+        }
+        return sent;
+    }
+
+    bool recv(T& out)
+    {
+        if (try_pop(out)) {
+            notify_senders(1);
+            return true;
+        }
+        std::unique_lock<mutex> lk(m_mtx);
+        bool ok = park(lk, m_recvCv, m_recvWaiters, [&] { return try_pop(out); });
+        lk.unlock();
+        if (ok) {
+            notify_senders(1);
+        }
+        return ok;
+    }
+
+    bool try_recv(T& out)
+    {
+        if (!try_pop(out)) {
+            return false;
+        }
+        notify_senders(1);
+        return true;
+    }
+
+    // blocks until at least one item arrives, then takes what is there up to n, 0 once closed and drained
+    size_t recv_n(T* out, size_t n)
+    {
+        if (n == 0 || !recv(out[0])) {
+            return 0;
+        }
+        size_t got = 1;
+        while (got < n && try_pop(out[got])) {
+            got++;
+        }
+        if (got > 1) {
+            notify_senders(got - 1);
+        }
+        return got;
+    }
+
+    void close()
+    {
+        m_closed.store(true, std::memory_order_seq_cst);
+        std::lock_guard<mutex> lk(m_mtx);
+        m_recvWaiters.store(0, std::memory_order_relaxed);
+        m_sendWaiters.store(0, std::memory_order_relaxed);
+        m_recvCv.notify_all();
+        m_sendCv.notify_all();
+        for (auto s : m_selectors) {
+            s->signal();
+        }
+    }
+
+    bool closed() const
+    {
+        return m_closed.load(std::memory_order_acquire);
+    }
+
+    void add_selector(detail::channel_selector* s)
+    {
+        std::lock_guard<mutex> lk(m_mtx);
+        m_selectors.push_back(s);
+        m_selectorNum.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void remove_selector(detail::channel_selector* s)
+    {
+        std::lock_guard<mutex> lk(m_mtx);
+        for (auto it = m_selectors.begin(); it != m_selectors.end(); ++it) {
+            if (*it == s) {
+                m_selectors.erase(it);
+                break;
+            }
+        }
+        m_selectorNum.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    /*
+     * Under m_mtx, registers as a waiter and tries again until done or closed. A waiter counts until a notifier
+     * takes its count along with the notification, so items arriving while a woken waiter has not run yet do not
+     * notify it again. A waiter that gets through without such a notification takes its own count back.
+     */
+    template <typename Attempt>
+    bool park(std::unique_lock<mutex>& lk, condition_variable& cv, std::atomic<size_t>& waiters, Attempt&& attempt)
+    {
+        for (;;) {
+            waiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool ok = attempt();
+            if (ok || closed()) {
+                if (waiters.load(std::memory_order_relaxed) != 0) {
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
+                return ok;
+            }
+            cv.wait(lk);
+        }
+    }
+
+    // pairs with the fence of a waiter registering before it tries again, one of both sees the other
+    static void notify(mutex& mtx, condition_variable& cv, std::atomic<size_t>& waiters, size_t n)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        std::lock_guard<mutex> lk(mtx);
+        size_t w = waiters.load(std::memory_order_relaxed);
+        if (n >= w) {
+            waiters.store(0, std::memory_order_relaxed);
+            cv.notify_all();
+            return;
+        }
+        waiters.store(w - n, std::memory_order_relaxed);
+        for (size_t i = 0; i < n; i++) {
+            cv.notify_one();
+        }
+    }
+    template <typename U>
+    bool send_impl(U&& v)
+    {
+        if (closed()) {
+            return false;
+        }
+        if (try_push(std::forward<U>(v))) {
+            notify_receivers(1);
+            return true;
+        }
+        std::unique_lock<mutex> lk(m_mtx);
+        // a failed push leaves v untouched
+        bool ok = park(lk, m_sendCv, m_sendWaiters, [&] { return try_push(std::forward<U>(v)); });
+        lk.unlock();
+        if (ok) {
+            notify_receivers(1);
+        }
+        return ok;
+    }
+
+    template <typename U>
+    bool try_push(U&& v)
+    {
+        if (m_ring) {
+            return m_ring->try_push(std::forward<U>(v));
+        }
+        std::lock_guard<mutex> lk(m_queueMtx);
+        m_queue.emplace_back(std::forward<U>(v));
+        return true;
+    }
+
+    bool try_pop(T& out)
+    {
+        if (m_ring) {
+            return m_ring->try_pop(out);
+        }
+        std::lock_guard<mutex> lk(m_queueMtx);
+        if (m_queue.empty()) {
+            return false;
+        }
+        out = std::move(m_queue.front());
+        m_queue.pop_front();
+        return true;
+    }
+
+    void notify_receivers(size_t n)
+    {
+        notify(m_mtx, m_recvCv, m_recvWaiters, n);
+        if (m_selectorNum.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<mutex> lk(m_mtx);
+            for (auto s : m_selectors) {
+                s->signal();
+            }
+        }
+    }
+
+    void notify_senders(size_t n)
+    {
+        if (m_ring) {
+            notify(m_mtx, m_sendCv, m_sendWaiters, n);
+        }
+    }
+
+    std::unique_ptr<detail::channel_ring<T>> m_ring;
+    mutex m_queueMtx;
+    std::deque<T> m_queue;
+
+    mutex m_mtx;
+    condition_variable m_recvCv;
+    condition_variable m_sendCv;
+    std::vector<detail::channel_selector*> m_selectors;
+    std::atomic<size_t> m_recvWaiters {0};
+    std::atomic<size_t> m_sendWaiters {0};
+    std::atomic<size_t> m_selectorNum {0};
+    std::atomic<bool> m_closed {false};
+};
+
+// T must be default constructible, the item is received into a local before the function gets it
+template <typename T, typename F>
+struct recv_case {
+    channel<T>& ch;
+    F fn;
+
+    bool try_fire()
+    {
+        T v;
+        if (!ch.try_recv(v)) {
+            return false;
+        }
+        fn(std::move(v));
+        return true;
+    }
+};
+
+template <typename T, typename F>
+recv_case<T, std::decay_t<F>> on_recv(channel<T>& ch, F&& fn)
+{
+    return {ch, std::forward<F>(fn)};
+}
+
+/*
+ * Receives from the first of the channels with an item and calls the function of its case with it, blocking
+ * while all are empty. Returns the index of the case, or -1 once all channels are closed and drained.
+ */
+template <typename... Cases>
+int select(Cases&&... cases)
+{
+    auto tryAll = [&]() {
+        int idx = -1;
+        int i = 0;
+        ((idx < 0 && cases.try_fire() ? idx = i : 0, i++), ...);
+        return idx;
+    };
+    int idx = tryAll();
+    if (idx >= 0) {
+        return idx;
+    }
+
+    detail::channel_selector sel;
+    (cases.ch.add_selector(&sel), ...);
+    for (;;) {
+        idx = tryAll();
+        if (idx >= 0 || (cases.ch.closed() && ...)) {
+            // a channel closed after the attempt may still hold items
+            if (idx < 0) {
+                idx = tryAll();
+            }
+            break;
+        }
+        sel.wait();
+    }
+    (cases.ch.remove_selector(&sel), ...);
+    return idx;
+}
+} // namespace ffrt
+#endif
@@ -14,10 +14,12 @@
  */
 #ifndef FFRT_API_CPP_FUTURE_H
 #define FFRT_API_CPP_FUTURE_H
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <chrono>
 #include <cassert>
+#include <vector>
 #include "condition_variable.h"
 #include "thread.h"
 
@@ -31,11 +33,22 @@ protected:
 };
 enum class future_status { ready, timeout, deferred };
 
+template <typename R>
+class future;
+
 namespace detail {
+/*
+ * Continuations must not hold the state they are stored in, nor anything owning it, or a state whose promise is
+ * destroyed without a value keeps itself alive. A state is alive while it runs its continuations inline, a
+ * continuation submitted as a task holds a reference until the task ran.
+ */
 template <typename Derived>
-struct shared_state_base : private non_copyable {
+struct shared_state_base : public std::enable_shared_from_this<Derived>, private non_copyable {
     void wait() const noexcept
     {
+        if (ready()) {
+            return;
+        }
         std::unique_lock lk(this->m_mtx);
         wait_(lk);
     }
@@ -43,6 +56,9 @@ struct shared_state_base : private non_copyable {
     template <typename Rep, typename Period>
     future_status wait_for(const std::chrono::duration<Rep, Period>& waitTime) const noexcept
     {
+        if (ready()) {
+            return future_status::ready;
+        }
         std::unique_lock<mutex> lk(m_mtx);
         return m_cv.wait_for(lk, waitTime, [this] { return get_derived().has_value(); }) ? future_status::ready :
             future_status::timeout;
@@ -51,20 +67,76 @@ struct shared_state_base : private non_copyable {
     template <typename Clock, typename Duration>
     future_status wait_until(const std::chrono::time_point<Clock, Duration>& tp) const noexcept
     {
+        if (ready()) {
+            return future_status::ready;
+        }
         std::unique_lock<mutex> lk(m_mtx);
         return m_cv.wait_until(lk, tp, [this] { return get_derived().has_value(); }) ? future_status::ready :
             future_status::timeout;
     }
 
+    // set once the value is in place, readers that see it skip the mutex
+    bool ready() const noexcept
+    {
+        return m_ready.load(std::memory_order_acquire);
+    }
+
+    /*
+     * Runs fn once the value is set, as a task of its own or, for short bookkeeping, inline on the setter.
+     * A value set already runs it right away.
+     */
+    void add_continuation(std::function<void()>&& fn, bool runInline = false)
+    {
+        {
+            std::unique_lock<mutex> lk(m_mtx);
+            if (!get_derived().has_value()) {
+                m_conts.push_back({std::move(fn), runInline});
+                return;
+            }
+        }
+        run_continuation({std::move(fn), runInline});
+    }
+
 protected:
+    struct continuation {
+        std::function<void()> fn;
+        bool runInline;
+    };
+
     void wait_(std::unique_lock<mutex>& lk) const noexcept
     {
         assert(lk.owns_lock());
         m_cv.wait(lk, [this] { return get_derived().has_value(); });
     }
 
+    // called under m_mtx right after the value is stored, the continuations are run once it is released
+    std::vector<continuation> mark_ready() noexcept
+    {
+        m_ready.store(true, std::memory_order_release);
+        return std::move(m_conts);
+    }
+
+    void run_continuations(std::vector<continuation>&& conts)
+    {
+        for (auto& c : conts) {
+            run_continuation(std::move(c));
+        }
+    }
+
+    void run_continuation(continuation&& c)
+    {
+        if (c.runInline) {
+            c.fn();
+        } else {
+            submit([self = this->shared_from_this(), fn = std::move(c.fn)] { fn(); }, {}, {},
+                task_attr().detached(true));
+        }
+    }
+
     mutable mutex m_mtx;
     mutable condition_variable m_cv;
+    std::atomic<bool> m_ready {false};
+    std::vector<continuation> m_conts;
 
 private:
     const Derived& get_derived() const
@@ -77,28 +149,36 @@ template <typename R>
 struct shared_state : shared_state_base<shared_state<R>> {
     void set_value(const R& value) noexcept
     {
+        std::vector<typename shared_state::continuation> conts;
         {
             std::unique_lock<mutex> lk(this->m_mtx);
             assert(!m_res.has_value());
             m_res.emplace(value);
+            conts = this->mark_ready();
         }
         this->m_cv.notify_all();
+        this->run_continuations(std::move(conts));
     }
 
     void set_value(R&& value) noexcept
     {
+        std::vector<typename shared_state::continuation> conts;
         {
             std::unique_lock<mutex> lk(this->m_mtx);
             assert(!m_res.has_value());
             m_res.emplace(std::move(value));
+            conts = this->mark_ready();
         }
         this->m_cv.notify_all();
+        this->run_continuations(std::move(conts));
     }
 
     R& get() noexcept
     {
-        std::unique_lock lk(this->m_mtx);
-        this->wait_(lk);
+        if (!this->ready()) {
+            std::unique_lock lk(this->m_mtx);
+            this->wait_(lk);
+        }
         assert(m_res.has_value());
         return m_res.value();
     }
@@ -116,18 +196,23 @@ template <>
 struct shared_state<void> : shared_state_base<shared_state<void>> {
     void set_value() noexcept
     {
+        std::vector<continuation> conts;
         {
             std::unique_lock<mutex> lk(this->m_mtx);
             assert(!m_hasValue);
             m_hasValue = true;
+            conts = mark_ready();
         }
         this->m_cv.notify_all();
+        run_continuations(std::move(conts));
     }
 
     void get() noexcept
     {
-        std::unique_lock lk(this->m_mtx);
-        this->wait_(lk);
+        if (!ready()) {
+            std::unique_lock lk(this->m_mtx);
+            this->wait_(lk);
+        }
         assert(m_hasValue);
     }
 
@@ -139,6 +224,25 @@ struct shared_state<void> : shared_state_base<shared_state<void>> {
 private:
     bool m_hasValue {false};
 };
+
+// the result of a continuation taking the value of a future<R>
+template <typename F, typename R>
+struct continuation_result {
+    using type = std::invoke_result_t<F, R>;
+};
+
+template <typename F>
+struct continuation_result<F, void> {
+    using type = std::invoke_result_t<F>;
+};
+
+struct future_access {
+    template <typename R>
+    static const std::shared_ptr<shared_state<R>>& state(const future<R>& fut) noexcept
+    {
+        return fut.m_state;
+    }
+};
 }; // namespace detail
 
 template <typename R>
@@ -149,6 +253,8 @@ class future : private non_copyable {
     template <typename>
     friend struct packaged_task;
 
+    friend struct detail::future_access;
+
 public:
     explicit future(const std::shared_ptr<detail::shared_state<R>>& state) noexcept : m_state(state)
     {
@@ -205,6 +311,34 @@ public:
         m_state->wait();
     }
 
+    /*
+     * Submits f as a task with the value once it is set, instead of a task waiting for it, and returns the
+     * future of its result. Like get, it consumes this future.
+     */
+    template <typename F>
+    future<typename detail::continuation_result<std::decay_t<F>, R>::type> then(F&& f)
+    {
+        assert(valid());
+        using U = typename detail::continuation_result<std::decay_t<F>, R>::type;
+        auto next = std::make_shared<detail::shared_state<U>>();
+        auto state = std::move(m_state);
+        auto src = state.get();
+        src->add_continuation([src, next, fn = std::forward<F>(f)]() mutable {
+            if constexpr (std::is_void_v<R> && std::is_void_v<U>) {
+                fn();
+                next->set_value();
+            } else if constexpr (std::is_void_v<R>) {
+                next->set_value(fn());
+            } else if constexpr (std::is_void_v<U>) {
+                fn(std::move(src->get()));
+                next->set_value();
+            } else {
+                next->set_value(fn(std::move(src->get())));
+            }
+        });
+        return future<U> {next};
+    }
+
     void swap(future<R>& rhs) noexcept
     {
         std::swap(m_state, rhs.m_state);
@@ -361,6 +495,90 @@ private:
     std::shared_ptr<detail::shared_state<R>> m_state;
 };
 
+// the futures are ready once the returned one is, their values are taken without waiting
+template <typename R>
+future<std::vector<future<R>>> when_all(std::vector<future<R>> futs)
+{
+    using Result = std::vector<future<R>>;
+    auto out = std::make_shared<detail::shared_state<Result>>();
+    if (futs.empty()) {
+        out->set_value(Result {});
+        return future<Result> {out};
+    }
+
+    // only the states that are ready are held, they hold no continuation anymore
+    struct context {
+        context(size_t n, const std::shared_ptr<detail::shared_state<Result>>& o) : ready(n), left(n), out(o)
+        {
+        }
+        std::vector<std::shared_ptr<detail::shared_state<R>>> ready;
+        std::atomic<size_t> left;
+        std::shared_ptr<detail::shared_state<Result>> out;
+    };
+    auto ctx = std::make_shared<context>(futs.size(), out);
+    for (size_t i = 0; i < futs.size(); i++) {
+        assert(futs[i].valid());
+        auto s = detail::future_access::state(futs[i]).get();
+        s->add_continuation([ctx, i, s] {
+            ctx->ready[i] = s->shared_from_this();
+            if (ctx->left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Result res;
+                for (auto& state : ctx->ready) {
+                    res.emplace_back(state);
+                }
+                ctx->out->set_value(std::move(res));
+            }
+        }, true);
+    }
+    return future<Result> {out};
+}
+
+template <typename Sequence>
+struct when_any_result {
+    size_t index;
+    Sequence futures;
+};
+
+// index is the first future found ready, SIZE_MAX for no futures
+template <typename R>
+future<when_any_result<std::vector<future<R>>>> when_any(std::vector<future<R>> futs)
+{
+    using Result = when_any_result<std::vector<future<R>>>;
+    auto out = std::make_shared<detail::shared_state<Result>>();
+    if (futs.empty()) {
+        out->set_value(Result {SIZE_MAX, {}});
+        return future<Result> {out};
+    }
+
+    // the states are held weakly, the future of one whose promise went away without a value is left invalid
+    struct context {
+        context(const std::shared_ptr<detail::shared_state<Result>>& o) : out(o)
+        {
+        }
+        std::vector<std::weak_ptr<detail::shared_state<R>>> states;
+        std::atomic<bool> done {false};
+        std::shared_ptr<detail::shared_state<Result>> out;
+    };
+    auto ctx = std::make_shared<context>(out);
+    for (auto& f : futs) {
+        assert(f.valid());
+        ctx->states.push_back(detail::future_access::state(f));
+    }
+    for (size_t i = 0; i < futs.size(); i++) {
+        detail::future_access::state(futs[i])->add_continuation([ctx, i] {
+            if (!ctx->done.exchange(true, std::memory_order_acq_rel)) {
+                Result res {i, {}};
+                for (auto& state : ctx->states) {
+                    auto s = state.lock();
+                    res.futures.emplace_back(s ? future<R> {s} : future<R> {});
+                }
+                ctx->out->set_value(std::move(res));
+            }
+        }, true);
+    }
+    return future<Result> {out};
+}
+
 template <typename F, typename... Args>
 future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> async(F&& f, Args&& ... args)
 {
@@ -24,6 +24,15 @@ public:
         ffrt_mutex_init(this, nullptr);
     }
 
+    explicit mutex(ffrt_mutex_type_t type)
+    {
+        ffrt_mutexattr_t attr;
+        ffrt_mutexattr_init(&attr);
+        ffrt_mutexattr_settype(&attr, type);
+        ffrt_mutex_init(this, &attr);
+        ffrt_mutexattr_destroy(&attr);
+    }
+
     ~mutex()
     {
         ffrt_mutex_destroy(this);
@@ -46,6 +55,13 @@ public:
     {
         ffrt_mutex_unlock(this);
     }
+
+    inline ffrt_mutex_stat_t stat()
+    {
+        ffrt_mutex_stat_t s {};
+        ffrt_mutex_get_stat(this, &s);
+        return s;
+    }
 };
 } // namespace ffrt
 #endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_API_CPP_PARALLEL_H
+#define FFRT_API_CPP_PARALLEL_H
+#include <mutex>
+#include <type_traits>
+#include "c/parallel.h"
+#include "cpp/task.h"
+#include "cpp/mutex.h"
+
+namespace ffrt {
+template<class F>
+void parallel_for_wrapper(void* arg, uint64_t begin, uint64_t end)
+{
+    auto& f = *static_cast<F*>(arg);
+    for (uint64_t i = begin; i < end; i++) {
+        f(i);
+    }
+}
+
+template<class T, class Map, class Reduce>
+struct parallel_reduce_ctx {
+    Map& map;
+    Reduce& reduce;
+    const T& identity;
+    T result;
+    ffrt::mutex lock;
+};
+
+template<class Ctx>
+void parallel_reduce_wrapper(void* arg, uint64_t begin, uint64_t end)
+{
+    auto& ctx = *static_cast<Ctx*>(arg);
+    auto acc = ctx.identity;
+    for (uint64_t i = begin; i < end; i++) {
+        acc = ctx.reduce(std::move(acc), ctx.map(i));
+    }
+    std::lock_guard lg(ctx.lock);
+    ctx.result = ctx.reduce(std::move(ctx.result), std::move(acc));
+}
+
+/**
+@brief run fn(i) for every i in [begin, end) on the workers and the calling task, returns when all are done
+*/
+template<class F>
+static inline void parallel_for(uint64_t begin, uint64_t end, uint64_t grain, F&& fn)
+{
+    void* arg = const_cast<void*>(static_cast<const void*>(&fn));
+    ffrt_parallel_for(begin, end, grain, parallel_for_wrapper<std::remove_reference_t<F>>, arg, nullptr);
+}
+
+template<class F>
+static inline void parallel_for(uint64_t begin, uint64_t end, uint64_t grain, F&& fn, const task_attr& attr)
+{
+    void* arg = const_cast<void*>(static_cast<const void*>(&fn));
+    ffrt_parallel_for(begin, end, grain, parallel_for_wrapper<std::remove_reference_t<F>>, arg, &attr);
+}
+
+template<class T, class Map, class Reduce>
+static inline T parallel_reduce_base(uint64_t begin, uint64_t end, uint64_t grain, const T& identity, Map&& map,
+    Reduce&& reduce, const ffrt_task_attr_t* attr)
+{
+    using ctx_type = parallel_reduce_ctx<T, std::remove_reference_t<Map>, std::remove_reference_t<Reduce>>;
+    ctx_type ctx {map, reduce, identity, identity, {}};
+    ffrt_parallel_for(begin, end, grain, parallel_reduce_wrapper<ctx_type>, &ctx, attr);
+    return std::move(ctx.result);
+}
+
+/**
+@brief fold reduce(acc, map(i)) over [begin, end), every chunk starts from identity and the chunk results are
+folded with reduce in no particular order, so reduce must be associative and commutative
+*/
+template<class T, class Map, class Reduce>
+static inline T parallel_reduce(uint64_t begin, uint64_t end, uint64_t grain, const T& identity, Map&& map,
+    Reduce&& reduce)
+{
+    return parallel_reduce_base(begin, end, grain, identity, map, reduce, nullptr);
+}
+
+template<class T, class Map, class Reduce>
+static inline T parallel_reduce(uint64_t begin, uint64_t end, uint64_t grain, const T& identity, Map&& map,
+    Reduce&& reduce, const task_attr& attr)
+{
+    return parallel_reduce_base(begin, end, grain, identity, map, reduce, &attr);
+}
+} // namespace ffrt
+#endif
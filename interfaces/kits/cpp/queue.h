@@ -19,6 +19,12 @@
 #include "cpp/task.h"
 
 namespace ffrt {
+enum queue_type {
+    queue_serial = ffrt_queue_serial,
+    queue_concurrent = ffrt_queue_concurrent,
+    queue_max = ffrt_queue_max,
+};
+
 class queue_attr : public ffrt_queue_attr_t {
 public:
     queue_attr()
@@ -72,6 +78,19 @@ public:
     {
         return ffrt_queue_attr_get_timeoutCb(this);
     }
+
+    // set max concurrency of a concurrent queue
+    inline queue_attr& max_concurrency(const int max_concurrency)
+    {
+        ffrt_queue_attr_set_max_concurrency(this, max_concurrency);
+        return *this;
+    }
+
+    // get max concurrency
+    inline int max_concurrency() const
+    {
+        return ffrt_queue_attr_get_max_concurrency(this);
+    }
 };
 
 class queue {
@@ -81,6 +100,11 @@ public:
         queue_handle = ffrt_queue_create(ffrt_queue_serial, name, &attr);
     }
 
+    queue(const queue_type type, const char* name, const queue_attr& attr = {})
+    {
+        queue_handle = ffrt_queue_create(static_cast<ffrt_queue_type_t>(type), name, &attr);
+    }
+
     ~queue()
     {
         ffrt_queue_destroy(queue_handle);
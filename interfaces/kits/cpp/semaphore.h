@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_API_CPP_SEMAPHORE_H
+#define FFRT_API_CPP_SEMAPHORE_H
+#include <cstddef>
+#include <cstdint>
+#include "c/semaphore.h"
+
+namespace ffrt {
+template <ptrdiff_t LeastMaxValue = INT32_MAX>
+class counting_semaphore : public ffrt_sem_t {
+public:
+    static constexpr ptrdiff_t max() noexcept
+    {
+        return LeastMaxValue;
+    }
+
+    explicit counting_semaphore(ptrdiff_t desired)
+    {
+        ffrt_sem_init(this, static_cast<uint32_t>(desired));
+    }
+
+    ~counting_semaphore()
+    {
+        ffrt_sem_destroy(this);
+    }
+
+    counting_semaphore(counting_semaphore const&) = delete;
+    void operator=(counting_semaphore const&) = delete;
+
+    inline void release(ptrdiff_t update = 1)
+    {
+        ffrt_sem_post(this, static_cast<uint32_t>(update));
+    }
+
+    inline void acquire()
+    {
+        ffrt_sem_wait(this);
+    }
+
+    inline bool try_acquire()
+    {
+        return ffrt_sem_trywait(this) == ffrt_success;
+    }
+};
+
+using binary_semaphore = counting_semaphore<1>;
+} // namespace ffrt
+#endif
@@ -86,6 +86,182 @@ public:
     {
         return ffrt_task_attr_get_delay(this);
     }
+
+    /**
+    @brief set coroutine stack size, rounded up to a power of two, 0 means the default size
+    */
+    inline task_attr& stack_size(uint64_t size)
+    {
+        ffrt_task_attr_set_stack_size(this, size);
+        return *this;
+    }
+
+    /**
+    @brief get coroutine stack size
+    */
+    inline uint64_t stack_size() const
+    {
+        return ffrt_task_attr_get_stack_size(this);
+    }
+
+    /**
+    @brief mark a task that never blocks, it runs on the worker stack without a coroutine. Blocking in it aborts,
+    in release builds its worker waits in the kernel instead and the cpu monitor starts another one meanwhile
+    */
+    inline task_attr& nonblocking(bool nonblocking)
+    {
+        ffrt_task_attr_set_nonblocking(this, nonblocking);
+        return *this;
+    }
+
+    /**
+    @brief get whether the task is marked non-blocking
+    */
+    inline bool nonblocking() const
+    {
+        return ffrt_task_attr_get_nonblocking(this);
+    }
+
+    /**
+    @brief set deadline in us after submission, tasks are picked earliest deadline first on an edf qos
+    */
+    inline task_attr& deadline(uint64_t deadline_us)
+    {
+        ffrt_task_attr_set_deadline(this, deadline_us);
+        return *this;
+    }
+
+    /**
+    @brief get deadline in us after submission
+    */
+    inline uint64_t deadline() const
+    {
+        return ffrt_task_attr_get_deadline(this);
+    }
+
+    /**
+    @brief set the order of the task within a concurrent queue
+    */
+    inline task_attr& priority(ffrt_queue_priority_t prio)
+    {
+        ffrt_task_attr_set_queue_priority(this, prio);
+        return *this;
+    }
+
+    /**
+    @brief get the order of the task within a concurrent queue
+    */
+    inline ffrt_queue_priority_t priority() const
+    {
+        return ffrt_task_attr_get_queue_priority(this);
+    }
+
+    /**
+    @brief set the cancel token of the task, by default it inherits the one of the task submitting it unless detached
+    */
+    inline task_attr& cancel_token(ffrt_cancel_token_t token)
+    {
+        ffrt_task_attr_set_cancel_token(this, token);
+        return *this;
+    }
+
+    /**
+    @brief get the cancel token of the task, borrowed from the attr and never to be destroyed
+    */
+    inline ffrt_cancel_token_t cancel_token() const
+    {
+        return ffrt_task_attr_get_cancel_token(this);
+    }
+
+    /**
+    @brief submit the task at root level, wait() in the submitting task does not wait for it and it does not
+    inherit the cancel token of the submitting task
+    */
+    inline task_attr& detached(bool detached)
+    {
+        ffrt_task_attr_set_detached(this, detached);
+        return *this;
+    }
+
+    /**
+    @brief get whether the task is submitted at root level
+    */
+    inline bool detached() const
+    {
+        return ffrt_task_attr_get_detached(this);
+    }
+};
+
+/**
+@brief cancels pending tasks submitted with it, their descendants and the tasks depending on their data,
+running ones poll this_task::is_cancelled()
+*/
+class cancel_token {
+public:
+    cancel_token() : p(ffrt_cancel_token_create(nullptr))
+    {
+    }
+
+    /**
+    @brief derive a token that is cancelled with its parent, it keeps the parent alive, so a borrowed
+    ffrt_this_task_get_cancel_token() may be kept beyond the task this way
+    */
+    explicit cancel_token(ffrt_cancel_token_t parent) : p(ffrt_cancel_token_create(parent))
+    {
+    }
+
+    ~cancel_token()
+    {
+        if (p) {
+            ffrt_cancel_token_destroy(p);
+        }
+    }
+
+    cancel_token(cancel_token const&) = delete;
+    void operator=(cancel_token const&) = delete;
+
+    inline cancel_token(cancel_token&& t) : p(t.p)
+    {
+        t.p = nullptr;
+    }
+
+    inline cancel_token& operator=(cancel_token&& t)
+    {
+        if (this != &t) {
+            if (p) {
+                ffrt_cancel_token_destroy(p);
+            }
+            p = t.p;
+            t.p = nullptr;
+        }
+        return *this;
+    }
+
+    /**
+    @brief derive a token that is cancelled with this one
+    */
+    inline cancel_token child() const
+    {
+        return cancel_token(p);
+    }
+
+    inline void cancel()
+    {
+        ffrt_cancel_token_cancel(p);
+    }
+
+    inline bool cancelled() const
+    {
+        return ffrt_cancel_token_is_cancelled(p);
+    }
+
+    inline operator ffrt_cancel_token_t() const
+    {
+        return p;
+    }
+
+private:
+    ffrt_cancel_token_t p = nullptr;
 };
 
 class task_handle {
@@ -268,6 +444,55 @@ static inline void submit(const std::function<void()>& func, const std::vector<c
     return ffrt_submit_base(create_function_wrapper(func), &in, &out, &attr);
 }
 
+static inline void submit_n_base(std::vector<std::function<void()>>&& funcs,
+    const std::vector<std::vector<const void*>>& in_deps, const std::vector<std::vector<const void*>>& out_deps,
+    const ffrt_task_attr_t* attr)
+{
+    std::vector<ffrt_function_header_t*> fs;
+    fs.reserve(funcs.size());
+    for (auto& func : funcs) {
+        fs.push_back(create_function_wrapper(std::move(func)));
+    }
+    std::vector<ffrt_deps_t> ins;
+    std::vector<ffrt_deps_t> outs;
+    for (auto& deps : in_deps) {
+        ins.push_back({static_cast<uint32_t>(deps.size()), deps.data()});
+    }
+    for (auto& deps : out_deps) {
+        outs.push_back({static_cast<uint32_t>(deps.size()), deps.data()});
+    }
+    // tasks without deps listed get none
+    if (!ins.empty()) {
+        ins.resize(fs.size(), {0, nullptr});
+    }
+    if (!outs.empty()) {
+        outs.resize(fs.size(), {0, nullptr});
+    }
+    ffrt_submit_batch(fs.data(), ins.empty() ? nullptr : ins.data(), outs.empty() ? nullptr : outs.data(),
+        static_cast<uint32_t>(fs.size()), attr);
+}
+
+/**
+@brief submit a batch of tasks at once, in_deps[i] and out_deps[i] are the dependency of funcs[i]
+*/
+static inline void submit_n(std::vector<std::function<void()>>&& funcs)
+{
+    return submit_n_base(std::move(funcs), {}, {}, nullptr);
+}
+
+static inline void submit_n(std::vector<std::function<void()>>&& funcs,
+    const std::vector<std::vector<const void*>>& in_deps, const std::vector<std::vector<const void*>>& out_deps)
+{
+    return submit_n_base(std::move(funcs), in_deps, out_deps, nullptr);
+}
+
+static inline void submit_n(std::vector<std::function<void()>>&& funcs,
+    const std::vector<std::vector<const void*>>& in_deps, const std::vector<std::vector<const void*>>& out_deps,
+    const task_attr& attr)
+{
+    return submit_n_base(std::move(funcs), in_deps, out_deps, &attr);
+}
+
 /**
 @brief submit and return task handle
 */
@@ -397,6 +622,16 @@ static inline void wait(const std::vector<const void*>& deps)
     ffrt_wait_deps(&d);
 }
 
+/**
+@brief wait until specified data be produced, its producers and the tasks they depend on inherit the deadline in us,
+it moves them up on an edf qos only and never changes their qos
+*/
+static inline void wait(const std::vector<const void*>& deps, uint64_t deadline_us)
+{
+    ffrt_deps_t d{static_cast<uint32_t>(deps.size()), deps.data()};
+    ffrt_wait_deps_with_deadline(&d, deadline_us);
+}
+
 /**
 @brief config
 */
@@ -421,6 +656,14 @@ static inline uint64_t get_id()
 {
     return ffrt_this_task_get_id();
 }
+
+/**
+@brief whether the token of the running task, or of a task it reads the data of, is cancelled
+*/
+static inline bool is_cancelled()
+{
+    return ffrt_this_task_is_cancelled();
+}
 } // namespace this_task
 } // namespace ffrt
 #endif
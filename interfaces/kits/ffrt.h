@@ -17,17 +17,26 @@
 #ifdef __cplusplus
 #include "cpp/task.h"
 #include "cpp/mutex.h"
+#include "cpp/shared_mutex.h"
+#include "cpp/semaphore.h"
+#include "cpp/barrier.h"
 #include "cpp/condition_variable.h"
 #include "cpp/sleep.h"
 #include "cpp/thread.h"
 #include "cpp/future.h"
+#include "cpp/channel.h"
 #include "cpp/queue.h"
+#include "cpp/parallel.h"
 #else
 #include "c/task.h"
 #include "c/mutex.h"
+#include "c/shared_mutex.h"
+#include "c/semaphore.h"
+#include "c/barrier.h"
 #include "c/condition_variable.h"
 #include "c/sleep.h"
 #include "c/thread.h"
 #include "c/queue.h"
+#include "c/parallel.h"
 #endif
 #endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/cancel_token.h"
+#include <algorithm>
+
+namespace ffrt {
+CancelToken::CancelToken(CancelToken* parent) : parent(parent)
+{
+    if (parent == nullptr) {
+        return;
+    }
+    parent->IncRef();
+    std::lock_guard<std::mutex> lk(parent->lock);
+    parent->children.push_back(this);
+    // the parent cancels its children under its lock, so this either sees the flag or is cancelled later
+    if (parent->Cancelled()) {
+        cancelled.store(true, std::memory_order_release);
+    }
+}
+
+CancelToken::~CancelToken()
+{
+    if (parent == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk(parent->lock);
+        auto it = std::find(parent->children.begin(), parent->children.end(), this);
+        if (it != parent->children.end()) {
+            parent->children.erase(it);
+        }
+    }
+    parent->DecRef();
+}
+
+void CancelToken::Cancel()
+{
+    // a dying child still waits for this lock to unlink, it is not freed while the loop runs
+    std::lock_guard<std::mutex> lk(lock);
+    if (cancelled.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (auto child : children) {
+        child->Cancel();
+    }
+}
+} // namespace ffrt
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FFRT_CANCEL_TOKEN_H
+#define FFRT_CANCEL_TOKEN_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace ffrt {
+/*
+ * Cancelling a token cancels the tokens derived from it, down the whole tree, so a task polls one flag of its
+ * own token instead of walking up to the root. A child keeps its parent alive until it unlinks itself.
+ */
+class CancelToken {
+public:
+    explicit CancelToken(CancelToken* parent);
+    ~CancelToken();
+
+    CancelToken(const CancelToken&) = delete;
+    CancelToken& operator=(const CancelToken&) = delete;
+
+    void IncRef()
+    {
+        refCnt.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DecRef()
+    {
+        if (refCnt.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    void Cancel();
+
+    bool Cancelled() const
+    {
+        return cancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<bool> cancelled {false};
+    std::atomic<uint32_t> refCnt {1};
+    CancelToken* parent;
+    std::mutex lock; // guards children
+    std::vector<CancelToken*> children;
+};
+} // namespace ffrt
+#endif
@@ -16,6 +16,7 @@
 #ifndef FFRT_DYNAMIC_GRAPH_H
 #define FFRT_DYNAMIC_GRAPH_H
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string>
 #include <mutex>
@@ -75,11 +76,12 @@ inline void insDeDup(std::vector<const void *> &insNoDup, std::vector<const void
 
 class DependenceManager {
 public:
-    DependenceManager() : criticalMutex_(Entity::Instance()->criticalMutex_)
+    DependenceManager()
     {
         // control construct sequences of singletons
         SimpleAllocator<TaskCtx>::instance();
         SimpleAllocator<VersionCtx>::instance();
+        Entity::Instance();
         FFRTScheduler::Instance();
         ExecuteUnit::Instance();
 
@@ -102,6 +104,22 @@ public:
         return &root;
     }
 
+    // nobody waits for the children of the detached root, they belong to the runtime rather than to a task
+    static inline TaskCtx* DetachedRoot()
+    {
+        task_attr_private task_attr;
+        static TaskCtx root {&task_attr, nullptr, 0, nullptr};
+        return &root;
+    }
+
+    static inline TaskCtx* SubmitParent(const ExecuteCtx* ctx, const task_attr_private* attr)
+    {
+        if (attr != nullptr && attr->detached_) {
+            return DetachedRoot();
+        }
+        return ctx->task ? ctx->task : DependenceManager::Root();
+    }
+
     template <int WITH_HANDLE>
     void onSubmit(ffrt_task_handle_t &handle, ffrt_function_header_t *f, const ffrt_deps_t *ins,
         const ffrt_deps_t *outs, const task_attr_private *attr)
@@ -112,7 +130,7 @@ public:
         auto en = Entity::Instance();
 
         // 2 Get current task's parent
-        auto parent = ctx->task ? ctx->task : DependenceManager::Root();
+        auto parent = SubmitParent(ctx, attr);
 
         std::vector<const void*> insNoDup;
         std::vector<const void*> outsNoDup;
@@ -130,37 +148,21 @@ public:
         }
 
         // 2.1 Create task ctx
-        TaskCtx* task = nullptr;
-        {
-            FFRT_TRACE_SCOPE(1, CreateTask);
-            task = reinterpret_cast<TaskCtx*>(static_cast<uintptr_t>(
-                static_cast<size_t>(reinterpret_cast<uintptr_t>(f)) - OFFSETOF(TaskCtx, func_storage)));
-            new (task)TaskCtx(attr, parent, ++parent->childNum, nullptr);
-        }
-        FFRT_LOGW("submit task[%lu], name[%s]", task->gid, task->label.c_str());
-#ifdef FFRT_BBOX_ENABLE
-        TaskSubmitCounterInc();
-#endif
+        TaskCtx* task = CreateTask(f, parent, attr);
         if (WITH_HANDLE != 0) {
             task->IncDeleteRef();
             handle = CVT_TASK_TO_HANDLE(task);
             outsNoDup.push_back(handle); // handle作为任务的输出signature
         }
-        QoS qos = (attr == nullptr ? QoS() : QoS(attr->qos_));
-        task->ChargeQoSSubmit(qos);
-        task->InitRelatedIntervals(parent);
-        /* The parent's number of subtasks to be completed increases by one,
-         * and decreases by one after the subtask is completed
-         */
-        task->IncChildRef();
 
         std::vector<std::pair<VersionCtx*, NestType>> inDatas;
         std::vector<std::pair<VersionCtx*, NestType>> outDatas;
 
         if (!(insNoDup.empty() && outsNoDup.empty())) {
-            // 3 Put the submitted task into Entity
+            // 3 Put the submitted task into Entity, only the shards of its signatures are locked
+            EntityShardMask mask = SignatureShards(insNoDup) | SignatureShards(outsNoDup);
             FFRT_TRACE_SCOPE(1, submitBeforeLock);
-            std::lock_guard<decltype(criticalMutex_)> lg(criticalMutex_);
+            EntityShardLock lg(en, mask);
             FFRT_TRACE_SCOPE(1, submitAfterLock);
 
             MapSignature2Deps(task, insNoDup, outsNoDup, inDatas, outDatas);
@@ -187,24 +189,122 @@ public:
             }
         }
 
-        FFRT_LOGI("Submit completed, enter ready queue, task[%lu], name[%s]", task->gid, task->label.c_str());
+        FFRT_LOGI("Submit completed, enter ready queue, task[%lu], name[%s]", task->gid, task->GetLabel().c_str());
         task->UpdateState(TaskState::READY);
 #ifdef FFRT_BBOX_ENABLE
         TaskEnQueuCounterInc();
 #endif
     }
 
+    /*
+     * Submit num tasks sharing one attr, ins/outs are arrays of num deps or nullptr.
+     * Dependencies of the whole batch are resolved under one lock of the union of their shards,
+     * ready tasks are enqueued together after the lock is released and one wakeup is issued per qos.
+     */
+    void onSubmitBatch(ffrt_function_header_t** fs, const ffrt_deps_t* ins, const ffrt_deps_t* outs, uint32_t num,
+        const task_attr_private* attr)
+    {
+        FFRT_TRACE_SCOPE(1, onSubmitBatch);
+        auto ctx = ExecuteCtx::Cur();
+        auto en = Entity::Instance();
+        auto parent = SubmitParent(ctx, attr);
+
+        EntityShardMask mask = 0;
+        for (uint32_t i = 0; i < num; i++) {
+            for (uint32_t j = 0; ins != nullptr && j < ins[i].len; j++) {
+                mask |= Entity::ShardBit(ins[i].items[j]);
+            }
+            for (uint32_t j = 0; outs != nullptr && j < outs[i].len; j++) {
+                mask |= Entity::ShardBit(outs[i].items[j]);
+            }
+        }
+
+        std::vector<TaskCtx*> readyTasks;
+        readyTasks.reserve(num);
+        {
+            // the dedup and version buffers are reused by every task of the batch
+            std::vector<const void*> insNoDup;
+            std::vector<const void*> outsNoDup;
+            std::vector<std::pair<VersionCtx*, NestType>> inDatas;
+            std::vector<std::pair<VersionCtx*, NestType>> outDatas;
+            EntityShardLock lg(en, mask);
+            for (uint32_t i = 0; i < num; i++) {
+                if (fs[i] == nullptr) {
+                    FFRT_LOGE("function handler of task %u should not be empty", i);
+                    continue;
+                }
+                insNoDup.clear();
+                outsNoDup.clear();
+                if (outs != nullptr && !outsDeDup(outsNoDup, &outs[i])) {
+                    FFRT_LOGE("onSubmitBatch outsDeDup error");
+                    continue;
+                }
+                if (ins != nullptr) {
+                    insDeDup(insNoDup, outsNoDup, &ins[i]);
+                }
+
+                TaskCtx* task = CreateTask(fs[i], parent, attr);
+                if (!(insNoDup.empty() && outsNoDup.empty())) {
+                    inDatas.clear();
+                    outDatas.clear();
+                    MapSignature2Deps(task, insNoDup, outsNoDup, inDatas, outDatas);
+                    for (auto& in : std::as_const(inDatas)) {
+                        in.first->AddConsumer(task, in.second);
+                    }
+                    for (auto& out : std::as_const(outDatas)) {
+                        out.first->AddProducer(task);
+                    }
+                    if (task->depRefCnt != 0) {
+                        FFRT_BLOCK_TRACER(task->gid, dep);
+                        continue;
+                    }
+                }
+                readyTasks.push_back(task);
+            }
+        }
+
+        FFRT_LOGI("Submit batch completed, %zu of %u tasks enter ready queue", readyTasks.size(), num);
+        TaskState::OnBatchTransition(TaskState::READY, readyTasks);
+#ifdef FFRT_BBOX_ENABLE
+        for (size_t i = 0; i < readyTasks.size(); i++) {
+            TaskEnQueuCounterInc();
+        }
+#endif
+    }
+
+    /*
+     * Submit num fork-join helpers of the calling task. They carry no deps, so they are created and enqueued
+     * without dedup buffers or any entity shard lock, with one wakeup per qos.
+     */
+    void onSubmitHelpers(ffrt_function_header_t** fs, uint32_t num, const task_attr_private* attr)
+    {
+        FFRT_TRACE_SCOPE(1, onSubmitHelpers);
+        auto ctx = ExecuteCtx::Cur();
+        auto parent = ctx->task ? ctx->task : DependenceManager::Root();
+        std::vector<TaskCtx*> tasks;
+        tasks.reserve(num);
+        for (uint32_t i = 0; i < num; i++) {
+            tasks.push_back(CreateTask(fs[i], parent, attr));
+        }
+        TaskState::OnBatchTransition(TaskState::READY, tasks);
+#ifdef FFRT_BBOX_ENABLE
+        for (uint32_t i = 0; i < num; i++) {
+            TaskEnQueuCounterInc();
+        }
+#endif
+    }
+
     void onWait()
     {
         auto ctx = ExecuteCtx::Cur();
         auto task = ctx->task ? ctx->task : DependenceManager::Root();
 #ifdef EU_COROUTINE
-        if (task->parent == nullptr)
+        if (task->parent == nullptr || ThreadWaitMode(task))
 #endif
         {
             std::unique_lock<std::mutex> lck(task->lock);
             task->MultiDepenceAdd(Denpence::CALL_DEPENCE);
-            FFRT_LOGI("onWait name:%s gid=%lu", task->label.c_str(), task->gid);
+            FFRT_LOGI("onWait name:%s gid=%lu", task->GetLabel().c_str(), task->gid);
             task->childWaitCond_.wait(lck, [task] { return task->childWaitRefCnt == 0; });
             return;
         }
@@ -223,11 +323,12 @@ public:
 #endif
     }
 
-#ifdef QOS_DEPENDENCY
-    void onWait(const ffrt_deps_t* deps, int64_t deadline = -1)
-#else
-    void onWait(const ffrt_deps_t* deps)
-#endif
+    /*
+     * Wait until deps are produced. An absolute deadline, or the one of the waiting task, is lent to the producers
+     * of deps and transitively to the tasks they depend on. The walk holds the shards of deps only and starts over
+     * with the shards of the versions it reached outside of them.
+     */
+    void onWait(const ffrt_deps_t* deps, int64_t deadline = INT64_MAX)
     {
         auto ctx = ExecuteCtx::Cur();
         auto task = ctx->task ? ctx->task : DependenceManager::Root();
@@ -235,47 +336,61 @@ public:
         auto dataDepFun = [&]() {
             std::vector<VersionCtx*> waitDatas;
             waitDatas.reserve(deps->len);
-            std::lock_guard<decltype(criticalMutex_)> lg(criticalMutex_);
-
+            auto en = Entity::Instance();
+            int64_t ddl = std::min(deadline, task->EffectiveDeadline());
+            EntityShardMask mask = 0;
             for (uint32_t i = 0; i < deps->len; ++i) {
-                auto d = deps->items[i];
-                auto it = std::as_const(Entity::Instance()->vaMap).find(d);
-                if (it != Entity::Instance()->vaMap.end()) {
-                    auto waitData = it->second;
-                    // Find the VersionCtx of the parent task level
-                    for (auto out : std::as_const(task->outs)) {
-                        if (waitData->signature == out->signature) {
-                            waitData = out;
-                            break;
+                mask |= Entity::ShardBit(deps->items[i]);
+            }
+            for (;;) {
+                EntityShardLock lg(en, mask);
+
+                waitDatas.clear();
+                for (uint32_t i = 0; i < deps->len; ++i) {
+                    auto d = deps->items[i];
+                    auto& vaMap = en->GetShard(d).vaMap;
+                    auto it = std::as_const(vaMap).find(d);
+                    if (it != vaMap.end()) {
+                        auto waitData = it->second;
+                        // Find the VersionCtx of the parent task level
+                        std::lock_guard<decltype(task->lock)> lck(task->lock);
+                        for (auto out : std::as_const(task->outs)) {
+                            if (waitData->signature == out->signature) {
+                                waitData = out;
+                                break;
+                            }
                         }
+                        waitDatas.push_back(waitData);
                     }
-                    waitDatas.push_back(waitData);
                 }
-            }
-#ifdef QOS_DEPENDENCY
-            if (deadline != -1) {
-                Scheduler::Instance()->onWait(waitDatas, deadline);
-            }
-#endif
-            for (auto data : std::as_const(waitDatas)) {
-                data->AddDataWaitTaskByThis(task);
+                if (ddl != INT64_MAX) {
+                    EntityShardMask missing = BoostProducers(waitDatas, ddl, mask);
+                    if (missing != 0) {
+                        mask |= missing;
+                        continue;
+                    }
+                }
+                for (auto data : std::as_const(waitDatas)) {
+                    data->AddDataWaitTaskByThis(task);
+                }
+                return;
             }
         };
 #ifdef EU_COROUTINE
-        if (task->parent == nullptr)
+        if (task->parent == nullptr || ThreadWaitMode(task))
 #endif
         {
             dataDepFun();
             std::unique_lock<std::mutex> lck(task->lock);
             task->MultiDepenceAdd(Denpence::DATA_DEPENCE);
-            FFRT_LOGI("onWait name:%s gid=%lu", task->label.c_str(), task->gid);
+            FFRT_LOGI("onWait name:%s gid=%lu", task->GetLabel().c_str(), task->gid);
             task->dataWaitCond_.wait(lck, [task] { return task->dataWaitRefCnt == 0; });
             return;
         }
 #ifdef EU_COROUTINE
         auto pendDataDepFun = [&](ffrt::TaskCtx* inTask) -> bool {
             dataDepFun();
-            FFRT_LOGI("onWait name:%s gid=%lu", inTask->label.c_str(), inTask->gid);
+            FFRT_LOGI("onWait name:%s gid=%lu", inTask->GetLabel().c_str(), inTask->gid);
             std::unique_lock<std::mutex> lck(inTask->lock);
             if (inTask->dataWaitRefCnt == 0) {
                 return false;
@@ -289,20 +404,107 @@ public:
 #endif
     }
 
+    /*
+     * Only the shards in mask are held. A task reached through a version of a held shard has not finished, so its
+     * versions stay valid and their signatures can be read, the rest of them is only read in held shards.
+     * Returns the shards the walk needs beyond mask, nothing is boosted then and the caller retries with them.
+     */
+    EntityShardMask BoostProducers(const std::vector<VersionCtx*>& waitDatas, int64_t ddl, EntityShardMask mask)
+    {
+        std::vector<TaskCtx*> pending;
+        for (auto data : waitDatas) {
+            auto v = data->last;
+            if (v != nullptr && v->status == DataStatus::IDLE) {
+                pending.push_back(v->myProducer);
+            }
+        }
+
+        std::unordered_set<TaskCtx*> walked;
+        EntityShardMask missing = 0;
+        while (!pending.empty()) {
+            TaskCtx* t = pending.back();
+            pending.pop_back();
+            // a task already holding an earlier deadline has lent it to its producers before
+            if (t == nullptr || ddl >= t->boostDdl.load(std::memory_order_relaxed) || !walked.insert(t).second) {
+                continue;
+            }
+            std::lock_guard<decltype(t->lock)> lck(t->lock);
+            EntityShardMask shards = 0;
+            for (auto in : std::as_const(t->ins)) {
+                shards |= Entity::ShardBit(in->signature);
+            }
+            for (auto out : std::as_const(t->outs)) {
+                shards |= Entity::ShardBit(out->signature);
+            }
+            if ((shards & ~mask) != 0) {
+                missing |= shards & ~mask;
+                continue;
+            }
+            // producers of its inputs
+            for (auto in : std::as_const(t->ins)) {
+                if (in->status == DataStatus::IDLE) {
+                    pending.push_back(in->myProducer);
+                }
+            }
+            // the previous version of its outputs is either still produced or still consumed
+            for (auto out : std::as_const(t->outs)) {
+                auto prev = out->last;
+                if (prev == nullptr) {
+                    continue;
+                }
+                if (prev->status == DataStatus::IDLE) {
+                    pending.push_back(prev->myProducer);
+                } else if (prev->status == DataStatus::READY) {
+                    for (auto consumer : std::as_const(prev->consumers)) {
+                        if (consumer != t) {
+                            pending.push_back(consumer);
+                        }
+                    }
+                }
+            }
+        }
+        if (missing != 0) {
+            return missing;
+        }
+
+        auto sched = FFRTScheduler::Instance();
+        for (auto t : walked) {
+            sched->BoostTask(t, ddl);
+        }
+        return 0;
+    }
+
     void onTaskDone(TaskCtx* task)
     {
-        FFRT_LOGW("Task completed, task[%lu], name[%s]", task->gid, task->label.c_str());
+        FFRT_LOGW("Task completed, task[%lu], name[%s]", task->gid, task->GetLabel().c_str());
 #ifdef FFRT_BBOX_ENABLE
         TaskDoneCounterInc();
 #endif
         FFRT_TRACE_SCOPE(1, ontaskDone);
         task->DecChildRef();
+        // what a task ending cancelled wrote is not valid, the tasks reading it are skipped as well
+        bool cancelled = task->Cancelled();
+        task->ReleaseCancelToken();
         if (!(task->ins.empty() && task->outs.empty())) {
-            std::lock_guard<decltype(criticalMutex_)> lg(criticalMutex_);
+            // a concurrent merge swaps versions of the same signature only, so the mask stays valid
+            EntityShardMask mask = 0;
+            {
+                std::lock_guard<decltype(task->lock)> lck(task->lock);
+                for (auto in : std::as_const(task->ins)) {
+                    mask |= Entity::ShardBit(in->signature);
+                }
+                for (auto out : std::as_const(task->outs)) {
+                    mask |= Entity::ShardBit(out->signature);
+                }
+            }
+            EntityShardLock lg(Entity::Instance(), mask);
             FFRT_TRACE_SCOPE(1, taskDoneAfterLock);
 
             // Production data
             for (auto out : std::as_const(task->outs)) {
+                if (cancelled) {
+                    out->Cancel();
+                }
                 out->onProduced();
             }
             // Consumption data
@@ -315,74 +517,92 @@ public:
             }
 
             // VersionCtx recycling
-            Entity::Instance()->RecycleVersion();
+            Entity::Instance()->RecycleVersion(mask);
         }
 
         task->RecycleTask();
     }
 
+    TaskCtx* CreateTask(ffrt_function_header_t* f, TaskCtx* parent, const task_attr_private* attr)
+    {
+        TaskCtx* task = nullptr;
+        {
+            FFRT_TRACE_SCOPE(1, CreateTask);
+            task = reinterpret_cast<TaskCtx*>(static_cast<uintptr_t>(
+                static_cast<size_t>(reinterpret_cast<uintptr_t>(f)) - OFFSETOF(TaskCtx, func_storage)));
+            new (task)TaskCtx(attr, parent, ++parent->childNum, nullptr);
+        }
+        FFRT_LOGW("submit task[%lu], name[%s]", task->gid, task->GetLabel().c_str());
+#ifdef FFRT_BBOX_ENABLE
+        TaskSubmitCounterInc();
+#endif
+        QoS qos = (attr == nullptr ? QoS() : QoS(attr->qos_));
+        task->ChargeQoSSubmit(qos);
+        task->InitRelatedIntervals(parent);
+        /* The parent's number of subtasks to be completed increases by one,
+         * and decreases by one after the subtask is completed
+         */
+        task->IncChildRef();
+        return task;
+    }
+
+    static inline EntityShardMask SignatureShards(const std::vector<const void*>& deps)
+    {
+        EntityShardMask mask = 0;
+        for (auto signature : deps) {
+            mask |= Entity::ShardBit(signature);
+        }
+        return mask;
+    }
+
     void MapSignature2Deps(TaskCtx* task, const std::vector<const void*>& inDeps,
         const std::vector<const void*>& outDeps, std::vector<std::pair<VersionCtx*, NestType>>& inVersions,
         std::vector<std::pair<VersionCtx*, NestType>>& outVersions)
     {
         auto en = Entity::Instance();
+        // parent's ins/outs may be merged concurrently by its own parent under other shards
+        std::lock_guard<decltype(task->parent->lock)> lck(task->parent->lock);
         // scene description：
+        auto& parentOuts = task->parent->outs;
+        auto& parentIns = task->parent->ins;
         for (auto signature : inDeps) {
             VersionCtx* version = nullptr;
             NestType type = NestType::DEFAULT;
-            // scene 1|2
-            for (auto parentOut : std::as_const(task->parent->outs)) {
-                if (parentOut->signature == signature) {
-                    version = parentOut;
-                    type = NestType::PARENTOUT;
-                    goto add_inversion;
-                }
+            if (auto parentOut = parentOuts.find_key(signature); parentOut != parentOuts.end()) {
+                // scene 1|2
+                version = *parentOut;
+                type = NestType::PARENTOUT;
+            } else if (auto parentIn = parentIns.find_key(signature); parentIn != parentIns.end()) {
+                // scene 3
+                version = *parentIn;
+                type = NestType::PARENTIN;
+            } else {
+                // scene 4
+                version = en->VA2Ctx(signature, task);
             }
-            // scene 3
-            for (auto parentIn : std::as_const(task->parent->ins)) {
-                if (parentIn->signature == signature) {
-                    version = parentIn;
-                    type = NestType::PARENTIN;
-                    goto add_inversion;
-                }
-            }
-            // scene 4
-            version = en->VA2Ctx(signature, task);
-        add_inversion:
             inVersions.push_back({version, type});
         }
 
         for (auto signature : outDeps) {
             VersionCtx* version = nullptr;
             NestType type = NestType::DEFAULT;
-            // scene 5|6
-            for (auto parentOut : std::as_const(task->parent->outs)) {
-                if (parentOut->signature == signature) {
-                    version = parentOut;
-                    type = NestType::PARENTOUT;
-                    goto add_outversion;
-                }
-            }
-            // scene 7
+            if (auto parentOut = parentOuts.find_key(signature); parentOut != parentOuts.end()) {
+                // scene 5|6
+                version = *parentOut;
+                type = NestType::PARENTOUT;
+            } else {
+                // scene 7
 #ifndef FFRT_RELEASE
-            for (auto parentIn : std::as_const(task->parent->ins)) {
-                if (parentIn->signature == signature) {
+                if (parentIns.find_key(signature) != parentIns.end()) {
                     FFRT_LOGE("parent's indep only cannot be child's outdep");
                 }
-            }
 #endif
-            // scene 8
-            version = en->VA2Ctx(signature, task);
-        add_outversion:
+                // scene 8
+                version = en->VA2Ctx(signature, task);
+            }
             outVersions.push_back({version, type});
         }
     }
-
-#ifdef MUTEX_PERF // Mutex Lock&Unlock Cycles Statistic
-    xx::mutex& criticalMutex_;
-#else
-    fast_mutex& criticalMutex_;
-#endif
 };
 } // namespace ffrt
 #endif
@@ -19,8 +19,27 @@
 #include "util/slab.h"
 
 namespace ffrt {
+void Entity::LockShards(EntityShardMask mask)
+{
+    while (mask != 0) {
+        uint32_t i = static_cast<uint32_t>(__builtin_ctzll(mask));
+        shards[i].criticalMutex_.lock();
+        mask &= mask - 1;
+    }
+}
+
+void Entity::UnlockShards(EntityShardMask mask)
+{
+    while (mask != 0) {
+        uint32_t i = static_cast<uint32_t>(__builtin_ctzll(mask));
+        shards[i].criticalMutex_.unlock();
+        mask &= mask - 1;
+    }
+}
+
 VersionCtx* Entity::VA2Ctx(const void* p, TaskCtx* task __attribute__((unused)))
 {
+    auto& vaMap = GetShard(p).vaMap;
     auto it = std::as_const(vaMap).find(p);
     if (it != vaMap.end()) {
         return it->second;
@@ -30,26 +49,29 @@ VersionCtx* Entity::VA2Ctx(const void* p, TaskCtx* task __attribute__((unused)))
     return version;
 }
 
-void Entity::RecycleVersion()
+void Entity::RecycleVersion(EntityShardMask mask)
 {
-    for (auto it = Entity::Instance()->versionTrashcan.cbegin(); it != Entity::Instance()->versionTrashcan.cend();) {
-        VersionCtx* cur = *it;
-        VersionCtx* next = cur->next;
-        // VersionCtx list delete
-        next->last = cur->last;
-        if (cur->last != nullptr) {
-            cur->last->next = next;
-        }
-        SimpleAllocator<VersionCtx>::freeMem(cur);
-        if (next->next == nullptr) {
-            // Delete root version
-            auto data = std::as_const(Entity::Instance()->vaMap).find(next->signature);
-            if (data != Entity::Instance()->vaMap.end()) {
-                Entity::Instance()->vaMap.erase(data);
+    for (; mask != 0; mask &= mask - 1) {
+        auto& shard = shards[static_cast<uint32_t>(__builtin_ctzll(mask))];
+        for (auto it = shard.versionTrashcan.cbegin(); it != shard.versionTrashcan.cend();) {
+            VersionCtx* cur = *it;
+            VersionCtx* next = cur->next;
+            // VersionCtx list delete
+            next->last = cur->last;
+            if (cur->last != nullptr) {
+                cur->last->next = next;
+            }
+            SimpleAllocator<VersionCtx>::freeMem(cur);
+            if (next->next == nullptr) {
+                // Delete root version
+                auto data = std::as_const(shard.vaMap).find(next->signature);
+                if (data != shard.vaMap.end()) {
+                    shard.vaMap.erase(data);
+                }
+                SimpleAllocator<VersionCtx>::freeMem(next);
             }
-            SimpleAllocator<VersionCtx>::freeMem(next);
+            shard.versionTrashcan.erase(it++);
         }
-        Entity::Instance()->versionTrashcan.erase(it++);
     }
 }
 } /* namespace ffrt */
\ No newline at end of file
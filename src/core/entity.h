@@ -18,6 +18,7 @@
 
 #include <unordered_map>
 #include <list>
+#include <array>
 
 #include "sync/sync.h"
 
@@ -28,16 +29,13 @@
 namespace ffrt {
 struct VersionCtx;
 
-struct Entity {
-    static inline Entity* Instance()
-    {
-        static Entity ins;
-        return &ins;
-    }
-
-    VersionCtx* VA2Ctx(const void* p, TaskCtx* task);
-    void RecycleVersion();
+constexpr uint32_t ENTITY_SHARD_BITS = 6;
+constexpr uint32_t ENTITY_SHARD_NUM = 1U << ENTITY_SHARD_BITS;
+using EntityShardMask = uint64_t; // one bit per shard
+static_assert(ENTITY_SHARD_NUM <= sizeof(EntityShardMask) * 8, "shard mask too narrow");
 
+// signatures hashed to the same shard share one vaMap/trashcan and the lock protecting them
+struct alignas(64) EntityShard {
     std::list<VersionCtx*> versionTrashcan; // VersionCtx to be deleted
     std::unordered_map<const void*, VersionCtx*> vaMap;
 #ifdef MUTEX_PERF // Mutex Lock&Unlock Cycles Statistic
@@ -49,5 +47,60 @@ struct Entity {
     fast_mutex criticalMutex_;
 #endif
 };
+
+struct Entity {
+    static inline Entity* Instance()
+    {
+        static Entity ins;
+        return &ins;
+    }
+
+    static inline uint32_t ShardIndex(const void* p)
+    {
+        // fibonacci hashing, signatures are mostly neighbouring addresses
+        constexpr uint64_t goldenRatio = 0x9E3779B97F4A7C15ULL;
+        return static_cast<uint32_t>(((reinterpret_cast<uintptr_t>(p) >> 3) * goldenRatio) >>
+            (64 - ENTITY_SHARD_BITS));
+    }
+
+    static inline EntityShardMask ShardBit(const void* p)
+    {
+        return static_cast<EntityShardMask>(1) << ShardIndex(p);
+    }
+
+    inline EntityShard& GetShard(const void* p)
+    {
+        return shards[ShardIndex(p)];
+    }
+
+    // the shards of mask are locked in ascending index order, which is the canonical order to avoid deadlock
+    void LockShards(EntityShardMask mask);
+    void UnlockShards(EntityShardMask mask);
+
+    VersionCtx* VA2Ctx(const void* p, TaskCtx* task);
+    void RecycleVersion(EntityShardMask mask);
+
+    std::array<EntityShard, ENTITY_SHARD_NUM> shards;
+};
+
+class EntityShardLock {
+public:
+    EntityShardLock(Entity* en, EntityShardMask mask) : en(en), mask(mask)
+    {
+        en->LockShards(mask);
+    }
+
+    ~EntityShardLock()
+    {
+        en->UnlockShards(mask);
+    }
+
+    EntityShardLock(const EntityShardLock&) = delete;
+    EntityShardLock& operator=(const EntityShardLock&) = delete;
+
+private:
+    Entity* en;
+    EntityShardMask mask;
+};
 } // namespace ffrt
 #endif
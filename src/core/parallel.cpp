@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "ffrt.h"
+#include "cpp/task.h"
+#include "core/task_attr_private.h"
+#include "core/task_ctx.h"
+#include "core/dependence_manager.h"
+#include "sched/execute_ctx.h"
+#include "sched/qos.h"
+#include "internal_inc/config.h"
+#include "internal_inc/osal.h"
+#include "dfx/log/ffrt_log_api.h"
+
+namespace ffrt {
+namespace {
+constexpr int64_t PARALLEL_CHUNK_NS = 50000; // target run time of a chunk
+constexpr uint64_t PARALLEL_CHUNKS_PER_WORKER = 4; // chunks never grow beyond this share of the range
+
+/*
+ * A range shared by the caller and the helper tasks, every participant claims the next chunk with fetch_add.
+ * The caller only waits for participants which are inside the claim loop, a helper started after the range
+ * is exhausted leaves at once, so the range is held by shared_ptr.
+ */
+class ParallelRange {
+public:
+    ParallelRange(uint64_t begin, uint64_t end, uint64_t minGrain, uint64_t maxGrain, ffrt_parallel_func_t func,
+        void* arg)
+        : next(begin), end(end), minGrain(minGrain), maxGrain(maxGrain), grain(minGrain), func(func), arg(arg)
+    {
+    }
+
+    void Run()
+    {
+        active.fetch_add(1);
+        uint64_t g = grain.load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t b = next.fetch_add(g);
+            if (b >= end) {
+                break;
+            }
+            uint64_t e = (end - b > g) ? b + g : end;
+
+            auto start = std::chrono::steady_clock::now();
+            func(arg, b, e);
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            // grow short chunks to amortize the claim, split long ones to balance the tail
+            if (ns.count() < PARALLEL_CHUNK_NS / 2 && g < maxGrain) {
+                g = std::min(g * 2, maxGrain);
+                grain.store(g, std::memory_order_relaxed);
+            } else if (ns.count() > PARALLEL_CHUNK_NS * 2 && g > minGrain) {
+                g = std::max(g / 2, minGrain);
+                grain.store(g, std::memory_order_relaxed);
+            }
+        }
+        if (active.fetch_sub(1) == 1) {
+            std::lock_guard lg(lock);
+            cond.notify_all();
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock lk(lock);
+        cond.wait(lk, [this] { return active.load() == 0; });
+    }
+
+private:
+    std::atomic<uint64_t> next;
+    const uint64_t end;
+    const uint64_t minGrain;
+    const uint64_t maxGrain;
+    std::atomic<uint64_t> grain;
+    ffrt_parallel_func_t func;
+    void* arg;
+
+    std::atomic<int> active {0};
+    ffrt::mutex lock;
+    ffrt::condition_variable cond;
+};
+
+QoS ParallelQoS(const task_attr_private* attr)
+{
+    QoS qos = attr == nullptr ? QoS() : QoS(attr->qos_);
+    if (qos == qos_inherit) {
+        auto task = ExecuteCtx::Cur()->task;
+        qos = task == nullptr ? QoS() : task->qos;
+    }
+    return qos;
+}
+} // namespace
+} // namespace ffrt
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+API_ATTRIBUTE((visibility("default")))
+void ffrt_parallel_for(uint64_t begin, uint64_t end, uint64_t grain, ffrt_parallel_func_t func, void* arg,
+    const ffrt_task_attr_t* attr)
+{
+    if (!func) {
+        FFRT_LOGE("func should not be empty");
+        return;
+    }
+    if (begin >= end) {
+        return;
+    }
+
+    auto p = reinterpret_cast<const ffrt::task_attr_private*>(attr);
+    uint64_t total = end - begin;
+    uint64_t minGrain = grain == 0 ? 1 : grain;
+    uint64_t chunks = total / minGrain + (total % minGrain != 0 ? 1 : 0);
+    uint64_t workers = ffrt::GlobalConfig::Instance().getCpuWorkerNum(ffrt::ParallelQoS(p)());
+    uint64_t helperNum = std::min(workers, chunks);
+    helperNum = helperNum > 0 ? helperNum - 1 : 0; // the caller is a participant as well
+    if (helperNum == 0) {
+        func(arg, begin, end);
+        return;
+    }
+
+    uint64_t maxGrain = std::max(minGrain, total / ((helperNum + 1) * ffrt::PARALLEL_CHUNKS_PER_WORKER));
+    auto range = std::make_shared<ffrt::ParallelRange>(begin, end, minGrain, maxGrain, func, arg);
+
+    // helpers carry no deps, they bypass the dependence graph and the entity altogether
+    ffrt::task_attr_private helperAttr = p == nullptr ? ffrt::task_attr_private() : *p;
+    helperAttr.name_ = "parallel_for";
+    helperAttr.delay_ = 0;
+    std::vector<ffrt_function_header_t*> fs(helperNum);
+    for (auto& f : fs) {
+        f = ffrt::create_function_wrapper(std::function<void()>([range] { range->Run(); }));
+    }
+    ffrt::DependenceManager::Instance()->onSubmitHelpers(fs.data(), static_cast<uint32_t>(helperNum), &helperAttr);
+
+    range->Run();
+    range->Wait();
+}
+#ifdef __cplusplus
+}
+#endif
@@ -25,10 +25,11 @@
 #include "sched/qos.h"
 #include "dependence_manager.h"
 #include "task_attr_private.h"
+#include "core/cancel_token.h"
 #include "internal_inc/config.h"
 #include "eu/osattr_manager.h"
 #include "dfx/log/ffrt_log_api.h"
-#include "queue/serial_task.h"
+#include "queue/queue_task.h"
 
 namespace ffrt {
 template <int WITH_HANDLE>
@@ -77,7 +78,11 @@ void create_delay_deps(
         FFRT_LOGI("submit task delay time [%d us] has ended.", delayUs);
     };
     ffrt_function_header_t *delay_func = create_function_wrapper(std::move(func));
-    submit_impl<1>(handle, delay_func, nullptr, nullptr, reinterpret_cast<task_attr_private *>(p));
+    // the delay task sleeps, it needs a coroutine whatever the delayed task asks for
+    task_attr_private delayAttr = *p;
+    delayAttr.nonblocking_ = false;
+    delayAttr.deadline_ = 0;
+    submit_impl<1>(handle, delay_func, nullptr, nullptr, &delayAttr);
 }
 } // namespace ffrt
 
@@ -173,7 +178,137 @@ uint64_t ffrt_task_attr_get_delay(const ffrt_task_attr_t *attr)
     return (reinterpret_cast<ffrt::task_attr_private *>(p))->delay_;
 }
 
+API_ATTRIBUTE((visibility("default")))
+void ffrt_task_attr_set_stack_size(ffrt_task_attr_t *attr, uint64_t size)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return;
+    }
+    (reinterpret_cast<ffrt::task_attr_private *>(attr))->stackSize_ = size;
+}
+
+API_ATTRIBUTE((visibility("default")))
+uint64_t ffrt_task_attr_get_stack_size(const ffrt_task_attr_t *attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return 0;
+    }
+    ffrt_task_attr_t *p = const_cast<ffrt_task_attr_t *>(attr);
+    return (reinterpret_cast<ffrt::task_attr_private *>(p))->stackSize_;
+}
+
+API_ATTRIBUTE((visibility("default")))
+void ffrt_task_attr_set_nonblocking(ffrt_task_attr_t *attr, bool nonblocking)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return;
+    }
+    (reinterpret_cast<ffrt::task_attr_private *>(attr))->nonblocking_ = nonblocking;
+}
+
+API_ATTRIBUTE((visibility("default")))
+bool ffrt_task_attr_get_nonblocking(const ffrt_task_attr_t *attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return false;
+    }
+    ffrt_task_attr_t *p = const_cast<ffrt_task_attr_t *>(attr);
+    return (reinterpret_cast<ffrt::task_attr_private *>(p))->nonblocking_;
+}
+
+API_ATTRIBUTE((visibility("default")))
+void ffrt_task_attr_set_deadline(ffrt_task_attr_t *attr, uint64_t deadline_us)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return;
+    }
+    (reinterpret_cast<ffrt::task_attr_private *>(attr))->deadline_ = deadline_us;
+}
+
+API_ATTRIBUTE((visibility("default")))
+uint64_t ffrt_task_attr_get_deadline(const ffrt_task_attr_t *attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return 0;
+    }
+    ffrt_task_attr_t *p = const_cast<ffrt_task_attr_t *>(attr);
+    return (reinterpret_cast<ffrt::task_attr_private *>(p))->deadline_;
+}
+
+API_ATTRIBUTE((visibility("default")))
+void ffrt_task_attr_set_queue_priority(ffrt_task_attr_t *attr, ffrt_queue_priority_t priority)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return;
+    }
+    if (priority < ffrt_queue_priority_immediate || priority > ffrt_queue_priority_idle) {
+        FFRT_LOGE("priority should be a valid ffrt_queue_priority_t");
+        return;
+    }
+    (reinterpret_cast<ffrt::task_attr_private *>(attr))->prio_ = priority;
+}
+
+API_ATTRIBUTE((visibility("default")))
+ffrt_queue_priority_t ffrt_task_attr_get_queue_priority(const ffrt_task_attr_t *attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return ffrt_queue_priority_low;
+    }
+    ffrt_task_attr_t *p = const_cast<ffrt_task_attr_t *>(attr);
+    return (reinterpret_cast<ffrt::task_attr_private *>(p))->prio_;
+}
+
 // submit
+API_ATTRIBUTE((visibility("default")))
+void ffrt_task_attr_set_cancel_token(ffrt_task_attr_t *attr, ffrt_cancel_token_t token)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return;
+    }
+    (reinterpret_cast<ffrt::task_attr_private *>(attr))->cancelToken_ = static_cast<ffrt::CancelToken *>(token);
+}
+
+API_ATTRIBUTE((visibility("default")))
+ffrt_cancel_token_t ffrt_task_attr_get_cancel_token(const ffrt_task_attr_t *attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return nullptr;
+    }
+    ffrt_task_attr_t *p = const_cast<ffrt_task_attr_t *>(attr);
+    return (reinterpret_cast<ffrt::task_attr_private *>(p))->cancelToken_;
+}
+
+API_ATTRIBUTE((visibility("default")))
+void ffrt_task_attr_set_detached(ffrt_task_attr_t *attr, bool detached)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return;
+    }
+    (reinterpret_cast<ffrt::task_attr_private *>(attr))->detached_ = detached;
+}
+
+API_ATTRIBUTE((visibility("default")))
+bool ffrt_task_attr_get_detached(const ffrt_task_attr_t *attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should be a valid address");
+        return false;
+    }
+    ffrt_task_attr_t *p = const_cast<ffrt_task_attr_t *>(attr);
+    return (reinterpret_cast<ffrt::task_attr_private *>(p))->detached_;
+}
+
 API_ATTRIBUTE((visibility("default")))
 void *ffrt_alloc_auto_managed_function_storage_base(ffrt_function_kind_t kind)
 {
@@ -181,7 +316,7 @@ void *ffrt_alloc_auto_managed_function_storage_base(ffrt_function_kind_t kind)
         return ffrt::SimpleAllocator<ffrt::TaskCtx>::allocMem()->func_storage;
     }
 
-    return ffrt::SimpleAllocator<ffrt::SerialTask>::allocMem()->func_storage;
+    return ffrt::SimpleAllocator<ffrt::QueueTask>::allocMem()->func_storage;
 }
 
 API_ATTRIBUTE((visibility("default")))
@@ -233,6 +368,26 @@ ffrt_task_handle_t ffrt_submit_h_base(ffrt_function_header_t *f, const ffrt_deps
     return handle;
 }
 
+API_ATTRIBUTE((visibility("default")))
+void ffrt_submit_batch(ffrt_function_header_t **fs, const ffrt_deps_t *in_deps, const ffrt_deps_t *out_deps,
+    uint32_t num, const ffrt_task_attr_t *attr)
+{
+    if (!fs) {
+        FFRT_LOGE("function handlers should not be empty");
+        return;
+    }
+    ffrt::task_attr_private *p = reinterpret_cast<ffrt::task_attr_private *>(const_cast<ffrt_task_attr_t *>(attr));
+    if (likely(attr == nullptr || ffrt_task_attr_get_delay(attr) == 0)) {
+        ffrt::DependenceManager::Instance()->onSubmitBatch(fs, in_deps, out_deps, num, p);
+        return;
+    }
+
+    // every delayed task owns its delay helper
+    for (uint32_t i = 0; i < num; i++) {
+        ffrt_submit_base(fs[i], in_deps ? &in_deps[i] : nullptr, out_deps ? &out_deps[i] : nullptr, attr);
+    }
+}
+
 API_ATTRIBUTE((visibility("default")))
 void ffrt_task_handle_destroy(ffrt_task_handle_t handle)
 {
@@ -259,6 +414,24 @@ void ffrt_wait_deps(const ffrt_deps_t *deps)
     ffrt::DependenceManager::Instance()->onWait(&d);
 }
 
+API_ATTRIBUTE((visibility("default")))
+void ffrt_wait_deps_with_deadline(const ffrt_deps_t *deps, uint64_t deadline_us)
+{
+    if (!deps) {
+        FFRT_LOGE("deps should not be empty");
+        return;
+    }
+    std::vector<const void *> v(deps->len);
+    for (uint64_t i = 0; i < deps->len; ++i) {
+        v[i] = deps->items[i];
+    }
+    ffrt_deps_t d = { deps->len, v.data() };
+    int64_t now = ffrt::DeadlineNow();
+    int64_t deadline = deadline_us < static_cast<uint64_t>(INT64_MAX - now) ?
+        now + static_cast<int64_t>(deadline_us) : INT64_MAX;
+    ffrt::DependenceManager::Instance()->onWait(&d, deadline);
+}
+
 API_ATTRIBUTE((visibility("default")))
 void ffrt_wait()
 {
@@ -313,6 +486,23 @@ uint64_t ffrt_this_task_get_id()
     return curTask->gid;
 }
 
+API_ATTRIBUTE((visibility("default")))
+ffrt_cancel_token_t ffrt_this_task_get_cancel_token(void)
+{
+    auto curTask = ffrt::ExecuteCtx::Cur()->task;
+    if (curTask == nullptr) {
+        return nullptr;
+    }
+    return curTask->cancelToken;
+}
+
+API_ATTRIBUTE((visibility("default")))
+bool ffrt_this_task_is_cancelled(void)
+{
+    auto curTask = ffrt::ExecuteCtx::Cur()->task;
+    return curTask != nullptr && curTask->Cancelled();
+}
+
 API_ATTRIBUTE((visibility("default")))
 int ffrt_skip(ffrt_task_handle_t handle)
 {
@@ -329,6 +519,42 @@ int ffrt_skip(ffrt_task_handle_t handle)
     FFRT_LOGE("skip task [%lu] faild", task->gid);
     return 1;
 }
+
+API_ATTRIBUTE((visibility("default")))
+ffrt_cancel_token_t ffrt_cancel_token_create(ffrt_cancel_token_t parent)
+{
+    return new (std::nothrow) ffrt::CancelToken(static_cast<ffrt::CancelToken *>(parent));
+}
+
+API_ATTRIBUTE((visibility("default")))
+void ffrt_cancel_token_destroy(ffrt_cancel_token_t token)
+{
+    if (!token) {
+        FFRT_LOGE("token should not be empty");
+        return;
+    }
+    static_cast<ffrt::CancelToken *>(token)->DecRef();
+}
+
+API_ATTRIBUTE((visibility("default")))
+void ffrt_cancel_token_cancel(ffrt_cancel_token_t token)
+{
+    if (!token) {
+        FFRT_LOGE("token should not be empty");
+        return;
+    }
+    static_cast<ffrt::CancelToken *>(token)->Cancel();
+}
+
+API_ATTRIBUTE((visibility("default")))
+bool ffrt_cancel_token_is_cancelled(ffrt_cancel_token_t token)
+{
+    if (!token) {
+        FFRT_LOGE("token should not be empty");
+        return false;
+    }
+    return static_cast<ffrt::CancelToken *>(token)->Cancelled();
+}
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
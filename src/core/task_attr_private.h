@@ -19,6 +19,8 @@
 #include "cpp/task.h"
 
 namespace ffrt {
+class CancelToken;
+
 class task_attr_private {
 public:
     task_attr_private()
@@ -29,15 +31,28 @@ public:
     explicit task_attr_private(const task_attr attr)
         : qos_(attr.qos()),
           name_(attr.name()),
-          delay_(attr.delay())
+          delay_(attr.delay()),
+          stackSize_(attr.stack_size()),
+          nonblocking_(attr.nonblocking()),
+          deadline_(attr.deadline()),
+          prio_(attr.priority()),
+          cancelToken_(static_cast<CancelToken*>(attr.cancel_token())),
+          detached_(attr.detached())
     {
     }
 
     enum qos qos_;
     std::string name_;
     uint64_t delay_ = 0;
+    uint64_t stackSize_ = 0; // 0 means the default coroutine stack size
+    bool nonblocking_ = false; // run on the worker stack without a coroutine
+    uint64_t deadline_ = 0; // us after submission, 0 means no deadline
+    ffrt_queue_priority_t prio_ = ffrt_queue_priority_low; // order within a concurrent queue
     uint64_t timeout_ = 0;
     ffrt_function_header_t* timeoutCb_ = nullptr;
+    int maxConcurrency_ = 1; // tasks of a concurrent queue running at once
+    CancelToken* cancelToken_ = nullptr; // not owned, every task submitted with it takes a reference
+    bool detached_ = false; // a child of the detached root instead of the submitting task
 };
 }
 #endif
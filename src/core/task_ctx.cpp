@@ -36,23 +36,43 @@ static inline const char* DenpenceStr(Denpence d)
 
 TaskCtx::TaskCtx(const task_attr_private *attr, TaskCtx *parent, const uint64_t &id, const char *identity,
     const QoS &qos)
-    : parent(parent), rank(id), identity(identity), gid(++s_gid), qos(qos)
+    : parent(parent), rank(id), gid(++s_gid), qos(qos), identity(identity)
 {
     wue = nullptr;
     fq_we.task = this;
-    if (attr && !attr->name_.empty()) {
-        label = attr->name_;
-    } else if (IsRoot()) {
-        label = "root";
-    } else if (parent->parent == nullptr) {
-        label = "t" + std::to_string(rank);
-    } else {
-        label = parent->label + "." + std::to_string(rank);
+    if (attr) {
+        stackSize = attr->stackSize_;
+        stackless = attr->nonblocking_;
+        name = attr->name_;
+        if (attr->deadline_ > 0) {
+            ddl = DeadlineNow() + static_cast<int64_t>(attr->deadline_);
+        }
+        cancelToken = attr->cancelToken_;
+    }
+    if (cancelToken == nullptr && parent != nullptr) {
+        cancelToken = parent->cancelToken;
+    }
+    if (cancelToken != nullptr) {
+        cancelToken->IncRef();
     }
     if (!IsRoot()) {
-        FFRT_SUBMIT_MARKER(label, gid);
+        FFRT_SUBMIT_MARKER(GetLabel(), gid);
+    }
+    FFRT_LOGI("create task name:%s gid=%lu", GetLabel().c_str(), gid);
+}
+
+std::string TaskCtx::GetLabel() const
+{
+    if (!name.empty()) {
+        return name;
+    }
+    if (parent == nullptr) {
+        return "root";
+    }
+    if (parent->parent == nullptr) {
+        return "t" + std::to_string(rank);
     }
-    FFRT_LOGI("create task name:%s gid=%lu", label.c_str(), gid);
+    return parent->GetLabel() + "." + std::to_string(rank);
 }
 
 void TaskCtx::ChargeQoSSubmit(const QoS& qos)
@@ -61,7 +81,7 @@ void TaskCtx::ChargeQoSSubmit(const QoS& qos)
         if (!this->IsRoot()) {
             this->qos = parent->qos;
         }
-        FFRT_LOGD("Change task %s QoS %d", label.c_str(), static_cast<int>(this->qos));
+        FFRT_LOGD("Change task %s QoS %d", GetLabel().c_str(), static_cast<int>(this->qos));
     } else {
         this->qos = qos;
     }
@@ -87,7 +107,7 @@ void TaskCtx::InitRelatedIntervals(TaskCtx* curr)
 void TaskCtx::DecDepRef()
 {
     if (--depRefCnt == 0) {
-        FFRT_LOGI("Undependency completed, enter ready queue, task[%lu], name[%s]", gid, label.c_str());
+        FFRT_LOGI("Undependency completed, enter ready queue, task[%lu], name[%s]", gid, GetLabel().c_str());
         FFRT_WAKE_TRACER(this->gid);
         this->UpdateState(TaskState::READY);
 #ifdef FFRT_BBOX_ENABLE
@@ -98,7 +118,7 @@ void TaskCtx::DecDepRef()
 
 void TaskCtx::DecChildRef()
 {
-    FFRT_LOGD("DecChildRef parent task:%s, childWaitRefCnt=%u", parent->label.c_str(), parent->childWaitRefCnt.load());
+    FFRT_LOGD("DecChildRef parent task:%s, childWaitRefCnt=%u", parent->GetLabel().c_str(), parent->childWaitRefCnt.load());
     FFRT_TRACE_SCOPE(2, taskDecChildRef);
     std::unique_lock<decltype(parent->lock)> lck(parent->lock);
     parent->childWaitRefCnt--;
@@ -106,7 +126,7 @@ void TaskCtx::DecChildRef()
         return;
     }
     if (!parent->IsRoot() && parent->status == TaskStatus::RELEASED && parent->childWaitRefCnt == 0) {
-        FFRT_LOGD("free TaskCtx:%s gid=%lu", parent->label.c_str(), parent->gid);
+        FFRT_LOGD("free TaskCtx:%s gid=%lu", parent->GetLabel().c_str(), parent->gid);
         lck.unlock();
         parent->DecDeleteRef();
         return;
@@ -117,7 +137,7 @@ void TaskCtx::DecChildRef()
     parent->denpenceStatus = Denpence::DEPENCE_INIT;
 
 #ifdef EU_COROUTINE
-    if (parent->parent == nullptr) {
+    if (parent->parent == nullptr || parent->stackless) {
         parent->childWaitCond_.notify_all();
     } else {
         FFRT_WAKE_TRACER(parent->gid);
@@ -141,6 +161,11 @@ void TaskCtx::DecWaitDataRef()
             return;
         }
         denpenceStatus = Denpence::DEPENCE_INIT;
+        if (stackless) {
+            // notify under the lock, the task may finish and be freed as soon as it is released
+            dataWaitCond_.notify_all();
+            return;
+        }
     }
 
 #ifdef EU_COROUTINE
@@ -178,7 +203,7 @@ void TaskCtx::RecycleTask()
 {
     std::unique_lock<decltype(lock)> lck(lock);
     if (childWaitRefCnt == 0) {
-        FFRT_LOGD("free TaskCtx:%s gid=%lu", label.c_str(), gid);
+        FFRT_LOGD("free TaskCtx:%s gid=%lu", GetLabel().c_str(), gid);
         lck.unlock();
         DecDeleteRef();
         return;
@@ -187,9 +212,25 @@ void TaskCtx::RecycleTask()
     }
 }
 
+bool ThreadWaitMode(const TaskCtx* task)
+{
+    if (likely(task == nullptr || !task->stackless)) {
+        return task == nullptr;
+    }
+    // a frame on the worker stack cannot move onto a coroutine afterwards
+#ifndef FFRT_RELEASE
+    FFRT_LOGE("non-blocking task[%lu] name[%s] blocks", task->gid, task->GetLabel().c_str());
+    abort();
+#else
+    FFRT_LOGE("non-blocking task[%lu] name[%s] blocks, its worker waits until the monitor replaces it",
+        task->gid, task->GetLabel().c_str());
+    return true;
+#endif
+}
+
 void TaskCtx::MultiDepenceAdd(Denpence depType)
 {
-    FFRT_LOGD("task(%s) ADD_DENPENCE(%s)", this->label.c_str(), DenpenceStr(depType));
+    FFRT_LOGD("task(%s) ADD_DENPENCE(%s)", this->GetLabel().c_str(), DenpenceStr(depType));
     denpenceStatus = depType;
 }
 #ifdef FFRT_CO_BACKTRACE_OH_ENABLE
@@ -198,6 +239,10 @@ void TaskCtx::DumpTask(TaskCtx* task)
     unw_context_t ctx;
     unw_cursor_t unw_cur;
     unw_proc_info_t unw_proc;
+    if (task != nullptr && task->coRoutine == nullptr && ExecuteCtx::Cur()->task != task) {
+        FFRT_LOGW("stackless task[%lu] runs on another worker, no backtrace", task->gid);
+        return;
+    }
     if (ExecuteCtx::Cur()->task == task || task == nullptr) {
         unw_getcontext(&ctx);
     } else {
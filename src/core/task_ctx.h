@@ -16,9 +16,9 @@
 #ifndef FFRT_TASK_CTX_H
 #define FFRT_TASK_CTX_H
 
+#include <algorithm>
 #include <string>
 #include <functional>
-#include <unordered_set>
 #include <vector>
 #include <mutex>
 #include <atomic>
@@ -26,78 +26,136 @@
 #include <set>
 #include <list>
 #include <memory>
+#include <chrono>
 #include "internal_inc/types.h"
 #include "sched/task_state.h"
 #include "sched/interval.h"
 #include "eu/co_routine.h"
 #include "task_attr_private.h"
+#include "core/cancel_token.h"
 #include "util/slab.h"
 #include "util/task_deleter.h"
+#include "util/inline_set.h"
+#include "util/pairing_heap.h"
 #include "dfx/bbox/bbox.h"
 
 namespace ffrt {
 struct TaskCtx;
 struct VersionCtx;
+class mutexPrivate;
 
+constexpr uint32_t TASK_INLINE_DEPS = 4; // ins/outs kept inline, more spill to the heap
+
+// a task holds one version per signature in ins and in outs, merges swap versions of the same signature
+struct VersionSignature {
+    template <typename V>
+    const void* operator()(const V* v) const
+    {
+        return v->signature;
+    }
+};
+
+// time base of TaskCtx::ddl
+inline int64_t DeadlineNow()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Fields are grouped by who writes them: the submitter sets up the first group, producers and the ready queue
+ * touch the second one while the task waits to run, children and waiters the third one. The groups live on
+ * separate cache lines so that a busy parent is not slowed down by the bookkeeping of its children.
+ */
 struct TaskCtx : public TaskDeleter {
     TaskCtx(const task_attr_private* attr,
         TaskCtx* parent, const uint64_t& id, const char *identity = nullptr, const QoS& qos = QoS());
-    WaitEntry fq_we; // used on fifo fast que
-    WaitUntilEntry* wue;
-    bool wakeupTimeOut = false;
-    bool is_native_func = false;
-    SkipStatus skipped = SkipStatus::SUBMITTED;
 
     uint8_t func_storage[ffrt_auto_managed_function_storage_size]; // 函数闭包、指针或函数对象
     TaskCtx* parent = nullptr;
     const uint64_t rank = 0x0;
-    std::unordered_set<VersionCtx*> ins;
-    std::unordered_set<VersionCtx*> outs;
+    const uint64_t gid; // global unique id in this process
+    QoS qos;
+    const char* identity;
     CoRoutine* coRoutine = nullptr;
-    std::vector<std::string> traceTag;
-
-#ifdef MUTEX_PERF // Mutex Lock&Unlock Cycles Statistic
-    xx::mutex lock {"TaskCtx::lock"};
-#else
-    std::mutex lock; // used in coroute
-#endif
-    uint64_t myRefCnt = 0;
+    mutexPrivate* heldMutex = nullptr; // last ffrt mutex the task locked and still holds, chained to the others
+    CancelToken* cancelToken = nullptr; // referenced until the task is done
+    uint64_t stackSize = 0;
+    bool stackless = false; // runs on the worker stack, coRoutine stays null
+    bool is_native_func = false;
+    SkipStatus skipped = SkipStatus::SUBMITTED;
+    InlineSet<VersionCtx*, TASK_INLINE_DEPS, VersionSignature> ins;
+    InlineSet<VersionCtx*, TASK_INLINE_DEPS, VersionSignature> outs;
+    int64_t ddl = INT64_MAX; // absolute deadline in us of the steady clock, INT64_MAX means none
 
+    alignas(64) std::atomic_uint64_t depRefCnt {0};
     TaskState state;
+    WaitEntry fq_we; // used on fifo fast que
+    PairingHeapNode edfNode; // used on edf que
+    uint64_t edfSeq = 0; // enqueue order on edf que, breaks deadline ties
+    int64_t edfKey = INT64_MAX; // deadline the task is ordered by on edf que
+    std::atomic<int64_t> boostDdl {INT64_MAX}; // earliest deadline of the tasks waiting for this one
+    std::atomic<bool> upstreamCancelled {false}; // a version the task reads comes from a cancelled task
+    WaitUntilEntry* wue;
+    bool wakeupTimeOut = false;
+
 #ifdef MUTEX_PERF // Mutex Lock&Unlock Cycles Statistic
-    xx::mutex denpenceStatusLock {"TaskCtx::denpenceStatusLock"};
+    alignas(64) xx::mutex lock {"TaskCtx::lock"};
 #else
-    std::mutex denpenceStatusLock;
+    alignas(64) std::mutex lock; // used in coroute
 #endif
-    uint64_t pmuCntBegin = 0;
-    uint64_t pmuCnt = 0;
-    Denpence denpenceStatus {Denpence::DEPENCE_INIT};
     /* The current number of child nodes does not represent the real number of child nodes,
      * because the dynamic graph child nodes will grow to assist in the generation of id
      */
     std::atomic<uint64_t> childNum {0};
-    std::atomic_uint64_t depRefCnt {0};
-
     std::atomic_uint64_t childWaitRefCnt {0};
     std::condition_variable childWaitCond_;
 
     uint64_t dataWaitRefCnt {0}; // waited data count called by ffrt_wait()
     std::condition_variable dataWaitCond_; // wait data cond
     TaskStatus status = TaskStatus::PENDING;
+    uint64_t myRefCnt = 0;
+
+#ifdef MUTEX_PERF // Mutex Lock&Unlock Cycles Statistic
+    xx::mutex denpenceStatusLock {"TaskCtx::denpenceStatusLock"};
+#else
+    std::mutex denpenceStatusLock;
+#endif
+    Denpence denpenceStatus {Denpence::DEPENCE_INIT};
 
     void InitRelatedIntervals(TaskCtx* curr);
-    std::unordered_set<Interval*> relatedIntervals;
+    InlineSet<Interval*, 2> relatedIntervals;
 
-    const char* identity;
     int64_t ddlSlack = INT64_MAX;
     uint64_t load = 0;
-    int64_t ddl = INT64_MAX;
+    uint64_t pmuCntBegin = 0;
+    uint64_t pmuCnt = 0;
 
-    const uint64_t gid; // global unique id in this process
+    std::vector<std::string> traceTag;
+    std::string name; // set by task_attr, otherwise GetLabel derives the label from the parent
 
-    QoS qos;
     void ChargeQoSSubmit(const QoS& qos);
 
+    // own deadline or the one inherited from waiters, whichever is earlier
+    inline int64_t EffectiveDeadline() const
+    {
+        return std::min(ddl, boostDdl.load(std::memory_order_relaxed));
+    }
+
+    inline bool Cancelled() const
+    {
+        return upstreamCancelled.load(std::memory_order_relaxed) ||
+            (cancelToken != nullptr && cancelToken->Cancelled());
+    }
+
+    inline void ReleaseCancelToken()
+    {
+        if (cancelToken != nullptr) {
+            cancelToken->DecRef();
+            cancelToken = nullptr;
+        }
+    }
+
     inline void freeMem() override
     {
         BboxCheckAndFreeze();
@@ -118,6 +176,7 @@ struct TaskCtx : public TaskDeleter {
 
     inline void IncWaitDataRef()
     {
+        std::lock_guard<decltype(lock)> lck(lock);
         ++dataWaitRefCnt;
     }
     void DecWaitDataRef();
@@ -128,7 +187,8 @@ struct TaskCtx : public TaskDeleter {
     bool IsPrevTask(const TaskCtx* task) const;
     void MultiDepenceAdd(Denpence depType);
 
-    std::string label; // used for debug
+    // used for debug, built on demand so that submitting a nested task does not format strings
+    std::string GetLabel() const;
 
     inline bool IsRoot()
     {
@@ -163,5 +223,10 @@ struct TaskCtx : public TaskDeleter {
     static void DumpTask(TaskCtx* task);
 #endif
 };
+
+/* Whether a blocking call has to block the calling thread: true on non-worker threads and in stackless tasks,
+ * which have no coroutine to switch out. Tasks on a coroutine yield their worker instead.
+ */
+bool ThreadWaitMode(const TaskCtx* task);
 } /* namespace ffrt */
 #endif
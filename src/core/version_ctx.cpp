@@ -24,6 +24,9 @@ static inline void BuildConsumeRelationship(VersionCtx* version, TaskCtx* consum
     if (version->status == DataStatus::IDLE) {
         consumer->IncDepRef();
     }
+    if (version->cancelled) {
+        consumer->upstreamCancelled.store(true, std::memory_order_relaxed);
+    }
     version->consumers.insert(consumer);
     if (version->status == DataStatus::CONSUMED) {
         version->status = DataStatus::READY;
@@ -78,7 +81,7 @@ void VersionCtx::onProduced()
         if (consumers.empty()) {
             status = DataStatus::CONSUMED;
             NotifyNextProducer();
-            Entity::Instance()->versionTrashcan.push_back(this);
+            Entity::Instance()->GetShard(signature).versionTrashcan.push_back(this);
         } else { // if have consumers,notify them
             status = DataStatus::READY;
             NotifyConsumers();
@@ -98,7 +101,16 @@ void VersionCtx::onConsumed(TaskCtx* consumer)
     if (consumers.empty()) {
         status = DataStatus::CONSUMED;
         NotifyNextProducer();
-        Entity::Instance()->versionTrashcan.push_back(this);
+        Entity::Instance()->GetShard(signature).versionTrashcan.push_back(this);
+    }
+}
+
+// consumers added later see the flag when they are linked to this version
+void VersionCtx::Cancel()
+{
+    cancelled = true;
+    for (auto consumer : std::as_const(consumers)) {
+        consumer->upstreamCancelled.store(true, std::memory_order_relaxed);
     }
 }
 
@@ -118,6 +130,9 @@ void VersionCtx::MergeChildVersion()
     // Merge VersionCtx
     auto versionToMerge = last;
     status = versionToMerge->status;
+    if (versionToMerge->cancelled) {
+        Cancel();
+    }
     if (status == DataStatus::READY) {
         NotifyConsumers();
         NotifyDataWaitTask();
@@ -128,6 +143,6 @@ void VersionCtx::MergeChildVersion()
         MergeProducerOutDep(versionToMerge);
         myProducer = versionToMerge->myProducer;
     }
-    Entity::Instance()->versionTrashcan.push_back(versionToMerge);
+    Entity::Instance()->GetShard(signature).versionTrashcan.push_back(versionToMerge);
 }
 } /* namespace ffrt */
\ No newline at end of file
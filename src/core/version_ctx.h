@@ -47,6 +47,7 @@ struct VersionCtx : private NonCopyable {
     TaskCtx* nextProducer {nullptr};
 
     DataStatus status {DataStatus::IDLE};
+    bool cancelled {false}; // produced by a cancelled task
     std::vector<TaskCtx*> dataWaitTaskByThis;
 
     void AddConsumer(TaskCtx* consumer, NestType nestType);
@@ -61,6 +62,7 @@ struct VersionCtx : private NonCopyable {
     }
     void onProduced();
     void onConsumed(TaskCtx* consumer);
+    void Cancel();
 protected:
     void CreateChildVersion(TaskCtx* task, DataStatus dataStatus);
     void MergeChildVersion();
@@ -90,15 +92,18 @@ protected:
     inline void MergeConsumerInDep(VersionCtx* v)
     {
         for (const auto& consumer : std::as_const(v->consumers)) {
+            // ins of a running task may be scanned by its child submitting under other shards
+            std::lock_guard<decltype(consumer->lock)> lck(consumer->lock);
+            consumer->ins.erase(v);
             consumer->ins.insert(this);
-            consumer->ins.erase(consumer->ins.find(v));
         }
     }
 
     inline void MergeProducerOutDep(VersionCtx* v)
     {
+        std::lock_guard<decltype(v->myProducer->lock)> lck(v->myProducer->lock);
+        v->myProducer->outs.erase(v);
         v->myProducer->outs.insert(this);
-        v->myProducer->outs.erase(v->myProducer->outs.find(v));
     }
 };
 } /* namespace ffrt */
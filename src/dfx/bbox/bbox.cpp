@@ -72,7 +72,7 @@ static inline void SaveCurrent()
     auto t = ExecuteCtx::Cur()->task;
     if (t) {
         FFRT_BBOX_LOG("current: thread id %u, task id %lu, qos %d, name %s", gettid(),
-            t->gid, t->qos(), t->label.c_str());
+            t->gid, t->qos(), t->GetLabel().c_str());
     }
 
     const int IGNORE_DEPTH = 3;
@@ -105,7 +105,7 @@ static inline void SaveWorkerStatus()
                 continue;
             }
             FFRT_BBOX_LOG("qos %d: worker tid %d is running task id %lu name %s", i, thread.first->Id(),
-                t->gid, t->label.c_str());
+                t->gid, t->GetLabel().c_str());
         }
     }
 }
@@ -114,19 +114,23 @@ static inline void SaveReadyQueueStatus()
 {
     FFRT_BBOX_LOG("<<<=== ready queue status ===>>>");
     for (int i = 0; i < qos_user_interactive + 1; i++) {
-        int nt = FFRTScheduler::Instance()->GetScheduler(QoS(static_cast<enum qos>(i))).RQSize();
+        uint64_t miss = FFRTScheduler::Instance()->GetDeadlineMissNum(QoS(static_cast<enum qos>(i)));
+        if (miss > 0) {
+            FFRT_BBOX_LOG("qos %d: %lu tasks missed their deadline", i + 1, miss);
+        }
+        int nt = FFRTScheduler::Instance()->RQSize(QoS(static_cast<enum qos>(i)));
         if (!nt) {
             continue;
         }
 
         for (int j = 0; j < nt; j++) {
-            TaskCtx* t = FFRTScheduler::Instance()->GetScheduler(QoS(static_cast<enum qos>(i))).PickNextTask();
+            TaskCtx* t = FFRTScheduler::Instance()->PickNextTask(QoS(static_cast<enum qos>(i)));
             if (t == nullptr) {
                 FFRT_BBOX_LOG("qos %d: ready queue task <%d/%d> null", i + 1, j, nt);
                 continue;
             }
             FFRT_BBOX_LOG("qos %d: ready queue task <%d/%d> id %lu name %s",
-                i + 1, j, nt, t->gid, t->label.c_str());
+                i + 1, j, nt, t->gid, t->GetLabel().c_str());
         }
     }
 }
@@ -148,7 +152,7 @@ static inline void SaveTaskStatus()
         size_t idx = 1;
         for (auto t : tmp) {
             FFRT_BBOX_LOG("<%zu/%lu> id %lu qos %d name %s", idx++,
-                tmp.size(), t->gid, t->qos(), t->label.c_str());
+                tmp.size(), t->gid, t->qos(), t->GetLabel().c_str());
             if (t->coRoutine && (t->coRoutine->status.load() == static_cast<int>(CoStatus::CO_NOT_FINISH))) {
                 CoStart(t);
             }
@@ -23,13 +23,8 @@
 #include "core/entity.h"
 #include "sched/scheduler.h"
 #include "sync/sync.h"
-#include "util/slab.h"
-#ifndef _MSC_VER
-#include <sys/mman.h>
-#else
-#define PROT_READ 0x1
-#define PROT_WRITE 0x2
-#endif
+#include "sync/mutex_private.h"
+#include "eu/co_stack_pool.h"
 #include "sched/sched_deadline.h"
 #include "sync/perf_counter.h"
 #include "sync/io_poller.h"
@@ -51,7 +46,7 @@ static inline void CoStartEntry(void* arg)
 {
     CoRoutine* co = reinterpret_cast<CoRoutine*>(arg);
     {
-        FFRT_LOGI("Execute func() task[%lu], name[%s]", co->task->gid, co->task->label.c_str());
+        FFRT_LOGI("Execute func() task[%lu], name[%s]", co->task->gid, co->task->GetLabel().c_str());
         auto f = reinterpret_cast<ffrt_function_header_t*>(co->task->func_storage);
         auto exp = ffrt::SkipStatus::SUBMITTED;
         if (likely(__atomic_compare_exchange_n(&co->task->skipped, &exp, ffrt::SkipStatus::EXECUTED, 0,
@@ -60,6 +55,8 @@ static inline void CoStartEntry(void* arg)
         }
         f->destroy(f);
     }
+    // once exited the task may be recycled, a deadline is checked once the task ran to its end
+    ffrt::FFRTScheduler::Instance()->CheckDeadline(co->task);
     FFRT_TASKDONE_MARKER(co->task->gid);
     co->task->UpdateState(ffrt::TaskState::EXITED);
     co->status.store(static_cast<int>(CoStatus::CO_UNINITIALIZED));
@@ -75,61 +72,27 @@ static inline void CoInitThreadEnv(void)
     }
 }
 
-static void CoSetStackProt(CoRoutine* co, int prot)
-{
-    /* set the attribute of the page table closest to the stack top in the user stack to read-only,
-     * and 1~2 page table space will be wasted
-     */
-#ifndef _MSC_VER
-    size_t p_size = getpagesize();
-#else
-    size_t p_size = 4 * 1024;
-#endif
-    if (CoStackAttr::Instance()->size < p_size * 3) {
-        abort();
-    }
-
-#ifndef _MSC_VER
-    uint64_t mp = reinterpret_cast<uint64_t>(co->stkMem.stk);
-    mp = (mp + p_size - 1) / p_size * p_size;
-    int ret = mprotect(reinterpret_cast<void *>(static_cast<uintptr_t>(mp)), p_size, PROT_READ);
-    if (ret < 0) {
-        printf("coroutine size:%lu, mp:0x%lx, page_size:%zu,result:%d,prot:%d, err:%d,%s.\n",
-            static_cast<unsigned long>(sizeof(struct CoRoutine)), static_cast<unsigned long>(mp),
-            p_size, ret, prot, errno, strerror(errno));
-        abort();
-    }
-#endif
-}
-
-static inline CoRoutine* AllocNewCoRoutine(void)
+static inline CoRoutine* AllocNewCoRoutine(uint64_t stackSize)
 {
-    std::size_t stack_size = CoStackAttr::Instance()->size + sizeof(CoRoutine) - 8;
-    CoRoutine* co = ffrt::QSimpleAllocator<CoRoutine>::allocMem(stack_size);
+    CoRoutine* co = ffrt::CoStackPool::Instance().Alloc(stackSize);
     if (co == nullptr) {
         abort();
     }
-
-    co->stkMem.size = CoStackAttr::Instance()->size;
-    co->stkMem.magic = STACK_MAGIC;
-    if (CoStackAttr::Instance()->type == CoStackProtectType::CO_STACK_STRONG_PROTECT) {
-        CoSetStackProt(co, PROT_READ);
-    }
     co->status.store(static_cast<int>(CoStatus::CO_UNINITIALIZED));
     return co;
 }
 
 static inline void CoMemFree(CoRoutine* co)
 {
-    if (CoStackAttr::Instance()->type == CoStackProtectType::CO_STACK_STRONG_PROTECT) {
-        CoSetStackProt(co, PROT_WRITE | PROT_READ);
-    }
-    ffrt::QSimpleAllocator<CoRoutine>::freeMem(co);
+    ffrt::CoStackPool::Instance().Free(co);
 }
 
 void CoWorkerExit()
 {
     if (g_CoThreadEnv) {
+        if (g_CoThreadEnv->runningCo) {
+            CoMemFree(g_CoThreadEnv->runningCo);
+        }
         ::free(g_CoThreadEnv);
         g_CoThreadEnv = nullptr;
     }
@@ -159,8 +122,15 @@ static inline int CoAlloc(ffrt::TaskCtx* task)
         }
         g_CoThreadEnv->runningCo = task->coRoutine;
     } else {
+        // the idle coroutine of this worker is reused if its stack is of the size class the task asks for
+        uint64_t stackSize = ffrt::CoStackPool::SizeClass(task->stackSize != 0 ? task->stackSize :
+            CoStackAttr::Instance()->size);
+        if (g_CoThreadEnv->runningCo && g_CoThreadEnv->runningCo->stkMem.size != stackSize) {
+            CoMemFree(g_CoThreadEnv->runningCo);
+            g_CoThreadEnv->runningCo = nullptr;
+        }
         if (!g_CoThreadEnv->runningCo) {
-            g_CoThreadEnv->runningCo = AllocNewCoRoutine();
+            g_CoThreadEnv->runningCo = AllocNewCoRoutine(stackSize);
         }
     }
     BindNewCoRoutione(task);
@@ -182,7 +152,7 @@ static inline void CoStackCheck(CoRoutine* co)
 {
     if (co->stkMem.magic != STACK_MAGIC) {
         FFRT_LOGE("sp offset:%lu.\n", (uint64_t)co->stkMem.stk +
-            CoStackAttr::Instance()->size - co->ctx.regs[REG_SP]);
+            co->stkMem.size - co->ctx.regs[REG_SP]);
         FFRT_LOGE("stack over flow, check local variable in you tasks or use api 'ffrt_set_co_stack_attribute'.\n");
         abort();
     }
@@ -225,9 +195,9 @@ void CoStart(ffrt::TaskCtx* task)
 #endif
 
     for (;;) {
-        FFRT_LOGI("Costart task[%lu], name[%s]", task->gid, task->label.c_str());
+        FFRT_LOGI("Costart task[%lu], name[%s]", task->gid, task->GetLabel().c_str());
         ffrt::TaskLoadTracking::Begin(task);
-        FFRT_TASK_BEGIN(task->label, task->gid);
+        FFRT_TASK_BEGIN(task->GetLabel(), task->gid);
         CoSwitchInTrace(task);
 
         CoSwitch(&co->thEnv->schCtx, &co->ctx);
@@ -244,7 +214,7 @@ void CoStart(ffrt::TaskCtx* task)
         g_CoThreadEnv->pending = nullptr;
         // Fast path: skip state transition
         if ((*pending)(task)) {
-            FFRT_LOGI("Cowait task[%lu], name[%s]", task->gid, task->label.c_str());
+            FFRT_LOGI("Cowait task[%lu], name[%s]", task->gid, task->GetLabel().c_str());
 #ifdef FFRT_BBOX_ENABLE
             TaskSwitchCounterInc();
 #endif
@@ -279,7 +249,11 @@ void CoYield(void)
 void CoWait(const std::function<bool(ffrt::TaskCtx*)>& pred)
 {
     g_CoThreadEnv->pending = &pred;
+    // waiters of the mutexes the task holds stop spinning while it is switched out
+    ffrt::TaskCtx* task = static_cast<CoRoutine*>(g_CoThreadEnv->runningCo)->task;
+    ffrt::MutexOwnerParked(task, true);
     CoYield();
+    ffrt::MutexOwnerParked(task, false);
 }
 
 void CoWake(ffrt::TaskCtx* task, bool timeOut)
@@ -289,8 +263,18 @@ void CoWake(ffrt::TaskCtx* task, bool timeOut)
         return;
     }
     // Fast path: state transition without lock
-    FFRT_LOGI("Cowake task[%lu], name[%s], timeOut[%d]", task->gid, task->label.c_str(), timeOut);
+    FFRT_LOGI("Cowake task[%lu], name[%s], timeOut[%d]", task->gid, task->GetLabel().c_str(), timeOut);
     task->wakeupTimeOut = timeOut;
     FFRT_WAKE_TRACER(task->gid);
     task->UpdateState(ffrt::TaskState::READY);
 }
+
+void CoWakeBatch(std::vector<ffrt::TaskCtx*>& tasks)
+{
+    for (auto task : tasks) {
+        task->wakeupTimeOut = false;
+        FFRT_WAKE_TRACER(task->gid);
+    }
+    FFRT_LOGI("Cowake %zu tasks", tasks.size());
+    ffrt::TaskState::OnBatchTransition(ffrt::TaskState::READY, tasks);
+}
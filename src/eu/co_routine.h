@@ -16,6 +16,7 @@
 #ifndef FFRT_CO_ROUTINE_HPP
 #define FFRT_CO_ROUTINE_HPP
 #include <functional>
+#include <vector>
 #include <atomic>
 #include "co2_context.h"
 #if defined(__aarch64__)
@@ -62,7 +63,7 @@ struct CoRoutineEnv {
 struct StackMem {
     uint64_t size;
     size_t magic;
-    uint8_t stk[8];
+    uint8_t* stk; // lowest address of the stack, a guard page lies right below it
 };
 
 struct CoRoutine {
@@ -100,4 +101,6 @@ void CoYield(void);
 
 void CoWait(const std::function<bool(ffrt::TaskCtx*)>& pred);
 void CoWake(ffrt::TaskCtx* task, bool timeOut);
+// wakes the tasks with one ready queue insertion and worker wakeup per qos
+void CoWakeBatch(std::vector<ffrt::TaskCtx*>& tasks);
 #endif
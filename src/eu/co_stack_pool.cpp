@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "eu/co_stack_pool.h"
+#include <new>
+#include <cerrno>
+#include <cstring>
+#ifndef _MSC_VER
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "dfx/log/ffrt_log_api.h"
+
+namespace ffrt {
+namespace {
+inline uint32_t ClassOf(uint64_t stackSize)
+{
+    return static_cast<uint32_t>(63 - __builtin_clzll(stackSize)) - CO_STACK_MIN_SHIFT;
+}
+} // namespace
+
+CoStackPool::CoStackPool()
+{
+#ifndef _MSC_VER
+    pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    pageSize = 4 * 1024;
+#endif
+    headerSize = (sizeof(CoRoutine) + pageSize - 1) / pageSize * pageSize;
+}
+
+uint64_t CoStackPool::SizeClass(uint64_t size)
+{
+    constexpr uint64_t minSize = 1ULL << CO_STACK_MIN_SHIFT;
+    constexpr uint64_t maxSize = 1ULL << CO_STACK_MAX_SHIFT;
+    if (size <= minSize) {
+        return minSize;
+    }
+    if (size > maxSize) {
+        FFRT_LOGW("stack size %llu exceeds the limit, use %llu", static_cast<unsigned long long>(size),
+            static_cast<unsigned long long>(maxSize));
+        return maxSize;
+    }
+    return 1ULL << (64 - __builtin_clzll(size - 1));
+}
+
+std::size_t CoStackPool::MapBytes(uint32_t cls) const
+{
+    return headerSize + pageSize + (static_cast<std::size_t>(1) << (cls + CO_STACK_MIN_SHIFT));
+}
+
+CoRoutine* CoStackPool::Map(uint32_t cls)
+{
+    std::size_t bytes = MapBytes(cls);
+#ifndef _MSC_VER
+    // MAP_NORESERVE: only the pages a task really touches are committed
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        FFRT_LOGE("mmap coroutine of %zu bytes failed, errno %d", bytes, errno);
+        return nullptr;
+    }
+    if (mprotect(static_cast<char*>(p) + headerSize, pageSize, PROT_NONE) != 0) {
+        FFRT_LOGE("mprotect coroutine guard page failed, errno %d", errno);
+        munmap(p, bytes);
+        return nullptr;
+    }
+#else
+    void* p = ::operator new(bytes, std::nothrow);
+    if (p == nullptr) {
+        return nullptr;
+    }
+#endif
+    auto co = static_cast<CoRoutine*>(p);
+    co->stkMem.size = static_cast<uint64_t>(1) << (cls + CO_STACK_MIN_SHIFT);
+    co->stkMem.magic = STACK_MAGIC;
+    co->stkMem.stk = static_cast<uint8_t*>(p) + headerSize + pageSize;
+    return co;
+}
+
+void CoStackPool::Unmap(CoRoutine* co, uint32_t cls)
+{
+#ifndef _MSC_VER
+    munmap(co, MapBytes(cls));
+#else
+    ::operator delete(co);
+#endif
+}
+
+void CoStackPool::Reclaim(CoRoutine* co)
+{
+#ifndef _MSC_VER
+    // the header stays, the stack pages are zero filled on the next touch
+    if (madvise(co->stkMem.stk, co->stkMem.size, MADV_DONTNEED) != 0) {
+        FFRT_LOGW("madvise coroutine stack failed, errno %d", errno);
+    }
+#endif
+}
+
+std::size_t CoStackPool::Resident(CoRoutine* co, uint32_t cls)
+{
+#ifndef _MSC_VER
+    std::size_t pages = MapBytes(cls) / pageSize;
+    std::vector<unsigned char> vec(pages);
+    if (mincore(co, pages * pageSize, vec.data()) != 0) {
+        return 0;
+    }
+    std::size_t resident = 0;
+    for (auto v : vec) {
+        resident += (v & 1) ? pageSize : 0;
+    }
+    return resident;
+#else
+    return MapBytes(cls);
+#endif
+}
+
+CoRoutine* CoStackPool::Alloc(uint64_t stackSize)
+{
+    uint32_t cls = ClassOf(SizeClass(stackSize));
+    ClassPool& pool = pools[cls];
+    int node = CpuTopology::Instance().CurrentNodeSlot();
+    CoRoutine* co = nullptr;
+    {
+        std::lock_guard lg(pool.lock);
+        // hot stacks of the node first, their pages are still resident, then cold ones, then remote hot ones
+        if (!pool.hot[node].empty()) {
+            co = pool.hot[node].back();
+            pool.hot[node].pop_back();
+        } else if (!pool.cold.empty()) {
+            co = pool.cold.back();
+            pool.cold.pop_back();
+        } else {
+            for (auto& hot : pool.hot) {
+                if (!hot.empty()) {
+                    co = hot.back();
+                    hot.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+    if (co != nullptr) {
+        return co;
+    }
+
+    co = Map(cls);
+    if (co != nullptr) {
+        std::lock_guard lg(pool.lock);
+        pool.mapped.insert(co);
+    }
+    return co;
+}
+
+void CoStackPool::Free(CoRoutine* co)
+{
+    uint32_t cls = ClassOf(co->stkMem.size);
+    ClassPool& pool = pools[cls];
+    int node = CpuTopology::Instance().CurrentNodeSlot();
+    bool unmap = false;
+    {
+        std::lock_guard lg(pool.lock);
+        if (pool.hot[node].size() < CO_STACK_HOT_WATERMARK) {
+            pool.hot[node].push_back(co);
+            return;
+        }
+        unmap = pool.cold.size() >= CO_STACK_COLD_LIMIT;
+        if (unmap) {
+            pool.mapped.erase(co);
+        }
+    }
+
+    // syscalls are made out of the lock
+    if (unmap) {
+        Unmap(co, cls);
+        return;
+    }
+
+    Reclaim(co);
+    std::lock_guard lg(pool.lock);
+    pool.cold.push_back(co);
+}
+
+CoStackPoolStats CoStackPool::GetStats()
+{
+    CoStackPoolStats stats;
+    for (uint32_t cls = 0; cls < CO_STACK_CLASS_NUM; cls++) {
+        ClassPool& pool = pools[cls];
+        std::lock_guard lg(pool.lock);
+        std::size_t hotNum = 0;
+        for (auto& hot : pool.hot) {
+            hotNum += hot.size();
+        }
+        stats.reservedBytes += pool.mapped.size() * MapBytes(cls);
+        stats.hotNum += hotNum;
+        stats.coldNum += pool.cold.size();
+        stats.liveNum += pool.mapped.size() - hotNum - pool.cold.size();
+        for (auto co : pool.mapped) {
+            stats.residentBytes += Resident(co, cls);
+        }
+    }
+    return stats;
+}
+} // namespace ffrt
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FFRT_CO_STACK_POOL_HPP
+#define FFRT_CO_STACK_POOL_HPP
+
+#include <array>
+#include <vector>
+#include <unordered_set>
+#include "eu/co_routine.h"
+#include "sync/sync.h"
+#include "util/cpu_topology.h"
+
+namespace ffrt {
+constexpr uint32_t CO_STACK_MIN_SHIFT = 14; // 16K
+constexpr uint32_t CO_STACK_MAX_SHIFT = 26; // 64M
+constexpr uint32_t CO_STACK_CLASS_NUM = CO_STACK_MAX_SHIFT - CO_STACK_MIN_SHIFT + 1;
+constexpr std::size_t CO_STACK_HOT_WATERMARK = 16; // released stacks per class and numa node kept resident
+constexpr std::size_t CO_STACK_COLD_LIMIT = 64; // released stacks per class kept mapped after madvise
+
+struct CoStackPoolStats {
+    std::size_t reservedBytes = 0; // address space mapped for coroutines
+    std::size_t residentBytes = 0; // part of it backed by physical pages
+    std::size_t liveNum = 0; // coroutines owned by workers or blocked tasks
+    std::size_t hotNum = 0; // released coroutines whose stack pages are still resident
+    std::size_t coldNum = 0; // released coroutines whose stack pages went back to the kernel
+};
+
+/*
+ * Coroutines are carved from per-size-class pools. Every coroutine is a private mapping laid out as
+ * [CoRoutine header][guard page][stack], the stack grows down towards the guard page and its pages are only
+ * committed when the task touches them. Released coroutines are kept hot up to a watermark, beyond it their
+ * stack pages are dropped with madvise and beyond the cold limit the mapping is returned.
+ * Hot stacks are kept per numa node of the releasing worker and handed out to workers of the same node first,
+ * cold stacks have no pages left and fault them in on the node that uses them next.
+ */
+class CoStackPool {
+public:
+    static CoStackPool& Instance()
+    {
+        static CoStackPool* ins = new CoStackPool();
+        return *ins;
+    }
+
+    // stack size actually used for a request, a power of two in [16K, 64M]
+    static uint64_t SizeClass(uint64_t size);
+
+    CoRoutine* Alloc(uint64_t stackSize);
+    void Free(CoRoutine* co);
+    CoStackPoolStats GetStats();
+
+private:
+    struct ClassPool {
+        fast_mutex lock;
+        std::array<std::vector<CoRoutine*>, NUMA_NODE_SLOT_NUM> hot;
+        std::vector<CoRoutine*> cold;
+        std::unordered_set<CoRoutine*> mapped;
+    };
+
+    CoStackPool();
+    CoStackPool(const CoStackPool&) = delete;
+    CoStackPool& operator=(const CoStackPool&) = delete;
+
+    std::size_t MapBytes(uint32_t cls) const;
+    CoRoutine* Map(uint32_t cls);
+    void Unmap(CoRoutine* co, uint32_t cls);
+    void Reclaim(CoRoutine* co);
+    std::size_t Resident(CoRoutine* co, uint32_t cls);
+
+    std::size_t pageSize;
+    std::size_t headerSize;
+    std::array<ClassPool, CO_STACK_CLASS_NUM> pools;
+};
+} // namespace ffrt
+#endif
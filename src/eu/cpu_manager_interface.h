@@ -41,8 +41,9 @@ struct CpuWorkerOps {
 
 struct CpuMonitorOps {
     std::function<bool (const QoS& qos)> IncWorker;
-    std::function<void (const QoS& qos)> WakeupWorkers;
+    std::function<void (const QoS& qos, int num)> WakeupWorkers;
     std::function<int (const QoS& qos)> GetTaskCount;
+    std::function<size_t (const QoS& qos)> GetBlockedNum;
 };
 }
 #endif
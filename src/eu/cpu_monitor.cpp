@@ -14,110 +14,42 @@
  */
 
 #include "eu/cpu_monitor.h"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <unistd.h>
-#include <sys/prctl.h>
 #include <sys/syscall.h>
 #include "sched/scheduler.h"
-#include "eu/wgcm.h"
 #include "eu/execute_unit.h"
 #include "dfx/log/ffrt_log_api.h"
 #include "internal_inc/config.h"
 namespace ffrt {
 void CPUMonitor::HandleBlocked(const QoS& qos)
 {
-    int taskCount = ops.GetTaskCount(qos);
-    if (taskCount == 0) {
-        return;
-    }
+    int blockedNum = static_cast<int>(ops.GetBlockedNum(qos));
     WorkerCtrl& workerCtrl = ctrlQueue[static_cast<int>(qos)];
     workerCtrl.lock.lock();
-    size_t exeValue = static_cast<uint32_t>(workerCtrl.executionNum);
+    workerCtrl.blockedNum = blockedNum;
+    int surplus = workerCtrl.executionNum - blockedNum - static_cast<int>(workerCtrl.maxConcurrency);
+    workerCtrl.surplusNum.store(std::max(surplus, 0), std::memory_order_relaxed);
     workerCtrl.lock.unlock();
-    size_t blockedNum = CountBlockedNum(qos);
-    if (blockedNum > 0 && (exeValue - blockedNum < workerCtrl.maxConcurrency) && exeValue < workerCtrl.hardLimit) {
-        Poke(qos);
-    }
-}
 
-void MonitorMain(CPUMonitor* monitor)
-{
-    (void)pthread_setname_np(pthread_self(), "ffrt_moniotor");
-    int ret = prctl(PR_WGCM_CTL, WGCM_CTL_SERVER_REG, 0, 0, 0);
-    if (ret) {
-        FFRT_LOGE("[SERVER] wgcm register server failed ret is %{public}d", ret);
-    }
-
-    ret = syscall(SYS_gettid);
-    if (ret == -1) {
-        monitor->monitorTid = 0;
-        FFRT_LOGE("syscall(SYS_gettid) failed");
-    } else {
-        monitor->monitorTid = static_cast<uint32_t>(ret);
-    }
-
-    for (unsigned int i = 0; i < static_cast<unsigned int>(QoS::Max()); i++) {
-        struct wgcm_workergrp_data grp = {0};
-        grp.gid = i;
-        grp.min_concur_workers = DEFAULT_MINCONCURRENCY;
-        grp.max_workers_sum = DEFAULT_HARDLIMIT;
-        ret = prctl(PR_WGCM_CTL, WGCM_CTL_SET_GRP, &grp, 0, 0);
-        if (ret) {
-            FFRT_LOGE("[SERVER] wgcm group %u register failed\n ret is %{public}d", i, ret);
-        }
-    }
-
-    while (true) {
-        struct wgcm_workergrp_data data = {0};
-        ret = prctl(PR_WGCM_CTL, WGCM_CTL_WAIT, &data, 0, 0);
-        if (ret) {
-            FFRT_LOGE("[SERVER] wgcm server wait failed ret is %{public}d", ret);
-            sleep(1);
-            continue;
-        }
-        if (data.woken_flag == WGCM_ACTIVELY_WAKE) {
-            break;
-        }
-
-        for (auto qos = QoS::Min(); qos < QoS::Max(); ++qos) {
-            monitor->HandleBlocked(qos);
-        }
-    }
-    ret = prctl(PR_WGCM_CTL, WGCM_CTL_UNREGISTER, 0, 0, 0);
-    if (ret) {
-        FFRT_LOGE("[SERVER] wgcm server unregister failed ret is %{public}d.", ret);
+    // blocked workers leave their share of the concurrency to new ones
+    int taskCount = ops.GetTaskCount(qos);
+    if (blockedNum > 0 && taskCount > 0) {
+        Poke(qos, taskCount);
     }
 }
 
 void CPUMonitor::SetupMonitor()
 {
     for (auto qos = QoS::Min(); qos < QoS::Max(); ++qos) {
-        ctrlQueue[qos].hardLimit = DEFAULT_HARDLIMIT;
+        ctrlQueue[qos].hardLimit = GlobalConfig::Instance().getHardLimit();
         ctrlQueue[qos].workerManagerID = static_cast<uint32_t>(qos);
         ctrlQueue[qos].maxConcurrency = GlobalConfig::Instance().getCpuWorkerNum(static_cast<enum qos>(qos));
     }
 }
 
-void CPUMonitor::RegWorker(const QoS& qos)
-{
-    struct wgcm_workergrp_data grp;
-    grp.gid = static_cast<uint32_t>(qos);
-    grp.server_tid = monitorTid;
-    int ret = prctl(PR_WGCM_CTL, WGCM_CTL_WORKER_REG, &grp, 0, 0);
-    if (ret) {
-        FFRT_LOGE("[WORKER] Register failed! error=%d\n", ret);
-    }
-}
-
-void CPUMonitor::UnRegWorker()
-{
-    int ret = prctl(PR_WGCM_CTL, WGCM_CTL_UNREGISTER, 0, 0, 0);
-    if (ret) {
-        FFRT_LOGE("leave workgroup failed  error=%d\n", ret);
-    }
-}
-
 CPUMonitor::CPUMonitor(CpuMonitorOps&& ops) : ops(ops)
 {
     SetupMonitor();
@@ -126,6 +58,11 @@ CPUMonitor::CPUMonitor(CpuMonitorOps&& ops) : ops(ops)
 
 CPUMonitor::~CPUMonitor()
 {
+    {
+        std::lock_guard lg(sampleMutex);
+        sampleStop = true;
+        sampleCond.notify_one();
+    }
     if (monitorThread != nullptr) {
         monitorThread->join();
     }
@@ -135,12 +72,60 @@ CPUMonitor::~CPUMonitor()
 
 void CPUMonitor::StartMonitor()
 {
-    monitorThread = new std::thread(MonitorMain, this);
+    monitorThread = new std::thread([this] { SampleMain(); });
+}
+
+/*
+ * Workers publish an epoch that is odd while a task runs. A worker whose epoch did not move between two samples
+ * and whose thread is not runnable is blocked in the kernel, e.g. in a read() or a thread mode wait.
+ * Sampling stops while no worker executes and resumes on the next picked task.
+ */
+void CPUMonitor::SampleMain()
+{
+    (void)pthread_setname_np(pthread_self(), "ffrt_monitor");
+    long tid = syscall(SYS_gettid);
+    if (tid == -1) {
+        FFRT_LOGE("syscall(SYS_gettid) failed");
+    } else {
+        monitorTid.store(static_cast<uint32_t>(tid), std::memory_order_relaxed);
+    }
+    std::unique_lock lk(sampleMutex);
+    while (!sampleStop) {
+        lk.unlock();
+        bool busy = false;
+        for (auto qos = QoS::Min(); qos < QoS::Max(); ++qos) {
+            HandleBlocked(qos);
+            WorkerCtrl& workerCtrl = ctrlQueue[qos];
+            workerCtrl.lock.lock();
+            busy = busy || workerCtrl.executionNum > 0;
+            workerCtrl.lock.unlock();
+        }
+        lk.lock();
+        if (busy) {
+            sampleCond.wait_for(lk, MONITOR_SAMPLE_INTERVAL, [this] { return sampleStop; });
+            continue;
+        }
+        sampleIdle.store(true, std::memory_order_relaxed);
+        // the timeout covers a pick that raced with going idle
+        sampleCond.wait_for(lk, MONITOR_IDLE_INTERVAL, [this] { return sampleStop || sampleWake; });
+        sampleIdle.store(false, std::memory_order_relaxed);
+        sampleWake = false;
+    }
+}
+
+void CPUMonitor::WakeupSampler()
+{
+    if (likely(!sampleIdle.load(std::memory_order_relaxed))) {
+        return;
+    }
+    std::lock_guard lg(sampleMutex);
+    sampleWake = true;
+    sampleCond.notify_one();
 }
 
 uint32_t CPUMonitor::GetMonitorTid() const
 {
-    return monitorTid;
+    return monitorTid.load(std::memory_order_relaxed);
 }
 
 void CPUMonitor::IncSleepingRef(const QoS& qos)
@@ -167,31 +152,18 @@ void CPUMonitor::DecExeNumRef(const QoS& qos)
     workerCtrl.lock.unlock();
 }
 
-size_t CPUMonitor::CountBlockedNum(const QoS& qos)
-{
-    struct wgcm_workergrp_data grp = {0};
-    grp.gid = static_cast<uint32_t>(qos);
-    grp.server_tid = monitorTid;
-    int ret = prctl(PR_WGCM_CTL, WGCM_CTL_GET, &grp, 0, 0);
-    if (ret) {
-        FFRT_LOGE("failed to get wgcm count");
-    } else {
-        return static_cast<size_t>(grp.blk_workers_sum);
-    }
-    return 0;
-}
-
-void CPUMonitor::Notify(const QoS& qos, TaskNotifyType notifyType)
+void CPUMonitor::Notify(const QoS& qos, TaskNotifyType notifyType, int num)
 {
     int taskCount = ops.GetTaskCount(qos);
     FFRT_LOGI("qos[%d] task notify op[%d] cnt[%ld]", (int)qos, (int)notifyType, taskCount);
     switch (notifyType) {
         case TaskNotifyType::TASK_ADDED:
             if (taskCount > 0) {
-                Poke(qos);
+                Poke(qos, std::min(num, taskCount));
             }
             break;
         case TaskNotifyType::TASK_PICKED:
+            WakeupSampler();
             if (taskCount > 0) {
                 Poke(qos);
             }
@@ -227,19 +199,65 @@ void CPUMonitor::IntoSleep(const QoS& qos)
     workerCtrl.lock.unlock();
 }
 
-void CPUMonitor::Poke(const QoS& qos)
+// an executing worker retires when the qos runs more workers than its concurrency once blocked ones are left out
+bool CPUMonitor::TryRetire(const QoS& qos)
 {
     WorkerCtrl& workerCtrl = ctrlQueue[static_cast<int>(qos)];
     workerCtrl.lock.lock();
-    FFRT_LOGI("qos[%d] exe num[%d] slp num[%d]", (int)qos, workerCtrl.executionNum, workerCtrl.sleepingWorkerNum);
-    if (static_cast<uint32_t>(workerCtrl.executionNum) < workerCtrl.maxConcurrency) {
-        if (workerCtrl.sleepingWorkerNum == 0) {
-            workerCtrl.executionNum++;
-            workerCtrl.lock.unlock();
+    int workerNum = workerCtrl.executionNum + workerCtrl.sleepingWorkerNum - workerCtrl.blockedNum;
+    bool retire = workerNum > static_cast<int>(workerCtrl.maxConcurrency);
+    if (retire) {
+        workerCtrl.executionNum--;
+    }
+    int surplus = workerCtrl.surplusNum.load(std::memory_order_relaxed);
+    workerCtrl.surplusNum.store(retire && surplus > 0 ? surplus - 1 : 0, std::memory_order_relaxed);
+    workerCtrl.lock.unlock();
+    return retire;
+}
+
+bool CPUMonitor::IntoSpin(const QoS& qos, int limit)
+{
+    WorkerCtrl& workerCtrl = ctrlQueue[static_cast<int>(qos)];
+    workerCtrl.lock.lock();
+    bool spin = workerCtrl.spinningWorkerNum < limit;
+    if (spin) {
+        workerCtrl.spinningWorkerNum++;
+    }
+    workerCtrl.lock.unlock();
+    return spin;
+}
+
+void CPUMonitor::OutOfSpin(const QoS& qos)
+{
+    WorkerCtrl& workerCtrl = ctrlQueue[static_cast<int>(qos)];
+    workerCtrl.lock.lock();
+    workerCtrl.spinningWorkerNum--;
+    workerCtrl.lock.unlock();
+}
+
+void CPUMonitor::Poke(const QoS& qos, int num)
+{
+    WorkerCtrl& workerCtrl = ctrlQueue[static_cast<int>(qos)];
+    workerCtrl.lock.lock();
+    FFRT_LOGI("qos[%d] exe num[%d] slp num[%d] spin num[%d]", (int)qos, workerCtrl.executionNum,
+        workerCtrl.sleepingWorkerNum, workerCtrl.spinningWorkerNum);
+    // spinning workers pick the new tasks up themselves, the one that finds a task pokes again if more are left
+    num -= workerCtrl.spinningWorkerNum;
+    int limit = std::min(static_cast<int>(workerCtrl.maxConcurrency) + workerCtrl.blockedNum,
+        static_cast<int>(workerCtrl.hardLimit));
+    if (num > 0 && workerCtrl.executionNum < limit) {
+        // sleeping workers are woken first, new workers are only created for the rest
+        int idle = limit - workerCtrl.executionNum;
+        int wakeNum = std::min(num, idle);
+        int sleepNum = std::min(wakeNum, workerCtrl.sleepingWorkerNum);
+        int incNum = wakeNum - sleepNum;
+        workerCtrl.executionNum += incNum;
+        workerCtrl.lock.unlock();
+        if (sleepNum > 0) {
+            ops.WakeupWorkers(qos, sleepNum);
+        }
+        for (int i = 0; i < incNum; i++) {
             ops.IncWorker(qos);
-        } else {
-            workerCtrl.lock.unlock();
-            ops.WakeupWorkers(qos);
         }
     } else {
         workerCtrl.lock.unlock();
@@ -17,20 +17,29 @@
 #define CPU_MONITOR_H
 
 #include <atomic>
+#include <chrono>
 #include <vector>
 #include <functional>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
 #include "sched/qos.h"
 #include "cpp/mutex.h"
 #include "eu/cpu_manager_interface.h"
 
 namespace ffrt {
+constexpr std::chrono::milliseconds MONITOR_SAMPLE_INTERVAL(10);
+constexpr std::chrono::seconds MONITOR_IDLE_INTERVAL(1);
+
 struct WorkerCtrl {
     size_t hardLimit = 0;
     size_t maxConcurrency = 0;
     size_t workerManagerID = 0;
     int executionNum = 0;
     int sleepingWorkerNum = 0;
+    int spinningWorkerNum = 0;
+    int blockedNum = 0; // executing workers found blocked in the kernel by the last sample
+    std::atomic<int> surplusNum {0}; // executing workers beyond the concurrency once the blocked ones came back
     std::mutex lock;
 };
 
@@ -46,23 +55,36 @@ public:
     void IncSleepingRef(const QoS& qos);
     void DecSleepingRef(const QoS& qos);
     void IntoSleep(const QoS& qos);
+    bool IntoSpin(const QoS& qos, int limit);
+    void OutOfSpin(const QoS& qos);
     void WakeupCount(const QoS& qos);
     void TimeoutCount(const QoS& qos);
-    void RegWorker(const QoS& qos);
-    void UnRegWorker();
-    void Notify(const QoS& qos, TaskNotifyType notifyType);
+    void Notify(const QoS& qos, TaskNotifyType notifyType, int num = 1);
+    void StartMonitor();
+    void SampleMain();
+
+    inline bool HasSurplus(const QoS& qos) const
+    {
+        return ctrlQueue[static_cast<int>(qos)].surplusNum.load(std::memory_order_relaxed) > 0;
+    }
 
-    uint32_t monitorTid = 0;
+    bool TryRetire(const QoS& qos);
 
 private:
-    size_t CountBlockedNum(const QoS& qos);
     void SetupMonitor();
-    void StartMonitor();
-    void Poke(const QoS& qos);
+    void Poke(const QoS& qos, int num = 1);
+    void WakeupSampler();
 
     std::thread* monitorThread;
+    std::atomic<uint32_t> monitorTid {0}; // set by the sampler thread once it runs
     CpuMonitorOps ops;
     WorkerCtrl ctrlQueue[QoS::Max()];
+
+    std::mutex sampleMutex;
+    std::condition_variable sampleCond;
+    std::atomic_bool sampleIdle {false};
+    bool sampleWake = false;
+    bool sampleStop = false;
 };
 }
 #endif /* CPU_MONITOR_H */
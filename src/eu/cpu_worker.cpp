@@ -17,6 +17,7 @@
 #include "eu/worker_thread.h"
 #include "dfx/trace/ffrt_trace.h"
 #include "sched/scheduler.h"
+#include "sched/sched_deadline.h"
 #include "eu/cpu_manager_interface.h"
 #include "dfx/bbox/bbox.h"
 
@@ -25,18 +26,34 @@ void CPUWorker::Run(TaskCtx* task)
 {
     FFRT_TRACE_SCOPE(TRACE_LEVEL2, Run);
 #ifdef EU_COROUTINE
-    CoStart(task);
-#else
+    // a cancelled task that has not started is skipped on the worker stack, without binding a coroutine
+    if (likely(!task->stackless) && (task->coRoutine != nullptr || likely(!task->Cancelled()))) {
+        CoStart(task);
+        return;
+    }
+#endif
+    // runs on the worker stack, no coroutine to bind, switch to or check
+#ifdef FFRT_BBOX_ENABLE
+    TaskRunCounterInc();
+#endif
+    TaskLoadTracking::Begin(task);
+    FFRT_TASK_BEGIN(task->GetLabel(), task->gid);
     auto f = reinterpret_cast<ffrt_function_header_t*>(task->func_storage);
     auto exp = ffrt::SkipStatus::SUBMITTED;
-    if (likely(__atomic_compare_exchange_n(&task->skipped, &exp, ffrt::SkipStatus::EXECUTED, 0, __ATOMIC_ACQUIRE,
-        __ATOMIC_RELAXED))) {
+    if (likely(!task->Cancelled()) && likely(__atomic_compare_exchange_n(&task->skipped, &exp,
+        ffrt::SkipStatus::EXECUTED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))) {
         f->exec(f);
     }
     f->destroy(f);
+    FFRT_TASK_END();
+    TaskLoadTracking::End(task);
+    FFRTScheduler::Instance()->CheckDeadline(task);
+#ifdef FFRT_BBOX_ENABLE
+    TaskFinishCounterInc();
+#endif
 
+    FFRT_TASKDONE_MARKER(task->gid);
     task->UpdateState(ffrt::TaskState::EXITED);
-#endif
 }
 
 void CPUWorker::Dispatch(CPUWorker* worker)
@@ -73,7 +90,9 @@ void CPUWorker::Dispatch(CPUWorker* worker)
         lastTask = task;
         ctx->task = task;
         worker->curTask = task;
+        worker->Heartbeat();
         Run(task);
+        worker->Heartbeat();
         BboxCheckAndFreeze();
         worker->curTask = nullptr;
         ctx->task = nullptr;
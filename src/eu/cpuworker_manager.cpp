@@ -15,15 +15,51 @@
 
 #include <climits>
 #include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #include "eu/cpu_monitor.h"
 #include "eu/cpu_manager_interface.h"
 #include "sched/scheduler.h"
 #include "sched/workgroup_internal.h"
 #include "eu/qos_interface.h"
+#include "sync/io_poller.h"
+#include "internal_inc/osal.h"
+#include "util/cpu_topology.h"
 #include "eu/cpuworker_manager.h"
 
 namespace ffrt {
+namespace {
+// a thread that is not runnable sleeps in the kernel, the state is unknown without procfs
+bool ThreadBlocked(pid_t tid)
+{
+    char path[64];
+    if (snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid) < 0) {
+        return true;
+    }
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return true;
+    }
+    char buf[256];
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (len <= 0) {
+        return true;
+    }
+    buf[len] = '\0';
+    // the state follows the parenthesized thread name, which may contain spaces or parentheses itself
+    const char* p = strrchr(buf, ')');
+    return p == nullptr || p[1] == '\0' || p[2] != 'R';
+}
+} // namespace
 
 bool CPUWorkerManager::IncWorker(const QoS& qos)
 {
@@ -43,37 +79,68 @@ bool CPUWorkerManager::IncWorker(const QoS& qos)
         return false;
     }
     worker->WorkerSetup(worker.get(), qos);
+    PinWorker(qos, worker.get());
     WorkerJoinTg(qos, worker->Id());
     groupCtl[qos()].threads[worker.get()] = std::move(worker);
     return true;
 }
 
-void CPUWorkerManager::WakeupWorkers(const QoS& qos)
+void CPUWorkerManager::WakeupWorkers(const QoS& qos, int num)
 {
     if (tearDown) {
         return;
     }
 
+    Unpark(qos, num);
+}
+
+void CPUWorkerManager::Unpark(const QoS& qos, int num)
+{
     auto& ctl = sleepCtl[qos()];
-    ctl.cv.notify_one();
+    // pairs with Park: a worker that loaded seq before this bump is either woken or sees the task when it checks
+    ctl.seq.fetch_add(1, std::memory_order_seq_cst);
+    if (ctl.parkedNum.load(std::memory_order_seq_cst) > 0) {
+        syscall(SYS_futex, &ctl.seq, FUTEX_WAKE_PRIVATE, num, nullptr, nullptr, 0);
+    }
 }
 
 int CPUWorkerManager::GetTaskCount(const QoS& qos)
 {
-    auto& sched = FFRTScheduler::Instance()->GetScheduler(qos);
-    return sched.RQSize();
+    return FFRTScheduler::Instance()->RQSize(qos);
+}
+
+size_t CPUWorkerManager::GetBlockedNum(const QoS& qos)
+{
+    size_t blockedNum = 0;
+    std::unique_lock lock(groupCtl[qos()].tgMutex);
+    for (auto& thread : groupCtl[qos()].threads) {
+        WorkerThread* worker = thread.first;
+        uint64_t epoch = worker->epoch.load(std::memory_order_relaxed);
+        // the same task has been running since the last sample
+        if ((epoch & 1) != 0 && epoch == worker->sampledEpoch && !worker->Exited() && ThreadBlocked(worker->Id())) {
+            blockedNum++;
+        }
+        worker->sampledEpoch = epoch;
+    }
+    return blockedNum;
 }
 
 TaskCtx* CPUWorkerManager::PickUpTask(WorkerThread* thread)
 {
-    if (tearDown) {
+    // a surplus worker turns idle and retires there
+    if (tearDown || unlikely(monitor.HasSurplus(thread->GetQos()))) {
         return nullptr;
     }
 
-    auto& sched = FFRTScheduler::Instance()->GetScheduler(thread->GetQos());
+    if (FFRTScheduler::Instance()->GetPolicy(thread->GetQos()) == SchedPolicy::WORK_STEALING) {
+        auto& sched = FFRTScheduler::Instance()->GetWSScheduler(thread->GetQos());
+        sched.BindWorker();
+        return sched.PickNextTask();
+    }
+
     auto lock = GetSleepCtl(static_cast<int>(thread->GetQos()));
     std::lock_guard lg(*lock);
-    return sched.PickNextTask();
+    return FFRTScheduler::Instance()->PickNextTask(thread->GetQos());
 }
 
 void CPUWorkerManager::NotifyTaskPicked(const WorkerThread* thread)
@@ -85,6 +152,9 @@ void CPUWorkerManager::WorkerRetired(WorkerThread* thread)
 {
     pid_t pid = thread->Id();
     int qos = static_cast<int>(thread->GetQos());
+    if (FFRTScheduler::Instance()->GetPolicy(thread->GetQos()) == SchedPolicy::WORK_STEALING) {
+        FFRTScheduler::Instance()->GetWSScheduler(thread->GetQos()).UnbindWorker();
+    }
     thread->SetExited(true);
     thread->Detach();
 
@@ -106,41 +176,206 @@ WorkerAction CPUWorkerManager::WorkerIdleAction(const WorkerThread* thread)
         return WorkerAction::RETIRE;
     }
 
-    auto& ctl = sleepCtl[thread->GetQos()];
-    std::unique_lock lk(ctl.mutex);
-    monitor.IntoSleep(thread->GetQos());
+    // workers spawned while others were blocked in the kernel leave once those are back
+    if (monitor.TryRetire(thread->GetQos())) {
+        FFRT_LOGI("surplus worker exit");
+        return WorkerAction::RETIRE;
+    }
+
+    // an io readiness event handled here saves the hop through the poller thread
+    if (PollIOInline()) {
+        return WorkerAction::RETRY;
+    }
+
+    const QoS& qos = thread->GetQos();
+    auto begin = std::chrono::steady_clock::now();
+    auto idleTime = [&begin] {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count());
+    };
+
+    // spin when the next task is expected before a park and wakeup would be worth it
+    uint64_t gap = sleepCtl[qos()].idleGap.load(std::memory_order_relaxed);
+    uint64_t budget = gap <= spinMax ? std::min(gap * 2, spinMax) : 0;
+    if (budget >= WORKER_SPIN_MIN_NS && monitor.IntoSpin(qos, spinLimit)) {
+        bool found = SpinForTask(qos, budget);
+        monitor.OutOfSpin(qos);
+        if (found) {
+            UpdateIdleGap(qos, idleTime());
+            return WorkerAction::RETRY;
+        }
+    }
+
+    WorkerAction action = Park(qos);
+    if (action == WorkerAction::RETRY) {
+        UpdateIdleGap(qos, idleTime());
+    }
+    return action;
+}
+
+bool CPUWorkerManager::SpinForTask(const QoS& qos, uint64_t budget)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (;;) {
+        for (int i = 0; i < WORKER_SPIN_BATCH; i++) {
+            if (tearDown || GetTaskCount(qos) > 0) {
+                return true;
+            }
+            sync_detail::spin();
+        }
+        auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count());
+        if (elapsed >= budget) {
+            return false;
+        }
+        // the second half yields, the producer may be waiting for this cpu
+        if (elapsed >= budget / 2) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+WorkerAction CPUWorkerManager::Park(const QoS& qos)
+{
+    auto& ctl = sleepCtl[qos()];
+    monitor.IntoSleep(qos);
+    ctl.parkedNum.fetch_add(1, std::memory_order_seq_cst);
+    uint32_t seq = ctl.seq.load(std::memory_order_seq_cst);
     FFRT_LOGI("worker sleep");
+    bool timeout = false;
+    if (!tearDown && GetTaskCount(qos) == 0) {
 #if defined(IDLE_WORKER_DESTRUCT)
-    if (ctl.cv.wait_for(lk, std::chrono::seconds(5),
-        [this, thread] {return tearDown || GetTaskCount(thread->GetQos());})) {
-        monitor.WakeupCount(thread->GetQos());
-        FFRT_LOGI("worker awake");
-        return WorkerAction::RETRY;
-    } else {
-        monitor.TimeoutCount(thread->GetQos());
+        struct timespec ts = { WORKER_IDLE_TIMEOUT_S, 0 };
+        timeout = syscall(SYS_futex, &ctl.seq, FUTEX_WAIT_PRIVATE, seq, &ts, nullptr, 0) != 0 && errno == ETIMEDOUT;
+#else
+        syscall(SYS_futex, &ctl.seq, FUTEX_WAIT_PRIVATE, seq, nullptr, nullptr, 0);
+#endif
+    }
+    ctl.parkedNum.fetch_sub(1, std::memory_order_relaxed);
+
+    if (timeout && !tearDown && GetTaskCount(qos) == 0) {
+        monitor.TimeoutCount(qos);
         FFRT_LOGI("worker exit");
         return WorkerAction::RETIRE;
     }
-#else /* !IDLE_WORKER_DESTRUCT */
-    ctl.cv.wait(lk, [this, thread] {return tearDown || GetTaskCount(thread->GetQos());});
-    monitor.WakeupCount(thread->GetQos());
+    monitor.WakeupCount(qos);
     FFRT_LOGI("worker awake");
     return WorkerAction::RETRY;
-#endif /* IDLE_WORKER_DESTRUCT */
 }
 
-void CPUWorkerManager::NotifyTaskAdded(enum qos qos)
+void CPUWorkerManager::UpdateIdleGap(const QoS& qos, uint64_t gap)
+{
+    // long parks are clipped so that a burst after a quiet period turns spinning back on within a few tasks
+    gap = std::min(gap, spinMax * 2);
+    auto& avg = sleepCtl[qos()].idleGap;
+    uint64_t old = avg.load(std::memory_order_relaxed);
+    avg.store(old - old / IDLE_GAP_WEIGHT + gap / IDLE_GAP_WEIGHT, std::memory_order_relaxed);
+}
+
+void CPUWorkerManager::NotifyTaskAdded(enum qos qos, int num)
 {
     QoS taskQos(qos);
-    monitor.Notify(taskQos, TaskNotifyType::TASK_ADDED);
+    monitor.Notify(taskQos, TaskNotifyType::TASK_ADDED, num);
 }
 
 CPUWorkerManager::CPUWorkerManager() : monitor({
     std::bind(&CPUWorkerManager::IncWorker, this, std::placeholders::_1),
-    std::bind(&CPUWorkerManager::WakeupWorkers, this, std::placeholders::_1),
-    std::bind(&CPUWorkerManager::GetTaskCount, this, std::placeholders::_1)})
+    std::bind(&CPUWorkerManager::WakeupWorkers, this, std::placeholders::_1, std::placeholders::_2),
+    std::bind(&CPUWorkerManager::GetTaskCount, this, std::placeholders::_1),
+    std::bind(&CPUWorkerManager::GetBlockedNum, this, std::placeholders::_1)})
 {
     groupCtl[qos_deadline_request].tg = std::unique_ptr<ThreadGroup>(new ThreadGroup());
+    InitSpin();
+    InitPin();
+    monitor.StartMonitor();
+}
+
+/*
+ * FFRT_WORKER_SPIN_US bounds the time an idle worker spins before it parks, 0 disables spinning.
+ * FFRT_WORKER_SPIN_NUM caps the spinning workers per qos. A single cpu never spins by default,
+ * the spinner would only delay the thread that produces its next task.
+ */
+void CPUWorkerManager::InitSpin()
+{
+    unsigned int cpus = std::thread::hardware_concurrency();
+    uint64_t spinUs = cpus > 1 ? WORKER_SPIN_US : 0;
+    spinLimit = static_cast<int>(std::max(1U, cpus / 4));
+
+    std::string env = GetEnv("FFRT_WORKER_SPIN_US");
+    if (!env.empty()) {
+        spinUs = strtoull(env.c_str(), nullptr, 10);
+    }
+    env = GetEnv("FFRT_WORKER_SPIN_NUM");
+    if (!env.empty()) {
+        int n = atoi(env.c_str());
+        if (n > 0) {
+            spinLimit = n;
+        } else {
+            FFRT_LOGW("invalid worker spin num[%s]", env.c_str());
+        }
+    }
+
+    spinMax = spinUs * 1000;
+    for (auto& ctl : sleepCtl) {
+        ctl.idleGap.store(spinMax / 2, std::memory_order_relaxed);
+    }
+}
+
+/*
+ * FFRT_WORKER_PIN is llc, node or none. Workers are pinned to llc groups by default once the machine has
+ * more than one, tasks readied on a worker then stay in its cache and numa node unless another group steals them.
+ */
+void CPUWorkerManager::InitPin()
+{
+    pin = CpuTopology::Instance().LlcNum() > 1 ? WorkerPin::LLC : WorkerPin::NONE;
+    std::string env = GetEnv("FFRT_WORKER_PIN");
+    if (env == "llc") {
+        pin = WorkerPin::LLC;
+    } else if (env == "node") {
+        pin = WorkerPin::NODE;
+    } else if (env == "none") {
+        pin = WorkerPin::NONE;
+    } else if (!env.empty()) {
+        FFRT_LOGW("invalid worker pin[%s]", env.c_str());
+    }
+}
+
+void CPUWorkerManager::PinWorker(const QoS& qos, WorkerThread* thread)
+{
+    // an affinity from the qos policy wins
+    if (pin == WorkerPin::NONE || getFuncAffinity() != nullptr) {
+        return;
+    }
+
+    auto& topology = CpuTopology::Instance();
+    int domainNum = pin == WorkerPin::LLC ? topology.LlcNum() : topology.NodeNum();
+    std::vector<int> workerNum(domainNum, 0);
+    for (auto& t : groupCtl[qos()].threads) {
+        if (t.first->domain >= 0 && t.first->domain < domainNum) {
+            workerNum[t.first->domain]++;
+        }
+    }
+    // qos levels start at different groups, their first workers do not pile up on group 0
+    int domain = qos() % domainNum;
+    for (int i = 0; i < domainNum; i++) {
+        int d = (qos() + i) % domainNum;
+        if (workerNum[d] < workerNum[domain]) {
+            domain = d;
+        }
+    }
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int cpu : pin == WorkerPin::LLC ? topology.LlcCpus(domain) : topology.NodeCpus(domain)) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &mask);
+        }
+    }
+    if (sched_setaffinity(thread->Id(), sizeof(mask), &mask) != 0) {
+        FFRT_LOGW("pin worker %d to cpu group %d failed, errno %d", thread->Id(), domain, errno);
+        return;
+    }
+    thread->domain = domain;
 }
 
 void CPUWorkerManager::WorkerJoinTg(const QoS& qos, pid_t pid)
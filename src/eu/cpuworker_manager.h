@@ -16,6 +16,7 @@
 #ifndef FFRT_CPUWORKER_MANAGER_HPP
 #define FFRT_CPUWORKER_MANAGER_HPP
 
+#include <climits>
 #include "eu/worker_manager.h"
 #include "eu/cpu_worker.h"
 #include "eu/cpu_monitor.h"
@@ -24,10 +25,24 @@
 
 namespace ffrt {
 constexpr int MANAGER_DESTRUCT_TIMESOUT = 1000000;
+constexpr uint64_t WORKER_SPIN_US = 50; // default upper bound of the idle spin
+constexpr uint64_t WORKER_SPIN_MIN_NS = 1000; // shorter learned budgets park right away
+constexpr int WORKER_SPIN_BATCH = 64; // queue polls between two clock reads
+constexpr uint64_t IDLE_GAP_WEIGHT = 8; // a new idle gap weighs 1/8 in the moving average
+constexpr long WORKER_IDLE_TIMEOUT_S = 5;
+
+// cpu group a new worker is pinned to, the least populated one of the qos
+enum class WorkerPin {
+    NONE,
+    LLC,
+    NODE,
+};
 
 struct WorkerSleepCtl {
-    std::mutex mutex;
-    std::condition_variable cv;
+    std::mutex mutex; // also guards the fifo and edf ready queues of the qos
+    std::atomic<uint32_t> seq {0}; // futex word of parked workers, bumped by every wakeup
+    std::atomic<int> parkedNum {0};
+    std::atomic<uint64_t> idleGap {0}; // moving average of the time idle workers waited for a task, in ns
 };
 
 class CPUWorkerManager : public WorkerManager {
@@ -40,7 +55,7 @@ public:
         for (auto qos = QoS::Min(); qos < QoS::Max(); ++qos) {
             int try_cnt = MANAGER_DESTRUCT_TIMESOUT;
             while (try_cnt--) {
-                sleepCtl[qos].cv.notify_all();
+                Unpark(qos, INT_MAX);
                 {
                     usleep(1);
                     std::unique_lock lock(groupCtl[qos].tgMutex);
@@ -56,7 +71,7 @@ public:
         }
     }
 
-    void NotifyTaskAdded(enum qos qos) override;
+    void NotifyTaskAdded(enum qos qos, int num) override;
 
     std::mutex* GetSleepCtl(int qos) override
     {
@@ -68,18 +83,29 @@ private:
     bool IncWorker(const QoS& qos) override;
     bool DecWorker() override
     {return false;}
-    void WakeupWorkers(const QoS& qos);
+    void WakeupWorkers(const QoS& qos, int num);
+    void Unpark(const QoS& qos, int num);
     int GetTaskCount(const QoS& qos);
+    size_t GetBlockedNum(const QoS& qos);
     void WorkerRetired(WorkerThread* thread);
     TaskCtx* PickUpTask(WorkerThread* thread);
     void NotifyTaskPicked(const WorkerThread* thread);
     WorkerAction WorkerIdleAction(const WorkerThread* thread);
+    bool SpinForTask(const QoS& qos, uint64_t budget);
+    WorkerAction Park(const QoS& qos);
+    void UpdateIdleGap(const QoS& qos, uint64_t gap);
     void WorkerJoinTg(const QoS& qos, pid_t pid);
     void WorkerLeaveTg(const QoS& qos, pid_t pid);
     void WorkerSetup(WorkerThread* thread, const QoS& qos);
+    void InitSpin();
+    void InitPin();
+    void PinWorker(const QoS& qos, WorkerThread* thread);
 
     CPUMonitor monitor;
     WorkerSleepCtl sleepCtl[QoS::Max()];
+    uint64_t spinMax = 0; // ns, 0 disables spinning
+    int spinLimit = 0; // spinning workers allowed per qos
+    WorkerPin pin = WorkerPin::NONE;
     bool tearDown = false;
 };
 } // namespace ffrt
@@ -35,10 +35,10 @@ public:
     void UnbindTG(const DevType dev, QoS& qos);
     void BindWG(const DevType dev, QoS& qos);
 
-    void NotifyTaskAdded(enum qos qos)
+    void NotifyTaskAdded(enum qos qos, int num = 1)
     {
         {
-            wManager[static_cast<size_t>(DevType::CPU)]->NotifyTaskAdded(qos);
+            wManager[static_cast<size_t>(DevType::CPU)]->NotifyTaskAdded(qos, num);
         }
     }
 
@@ -26,6 +26,9 @@ namespace ffrt {
 class WorkerThread {
 public:
     TaskCtx* curTask = nullptr;
+    std::atomic<uint64_t> epoch {0}; // odd while a task runs, only the worker itself writes it
+    uint64_t sampledEpoch = 0; // epoch seen by the last blocked worker sample
+    int domain = -1; // llc group or numa node the worker is pinned to, -1 when not pinned
     explicit WorkerThread(const QoS& qos) : exited(false), idle(false), tid(-1), qos(qos)
     {
     }
@@ -67,6 +70,12 @@ public:
         return qos;
     }
 
+    // called by the worker around every task run, the monitor finds blocked workers by an epoch that stays odd
+    inline void Heartbeat()
+    {
+        epoch.store(epoch.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
     template <typename F, typename... Args>
     void Start(F&& f, Args&&... args)
     {
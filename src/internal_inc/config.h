@@ -16,13 +16,16 @@
 #ifndef GLOBAL_CONFIG_H
 #define GLOBAL_CONFIG_H
 
+#include <algorithm>
 #include "sched/qos.h"
+#include "util/cpu_topology.h"
 
 namespace ffrt {
 constexpr int DEFAULT_MINCONCURRENCY = 4;
 constexpr int INTERACTIVE_MAXCONCURRENCY = 4;
 constexpr int DEFAULT_MAXCONCURRENCY = 8;
 constexpr int DEFAULT_HARDLIMIT = 16;
+constexpr int HARDLIMIT_PER_CPU = 2;
 
 class GlobalConfig {
 public:
@@ -46,8 +49,8 @@ public:
             qos = qos_user_interactive;
         }
 
-        if ((num <= 0) || (num > DEFAULT_MAXCONCURRENCY)) {
-            num = DEFAULT_MAXCONCURRENCY;
+        if ((num <= 0) || (num > maxConcurrency)) {
+            num = maxConcurrency;
         }
         this->cpu_worker_num[static_cast<int>(qos)] = static_cast<size_t>(num);
     }
@@ -57,6 +60,11 @@ public:
         return this->cpu_worker_num[static_cast<int>(qos)];
     }
 
+    size_t getHardLimit()
+    {
+        return static_cast<size_t>(hardLimit);
+    }
+
     void setQosWorkers(const QoS &qos, int tid)
     {
         this->qos_workers[static_cast<int>(qos())].push_back(tid);
@@ -68,19 +76,25 @@ public:
     }
 
 private:
+    // the defaults are floors, a qos may use every usable cpu and twice as many threads
     GlobalConfig()
     {
+        int cpus = CpuTopology::Instance().CpuNum();
+        maxConcurrency = std::max(DEFAULT_MAXCONCURRENCY, cpus);
+        hardLimit = std::max(DEFAULT_HARDLIMIT, cpus * HARDLIMIT_PER_CPU);
         for (auto qos = QoS::Min(); qos < QoS::Max(); ++qos) {
             if (qos == qos_user_interactive) {
-                this->cpu_worker_num[qos] = INTERACTIVE_MAXCONCURRENCY;
+                this->cpu_worker_num[qos] = static_cast<size_t>(std::max(INTERACTIVE_MAXCONCURRENCY, cpus / 2));
             } else {
-                this->cpu_worker_num[qos] = DEFAULT_MAXCONCURRENCY;
+                this->cpu_worker_num[qos] = static_cast<size_t>(maxConcurrency);
             }
             std::vector<int> worker;
             this->qos_workers.push_back(worker);
         }
     }
 
+    int maxConcurrency = DEFAULT_MAXCONCURRENCY;
+    int hardLimit = DEFAULT_HARDLIMIT;
     size_t cpu_worker_num[QoS::Max()];
     std::vector<std::vector<int>> qos_workers;
 };
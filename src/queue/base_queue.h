@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_BASE_QUEUE_H
+#define FFRT_BASE_QUEUE_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include "internal_inc/non_copyable.h"
+#include "itask.h"
+
+namespace ffrt {
+inline uint64_t QueueNowUs()
+{
+    auto nowUs = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::steady_clock::now());
+    return static_cast<uint64_t>(nowUs.time_since_epoch().count());
+}
+
+// upTime is in us of the steady clock, the dispatcher runs one task and releases it
+class BaseQueue : public NonCopyable {
+public:
+    using Dispatcher = std::function<void(ITask*)>;
+
+    virtual ~BaseQueue() = default;
+
+    virtual int PushTask(ITask* task, uint64_t upTime) = 0;
+    virtual int PushImmediate(ITask* task) = 0;
+    virtual int RemoveTask(ITask* task) = 0;
+    // drops the pending tasks and waits for the running ones
+    virtual void Quit() = 0;
+};
+} // namespace ffrt
+
+#endif // FFRT_BASE_QUEUE_H
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "concurrent_queue.h"
+#include <algorithm>
+#include "dfx/log/ffrt_log_api.h"
+#include "sync/sync.h"
+#include "util/slab.h"
+
+namespace ffrt {
+ConcurrentQueue::~ConcurrentQueue()
+{
+    Quit();
+}
+
+void ConcurrentQueue::Quit()
+{
+    std::unique_lock lock(mutex_);
+    FFRT_LOGD("quit concurrent queue %s enter", name_.c_str());
+    if (isExit_) {
+        return;
+    }
+    isExit_ = true;
+
+    if (timer_ != nullptr && DelayedRemove(timer_)) {
+        SimpleAllocator<WaitUntilEntry>::freeMem(timer_);
+        timer_ = nullptr;
+    }
+
+    for (auto& whenMap : whenMap_) {
+        for (auto it = whenMap.begin(); it != whenMap.end(); it++) {
+            for (auto itList = it->second.begin(); itList != it->second.end(); itList++) {
+                (*itList)->Notify();
+                (*itList)->DecDeleteRef();
+            }
+        }
+        whenMap.clear();
+    }
+
+    // running runners finish their current task, a firing timer still uses the queue
+    while (running_ > 0 || timer_ != nullptr) {
+        cond_.wait(lock);
+    }
+    FFRT_LOGD("quit concurrent queue %s leave", name_.c_str());
+}
+
+int ConcurrentQueue::PushTask(ITask* task, uint64_t upTime)
+{
+    std::unique_lock lock(mutex_);
+    FFRT_COND_DO_ERR((task == nullptr), return -1, "failed to push task, task is nullptr");
+    FFRT_COND_DO_ERR(isExit_, return -1, "failed to push task, concurrent queue [%s] is quit", name_.c_str());
+    int prio = std::clamp(static_cast<int>(task->priority_), 0, QUEUE_PRIORITY_NUM - 1);
+    whenMap_[prio][upTime].emplace_back(task);
+    if (running_ >= maxConcurrency_) {
+        // a runner picks the task up when it is done with the current one
+        return 0;
+    }
+
+    uint64_t now = QueueNowUs();
+    if (upTime <= now) {
+        running_++;
+        SubmitRunner();
+    } else {
+        ArmTimerLocked(upTime);
+    }
+    return 0;
+}
+
+int ConcurrentQueue::PushImmediate(ITask* task)
+{
+    return PushTask(task, QueueNowUs());
+}
+
+int ConcurrentQueue::RemoveTask(ITask* task)
+{
+    std::unique_lock lock(mutex_);
+    FFRT_COND_DO_ERR((task == nullptr), return -1, "failed to remove task, task is nullptr");
+    int prio = std::clamp(static_cast<int>(task->priority_), 0, QUEUE_PRIORITY_NUM - 1);
+    auto& whenMap = whenMap_[prio];
+    for (auto it = whenMap.begin(); it != whenMap.end(); it++) {
+        auto itList = std::find(it->second.begin(), it->second.end(), task);
+        if (itList == it->second.end()) {
+            continue;
+        }
+        it->second.erase(itList);
+        if (it->second.empty()) {
+            whenMap.erase(it);
+        }
+        FFRT_LOGD("remove concurrent task [0x%x] succ", task);
+        return 0;
+    }
+    FFRT_LOGD("remove concurrent task [0x%x] failed, task not in ready queue", task);
+    return 1;
+}
+
+// the first due task of the highest priority that has one
+ITask* ConcurrentQueue::PopLocked(uint64_t now)
+{
+    for (auto& whenMap : whenMap_) {
+        auto it = whenMap.begin();
+        if (it == whenMap.end() || it->first > now) {
+            continue;
+        }
+        ITask* task = it->second.front();
+        it->second.pop_front();
+        if (it->second.empty()) {
+            whenMap.erase(it);
+        }
+        return task;
+    }
+    return nullptr;
+}
+
+// fill free slots with runners for due tasks, otherwise wait for the earliest task with the timer
+void ConcurrentQueue::ScheduleLocked(uint64_t now)
+{
+    uint64_t earliest = UINT64_MAX;
+    for (auto& whenMap : whenMap_) {
+        for (auto it = whenMap.begin(); it != whenMap.end() && running_ < maxConcurrency_; it++) {
+            if (it->first > now) {
+                earliest = std::min(earliest, it->first);
+                break;
+            }
+            for (size_t i = 0; i < it->second.size() && running_ < maxConcurrency_; i++) {
+                running_++;
+                SubmitRunner();
+            }
+        }
+    }
+    if (running_ < maxConcurrency_ && earliest != UINT64_MAX) {
+        ArmTimerLocked(earliest);
+    }
+}
+
+// detached, the task pushing a task neither waits for the runner nor cancels it
+void ConcurrentQueue::SubmitRunner()
+{
+    submit([this] { Run(); }, {}, {}, task_attr().name(name_.c_str()).qos(qos_).detached(true));
+}
+
+void ConcurrentQueue::Run()
+{
+    for (int i = 0; i < CONCURRENT_RUN_BATCH; i++) {
+        ITask* task = nullptr;
+        {
+            std::unique_lock lock(mutex_);
+            uint64_t now = QueueNowUs();
+            task = isExit_ ? nullptr : PopLocked(now);
+            if (task == nullptr) {
+                running_--;
+                if (!isExit_) {
+                    ScheduleLocked(now);
+                }
+                // the queue may be released once the lock is dropped
+                cond_.notify_all();
+                return;
+            }
+        }
+        FFRT_LOGD("get next concurrent task [0x%x]", task);
+        dispatch_(task);
+    }
+    // the batch is used up, the slot stays taken by a runner queued behind the tasks submitted meanwhile
+    SubmitRunner();
+}
+
+void ConcurrentQueue::ArmTimerLocked(uint64_t upTime)
+{
+    if (timer_ != nullptr) {
+        if (timerTime_ <= upTime) {
+            return;
+        }
+        // an earlier task moves the timer, a firing one schedules the runners itself
+        if (!DelayedRemove(timer_)) {
+            return;
+        }
+        SimpleAllocator<WaitUntilEntry>::freeMem(timer_);
+        timer_ = nullptr;
+    }
+
+    WaitUntilEntry* we = new (SimpleAllocator<WaitUntilEntry>::allocMem()) WaitUntilEntry();
+    we->cb = [this](WaitEntry* we) { OnTimer(static_cast<WaitUntilEntry*>(we)); };
+    we->tp = std::chrono::steady_clock::time_point(std::chrono::microseconds(upTime));
+    timer_ = we;
+    timerTime_ = upTime;
+    if (!DelayedWakeup(we->tp, we, we->cb)) {
+        // already due
+        timer_ = nullptr;
+        SimpleAllocator<WaitUntilEntry>::freeMem(we);
+        running_++;
+        SubmitRunner();
+    }
+}
+
+void ConcurrentQueue::OnTimer(WaitUntilEntry* we)
+{
+    std::unique_lock lock(mutex_);
+    if (timer_ == we) {
+        timer_ = nullptr;
+    }
+    if (!isExit_) {
+        ScheduleLocked(QueueNowUs());
+    }
+    cond_.notify_all();
+    // the callback lives in the entry, nothing of it is used from here on
+    SimpleAllocator<WaitUntilEntry>::freeMem(we);
+}
+} // namespace ffrt
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_CONCURRENT_QUEUE_H
+#define FFRT_CONCURRENT_QUEUE_H
+
+#include <list>
+#include <map>
+#include <string>
+#include "cpp/condition_variable.h"
+#include "cpp/task.h"
+#include "sched/execute_ctx.h"
+#include "base_queue.h"
+
+namespace ffrt {
+constexpr int CONCURRENT_RUN_BATCH = 32; // tasks a runner runs before it hands the worker back
+constexpr int QUEUE_PRIORITY_NUM = ffrt_queue_priority_idle + 1;
+
+/*
+ * Runs up to maxConcurrency tasks at once without blocking a worker for the rest. Every taken slot is a runner
+ * task of the scheduler that runs due tasks, higher priorities first and in due order within one, until none
+ * is left, then it frees the slot. A timer armed for the earliest delayed task fills free slots once it is due.
+ */
+class ConcurrentQueue : public BaseQueue {
+public:
+    ConcurrentQueue(const std::string& name, enum qos qos, int maxConcurrency, Dispatcher dispatch)
+        : maxConcurrency_(maxConcurrency), name_(name), qos_(qos), dispatch_(std::move(dispatch))
+    {
+    }
+    ~ConcurrentQueue() override;
+
+    int PushTask(ITask* task, uint64_t upTime) override;
+    int PushImmediate(ITask* task) override;
+    int RemoveTask(ITask* task) override;
+    void Quit() override;
+
+private:
+    void Run();
+    void SubmitRunner();
+    ITask* PopLocked(uint64_t now);
+    void ScheduleLocked(uint64_t now);
+    void ArmTimerLocked(uint64_t upTime);
+    void OnTimer(WaitUntilEntry* we);
+
+    ffrt::mutex mutex_;
+    ffrt::condition_variable cond_; // Quit waits here for the runners and the timer
+    bool isExit_ = false;
+    int running_ = 0; // slots taken by queued or running runners
+    const int maxConcurrency_;
+    WaitUntilEntry* timer_ = nullptr; // armed for the earliest delayed task while a slot is free
+    uint64_t timerTime_ = 0;
+    std::string name_;
+    enum qos qos_;
+    Dispatcher dispatch_;
+    std::map<uint64_t, std::list<ITask*>> whenMap_[QUEUE_PRIORITY_NUM]; // indexed by priority
+};
+} // namespace ffrt
+
+#endif // FFRT_CONCURRENT_QUEUE_H
@@ -15,6 +15,7 @@
 #ifndef FFRT_INTERFACE_TASK_H
 #define FFRT_INTERFACE_TASK_H
 
+#include <atomic>
 #include "c/type_def.h"
 #include "util/task_deleter.h"
 
@@ -28,6 +29,9 @@ public:
 
     bool isFinished_ = false;
     IHandler* handler_ = nullptr;
+    ITask* next_ = nullptr; // link in the immediate list of a serial queue
+    std::atomic_bool claimed_ {false}; // taken for running or by cancel, whichever comes first
+    ffrt_queue_priority_t priority_ = ffrt_queue_priority_low; // order within a concurrent queue
     uint8_t func_storage[ffrt_auto_managed_function_storage_size];
 };
 } // namespace ffrt
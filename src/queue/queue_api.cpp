@@ -15,8 +15,8 @@
 
 #include "cpp/queue.h"
 #include "core/dependence_manager.h"
-#include "serial_handler.h"
-#include "serial_task.h"
+#include "queue_handler.h"
+#include "queue_task.h"
 
 using namespace std;
 using namespace ffrt;
@@ -27,20 +27,25 @@ inline void ResetTimeoutCb(ffrt::task_attr_private* p)
     if (p->timeoutCb_ == nullptr) {
         return;
     }
-    GetSerialTaskByFuncStorageOffset(p->timeoutCb_)->DecDeleteRef();
+    GetQueueTaskByFuncStorageOffset(p->timeoutCb_)->DecDeleteRef();
     p->timeoutCb_ = nullptr;
 }
 
-inline SerialTask* ffrt_queue_submit_base(ffrt_queue_t queue, ffrt_function_header_t* f, bool withHandle,
-    uint64_t& delayUs)
+inline QueueTask* ffrt_queue_submit_base(ffrt_queue_t queue, ffrt_function_header_t* f, bool withHandle,
+    const ffrt_task_attr_t* attr)
 {
     FFRT_COND_DO_ERR((queue == nullptr), return nullptr, "input invalid, queue == nullptr");
     FFRT_COND_DO_ERR((f == nullptr), return nullptr, "input invalid, function header == nullptr");
 
-    SerialTask* task = GetSerialTaskByFuncStorageOffset(f);
-    new (task)ffrt::SerialTask();
-    SerialHandler* handler = static_cast<SerialHandler*>(queue);
+    QueueTask* task = GetQueueTaskByFuncStorageOffset(f);
+    new (task)ffrt::QueueTask();
+    QueueHandler* handler = static_cast<QueueHandler*>(queue);
     task->SetQueHandler(handler);
+    uint64_t delayUs = 0;
+    if (attr != nullptr) {
+        delayUs = ffrt_task_attr_get_delay(attr);
+        task->priority_ = ffrt_task_attr_get_queue_priority(attr);
+    }
 
     if (withHandle) {
         task->IncDeleteRef();
@@ -108,9 +113,9 @@ void ffrt_queue_attr_set_timeoutCb(ffrt_queue_attr_t* attr, ffrt_function_header
     ffrt::task_attr_private* p = reinterpret_cast<ffrt::task_attr_private*>(attr);
     ResetTimeoutCb(p);
     p->timeoutCb_ = f;
-    // the memory of timeoutCb are managed in the form of SerialTask
-    SerialTask* task = GetSerialTaskByFuncStorageOffset(f);
-    new (task)ffrt::SerialTask();
+    // the memory of timeoutCb are managed in the form of QueueTask
+    QueueTask* task = GetQueueTaskByFuncStorageOffset(f);
+    new (task)ffrt::QueueTask();
 }
 
 API_ATTRIBUTE((visibility("default")))
@@ -121,19 +126,37 @@ ffrt_function_header_t* ffrt_queue_attr_get_timeoutCb(const ffrt_queue_attr_t* a
     return (reinterpret_cast<ffrt::task_attr_private*>(p))->timeoutCb_;
 }
 
+API_ATTRIBUTE((visibility("default")))
+void ffrt_queue_attr_set_max_concurrency(ffrt_queue_attr_t* attr, const int max_concurrency)
+{
+    FFRT_COND_DO_ERR((attr == nullptr), return, "input invalid, attr == nullptr");
+    FFRT_COND_DO_ERR((max_concurrency <= 0), return, "input invalid, max_concurrency %d <= 0", max_concurrency);
+    (reinterpret_cast<ffrt::task_attr_private*>(attr))->maxConcurrency_ = max_concurrency;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_queue_attr_get_max_concurrency(const ffrt_queue_attr_t* attr)
+{
+    FFRT_COND_DO_ERR((attr == nullptr), return 0, "input invalid, attr == nullptr");
+    ffrt_queue_attr_t* p = const_cast<ffrt_queue_attr_t*>(attr);
+    return (reinterpret_cast<ffrt::task_attr_private*>(p))->maxConcurrency_;
+}
+
 API_ATTRIBUTE((visibility("default")))
 ffrt_queue_t ffrt_queue_create(ffrt_queue_type_t type, const char* name, const ffrt_queue_attr_t* attr)
 {
-    FFRT_COND_DO_ERR((type != ffrt_queue_serial), return nullptr, "input invalid, type unsupport");
+    FFRT_COND_DO_ERR((type != ffrt_queue_serial && type != ffrt_queue_concurrent), return nullptr,
+        "input invalid, type unsupport");
     FFRT_COND_DO_ERR((attr == nullptr), return nullptr, "input invalid, attr == nullptr");
 
     ffrt::qos qos = static_cast<ffrt::qos>(ffrt_queue_attr_get_qos(attr));
-    shared_ptr<SerialLooper> looper =
-        make_shared<SerialLooper>(name, qos, ffrt_queue_attr_get_timeout(attr), ffrt_queue_attr_get_timeoutCb(attr));
-    FFRT_COND_DO_ERR((looper == nullptr), return nullptr, "failed to construct SerialLooper");
+    int maxConcurrency = ffrt_queue_attr_get_max_concurrency(attr);
+    shared_ptr<QueueLooper> looper = make_shared<QueueLooper>(name, qos, type, maxConcurrency,
+        ffrt_queue_attr_get_timeout(attr), ffrt_queue_attr_get_timeoutCb(attr));
+    FFRT_COND_DO_ERR((looper == nullptr), return nullptr, "failed to construct QueueLooper");
 
-    SerialHandler* handler = new (std::nothrow) SerialHandler(looper);
-    FFRT_COND_DO_ERR((handler == nullptr), return nullptr, "failed to construct SerialHandler");
+    QueueHandler* handler = new (std::nothrow) QueueHandler(looper);
+    FFRT_COND_DO_ERR((handler == nullptr), return nullptr, "failed to construct QueueHandler");
     return static_cast<ffrt_queue_t>(handler);
 }
 
@@ -141,24 +164,22 @@ API_ATTRIBUTE((visibility("default")))
 void ffrt_queue_destroy(ffrt_queue_t queue)
 {
     FFRT_COND_DO_ERR((queue == nullptr), return, "input invalid, queue is nullptr");
-    SerialHandler* handler = static_cast<SerialHandler*>(queue);
+    QueueHandler* handler = static_cast<QueueHandler*>(queue);
     delete handler;
 }
 
 API_ATTRIBUTE((visibility("default")))
 void ffrt_queue_submit(ffrt_queue_t queue, ffrt_function_header_t* f, const ffrt_task_attr_t* attr)
 {
-    uint64_t delayUs = (attr == nullptr) ? 0 : ffrt_task_attr_get_delay(attr);
-    SerialTask* task = ffrt_queue_submit_base(queue, f, false, delayUs);
-    FFRT_COND_DO_ERR((task == nullptr), return, "failed to submit serial task");
+    QueueTask* task = ffrt_queue_submit_base(queue, f, false, attr);
+    FFRT_COND_DO_ERR((task == nullptr), return, "failed to submit queue task");
 }
 
 API_ATTRIBUTE((visibility("default")))
 ffrt_task_handle_t ffrt_queue_submit_h(ffrt_queue_t queue, ffrt_function_header_t* f, const ffrt_task_attr_t* attr)
 {
-    uint64_t delayUs = (attr == nullptr) ? 0 : ffrt_task_attr_get_delay(attr);
-    SerialTask* task = ffrt_queue_submit_base(queue, f, true, delayUs);
-    FFRT_COND_DO_ERR((task == nullptr), return nullptr, "failed to submit serial task");
+    QueueTask* task = ffrt_queue_submit_base(queue, f, true, attr);
+    FFRT_COND_DO_ERR((task == nullptr), return nullptr, "failed to submit queue task");
     return CVT_TASK_TO_HANDLE(task);
 }
 
@@ -166,7 +187,7 @@ API_ATTRIBUTE((visibility("default")))
 void ffrt_queue_wait(ffrt_task_handle_t handle)
 {
     FFRT_COND_DO_ERR((handle == nullptr), return, "input invalid, task_handle is nullptr");
-    SerialTask* task = static_cast<SerialTask*>(CVT_HANDLE_TO_TASK(handle));
+    QueueTask* task = static_cast<QueueTask*>(CVT_HANDLE_TO_TASK(handle));
     task->Wait();
 }
 
@@ -174,7 +195,7 @@ API_ATTRIBUTE((visibility("default")))
 int ffrt_queue_cancel(ffrt_task_handle_t handle)
 {
     FFRT_COND_DO_ERR((handle == nullptr), return -1, "input invalid, queue is nullptr");
-    SerialTask* task = static_cast<SerialTask*>(CVT_HANDLE_TO_TASK(handle));
+    QueueTask* task = static_cast<QueueTask*>(CVT_HANDLE_TO_TASK(handle));
     FFRT_COND_DO_ERR((task->handler_ == nullptr), return -1, "input invalid, queue is nullptr");
     return task->handler_->Cancel(task);
 }
\ No newline at end of file
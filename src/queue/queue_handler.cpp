@@ -12,46 +12,44 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "serial_handler.h"
+#include "queue_handler.h"
 #include "dfx/log/ffrt_log_api.h"
 
 namespace ffrt {
-int SerialHandler::Cancel(ITask* task)
+int QueueHandler::Cancel(ITask* task)
 {
     FFRT_COND_DO_ERR((task == nullptr), return -1, "submit task is nullptr");
     FFRT_COND_DO_ERR((looper_ == nullptr || looper_->queue_ == nullptr), return -1, "queue is nullptr");
     int ret = looper_->queue_->RemoveTask(task);
-    FFRT_LOGI("cancel serial task [0x%x] return [%d]", task, ret);
+    FFRT_LOGI("cancel queue task [0x%x] return [%d]", task, ret);
     if (ret == 0) {
         DestroyTask(task);
     }
     return ret;
 }
 
-void SerialHandler::DispatchTask(ITask* task)
+void QueueHandler::DispatchTask(ITask* task)
 {
     FFRT_COND_DO_ERR((task == nullptr), return, "failed to dispatch, task is nullptr");
     auto f = reinterpret_cast<ffrt_function_header_t*>(task->func_storage);
     f->exec(f);
     f->destroy(f);
     DestroyTask(task);
-    FFRT_LOGI("dispatch serial task [0x%x] succ", task);
+    FFRT_LOGI("dispatch queue task [0x%x] succ", task);
 }
 
-int SerialHandler::SubmitDelayed(ITask* task, uint64_t delayUs)
+int QueueHandler::SubmitDelayed(ITask* task, uint64_t delayUs)
 {
     FFRT_COND_DO_ERR((task == nullptr), return -1, "submit task is nullptr");
     FFRT_COND_DO_ERR((looper_ == nullptr || looper_->queue_ == nullptr), return -1, "queue is nullptr");
-    FFRT_LOGI("submit serial task [0x%x] with delay [%llu us]", task, delayUs);
-    auto nowUs = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::steady_clock::now());
-    uint64_t upTime = static_cast<uint64_t>(nowUs.time_since_epoch().count());
-    if (delayUs > 0) {
-        upTime = upTime + delayUs;
+    FFRT_LOGI("submit queue task [0x%x] with delay [%llu us]", task, delayUs);
+    if (delayUs == 0) {
+        return looper_->queue_->PushImmediate(task);
     }
-    return looper_->queue_->PushTask(task, upTime);
+    return looper_->queue_->PushTask(task, QueueNowUs() + delayUs);
 }
 
-void SerialHandler::DestroyTask(ITask* task)
+void QueueHandler::DestroyTask(ITask* task)
 {
     task->Notify();
     task->DecDeleteRef();
@@ -12,17 +12,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#ifndef FFRT_SERIAL_HANDLER_H
-#define FFRT_SERIAL_HANDLER_H
+#ifndef FFRT_QUEUE_HANDLER_H
+#define FFRT_QUEUE_HANDLER_H
 
 #include "ihandler.h"
-#include "serial_looper.h"
+#include "queue_looper.h"
 
 namespace ffrt {
 class ITask;
-class SerialHandler : public IHandler {
+class QueueHandler : public IHandler {
 public:
-    explicit SerialHandler(const std::shared_ptr<SerialLooper>& looper) : looper_(looper)
+    explicit QueueHandler(const std::shared_ptr<QueueLooper>& looper) : looper_(looper)
     {
     }
 
@@ -32,8 +32,8 @@ public:
 
 private:
     void DestroyTask(ITask* task);
-    const std::shared_ptr<SerialLooper> looper_;
+    const std::shared_ptr<QueueLooper> looper_;
 };
 } // namespace ffrt
 
-#endif // FFRT_SERIAL_HANDLER_H
+#endif // FFRT_QUEUE_HANDLER_H
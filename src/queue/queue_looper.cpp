@@ -12,11 +12,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "serial_looper.h"
+#include "queue_looper.h"
 #include <sstream>
 #include "cpp/task.h"
 #include "dfx/log/ffrt_log_api.h"
+#include "concurrent_queue.h"
 #include "ihandler.h"
+#include "serial_queue.h"
 #include "sync/sync.h"
 #include "util/slab.h"
 
@@ -25,40 +27,40 @@ constexpr uint32_t STRING_SIZE_MAX = 128;
 }
 
 namespace ffrt {
-SerialLooper::SerialLooper(const char* name, enum qos qos, uint64_t timeout, ffrt_function_header_t* timeoutCb)
-    : timeout_(timeout), timeoutCb_(timeoutCb)
+QueueLooper::QueueLooper(const char* name, enum qos qos, ffrt_queue_type_t type, int maxConcurrency,
+    uint64_t timeout, ffrt_function_header_t* timeoutCb)
+    : name_(type == ffrt_queue_concurrent ? "concurrent_queue_" : "serial_queue_"), timeout_(timeout),
+      timeoutCb_(timeoutCb)
 {
     if (name != nullptr && (std::string(name).size() <= STRING_SIZE_MAX)) {
         name_ += name;
     }
 
     if (timeout > 0 && timeoutCb_ != nullptr) {
-        GetSerialTaskByFuncStorageOffset(timeoutCb)->IncDeleteRef();
+        GetQueueTaskByFuncStorageOffset(timeoutCb)->IncDeleteRef();
     }
 
-    queue_ = std::make_shared<SerialQueue>(name_);
-    FFRT_COND_DO_ERR((queue_ == nullptr), return, "failed to construct serial queue");
-    // using nested submission is to submit looper task on worker.
-    // when ffrt::wait() is used in the current thread, the looper task is not in the waiting list.
-    submit([this, qos] { handle = submit_h([this] { Run(); }, {}, {}, task_attr().name(name_.c_str()).qos(qos)); },
-        {}, { &handle });
-    ffrt::wait({&handle});
-    FFRT_COND_DO_ERR((handle == nullptr), return, "failed to construct serial looper");
-    FFRT_LOGI("create serial looper [%s] succ", name_.c_str());
+    // tasks run in drain tasks of the queue, an idle queue keeps no worker or stack
+    auto dispatch = [this](ITask* task) { Dispatch(task); };
+    if (type == ffrt_queue_concurrent) {
+        queue_ = std::make_shared<ConcurrentQueue>(name_, qos, maxConcurrency, dispatch);
+    } else {
+        queue_ = std::make_shared<SerialQueue>(name_, qos, dispatch);
+    }
+    FFRT_COND_DO_ERR((queue_ == nullptr), return, "failed to construct queue");
+    FFRT_LOGI("create queue looper [%s] succ", name_.c_str());
 }
 
-SerialLooper::~SerialLooper()
+QueueLooper::~QueueLooper()
 {
     Quit();
 }
 
-void SerialLooper::Quit()
+void QueueLooper::Quit()
 {
-    FFRT_LOGI("quit serial looper [%s] enter", name_.c_str());
-    isExit_.store(true);
+    FFRT_LOGI("quit queue looper [%s] enter", name_.c_str());
+    // waits for the task being executed to complete
     queue_->Quit();
-    // wait for the task being executed to complete.
-    wait({handle});
 
     if (timeout_ > 0) {
         // wait for all delayedWorker to complete.
@@ -67,31 +69,24 @@ void SerialLooper::Quit()
         }
 
         if (timeoutCb_ != nullptr) {
-            GetSerialTaskByFuncStorageOffset(timeoutCb_)->DecDeleteRef();
+            GetQueueTaskByFuncStorageOffset(timeoutCb_)->DecDeleteRef();
         }
     }
-    FFRT_LOGI("quit serial looper [%s] leave", name_.c_str());
+    FFRT_LOGI("quit queue looper [%s] leave", name_.c_str());
 }
 
-void SerialLooper::Run()
+void QueueLooper::Dispatch(ITask* task)
 {
-    FFRT_LOGI("run serial looper [%s] enter", name_.c_str());
-    while (!isExit_.load()) {
-        ITask* task = queue_->Next();
-        if (task) {
-            FFRT_LOGD("get next serial task [0x%x]", task);
-            SetTimeoutMonitor(task);
-            FFRT_COND_DO_ERR((task->handler_ == nullptr), break, "failed to run task, handler is nullptr");
-            task->handler_->DispatchTask(task);
-        }
-    }
-    FFRT_LOGI("run serial looper [%s] leave", name_.c_str());
+    FFRT_COND_DO_ERR((task->handler_ == nullptr), return, "failed to run task, handler is nullptr");
+    WaitUntilEntry* watchdog = SetTimeoutMonitor(task);
+    task->handler_->DispatchTask(task);
+    RemoveTimeoutMonitor(task, watchdog);
 }
 
-void SerialLooper::SetTimeoutMonitor(ITask* task)
+WaitUntilEntry* QueueLooper::SetTimeoutMonitor(ITask* task)
 {
     if (timeout_ <= 0) {
-        return;
+        return nullptr;
     }
 
     task->IncDeleteRef();
@@ -101,9 +96,14 @@ void SerialLooper::SetTimeoutMonitor(ITask* task)
         if (!task->isFinished_) {
             RunTimeOutCallback(task);
         }
-        delayedCbCnt_.fetch_sub(1);
         task->DecDeleteRef();
-        SimpleAllocator<WaitUntilEntry>::freeMem(static_cast<WaitUntilEntry*>(we));
+        // the closure lives in we, keep what is needed after it is released
+        std::atomic_int& cbCnt = delayedCbCnt_;
+        WaitUntilEntry* wue = static_cast<WaitUntilEntry*>(we);
+        if (wue->status.exchange(we_status::TIMEOUT) == we_status::NOTIFIED) {
+            SimpleAllocator<WaitUntilEntry>::freeMem(wue);
+        }
+        cbCnt.fetch_sub(1);
     });
 
     // set dealyedworker wakeup time
@@ -111,21 +111,42 @@ void SerialLooper::SetTimeoutMonitor(ITask* task)
     auto now = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::steady_clock::now());
     we->tp = std::chrono::time_point_cast<std::chrono::steady_clock::duration>(now + timeout);
 
+    delayedCbCnt_.fetch_add(1);
     if (!DelayedWakeup(we->tp, we, we->cb)) {
+        delayedCbCnt_.fetch_sub(1);
         task->DecDeleteRef();
         SimpleAllocator<WaitUntilEntry>::freeMem(we);
-        FFRT_LOGW("timeout [%llu us] is too short to set watchdog of task [0x%x]", task);
-        return;
+        FFRT_LOGW("timeout [%llu us] is too short to set watchdog of task [0x%x]", timeout_, task);
+        return nullptr;
     }
 
-    delayedCbCnt_.fetch_add(1);
     FFRT_LOGD("set watchdog of task [0x%x] succ", task);
+    return we;
+}
+
+void QueueLooper::RemoveTimeoutMonitor(ITask* task, WaitUntilEntry* we)
+{
+    if (we == nullptr) {
+        return;
+    }
+
+    // the task is done, drop its watchdog unless it is already firing
+    if (DelayedRemove(we)) {
+        delayedCbCnt_.fetch_sub(1);
+        task->DecDeleteRef();
+        SimpleAllocator<WaitUntilEntry>::freeMem(we);
+        return;
+    }
+    // the watchdog callback and the looper race to release the entry, the later one does
+    if (we->status.exchange(we_status::NOTIFIED) == we_status::TIMEOUT) {
+        SimpleAllocator<WaitUntilEntry>::freeMem(we);
+    }
 }
 
-void SerialLooper::RunTimeOutCallback(ITask* task)
+void QueueLooper::RunTimeOutCallback(ITask* task)
 {
     std::stringstream ss;
-    ss << "serial queue [" << name_ << "], serial task [" << std::hex << task << "], execution time exceeds "
+    ss << "queue [" << name_ << "], task [" << std::hex << task << "], execution time exceeds "
        << std::dec << timeout_ << " us";
     std::string msg = ss.str();
     std::string eventName = "SERIAL_TASK_TIMEOUT";
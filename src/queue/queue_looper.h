@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FFRT_QUEUE_LOOPER_H
+#define FFRT_QUEUE_LOOPER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include "c/queue.h"
+#include "cpp/task.h"
+#include "internal_inc/non_copyable.h"
+#include "sched/execute_ctx.h"
+#include "base_queue.h"
+#include "queue_task.h"
+
+namespace ffrt {
+inline QueueTask* GetQueueTaskByFuncStorageOffset(ffrt_function_header_t* f)
+{
+    return reinterpret_cast<QueueTask*>(static_cast<uintptr_t>(static_cast<size_t>(reinterpret_cast<uintptr_t>(f)) -
+        (reinterpret_cast<size_t>(&((reinterpret_cast<QueueTask*>(0))->func_storage)))));
+}
+
+class QueueLooper : public NonCopyable {
+public:
+    // maxConcurrency only applies to concurrent queues
+    QueueLooper(const char* name, enum qos qos, ffrt_queue_type_t type = ffrt_queue_serial, int maxConcurrency = 1,
+        uint64_t timeout = 0, ffrt_function_header_t* timeoutCb = nullptr);
+    ~QueueLooper();
+    void Quit();
+    std::shared_ptr<BaseQueue> queue_;
+
+private:
+    void Dispatch(ITask* task);
+    WaitUntilEntry* SetTimeoutMonitor(ITask* task);
+    void RemoveTimeoutMonitor(ITask* task, WaitUntilEntry* we);
+    void RunTimeOutCallback(ITask* task);
+
+    std::string name_;
+    // for timeout watchdog
+    const uint64_t timeout_;
+    ffrt_function_header_t* timeoutCb_;
+    std::atomic_int delayedCbCnt_ = 0;
+};
+} // namespace ffrt
+
+#endif // FFRT_QUEUE_LOOPER_H
@@ -12,28 +12,28 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "serial_task.h"
+#include "queue_task.h"
 #include "dfx/log/ffrt_log_api.h"
 #include "util/slab.h"
 
 namespace ffrt {
-SerialTask::SerialTask()
+QueueTask::QueueTask()
 {
-    FFRT_LOGD("ctor serial task [0x%x]", this);
+    FFRT_LOGD("ctor queue task [0x%x]", this);
 }
 
-SerialTask::~SerialTask()
+QueueTask::~QueueTask()
 {
-    FFRT_LOGD("dtor serial task [0x%x]", this);
+    FFRT_LOGD("dtor queue task [0x%x]", this);
 }
 
-ITask* SerialTask::SetQueHandler(IHandler* handler)
+ITask* QueueTask::SetQueHandler(IHandler* handler)
 {
     handler_ = handler;
     return this;
 }
 
-void SerialTask::Wait()
+void QueueTask::Wait()
 {
     std::unique_lock lock(mutex_);
     while (!isFinished_) {
@@ -41,15 +41,15 @@ void SerialTask::Wait()
     }
 }
 
-void SerialTask::Notify()
+void QueueTask::Notify()
 {
     std::unique_lock lock(mutex_);
     isFinished_ = true;
     cond_.notify_all();
 }
 
-void SerialTask::freeMem()
+void QueueTask::freeMem()
 {
-    SimpleAllocator<SerialTask>::freeMem(this);
+    SimpleAllocator<QueueTask>::freeMem(this);
 }
 } // namespace ffrt
@@ -12,18 +12,18 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#ifndef FFRT_SERIAL_TASK_H
-#define FFRT_SERIAL_TASK_H
+#ifndef FFRT_QUEUE_TASK_H
+#define FFRT_QUEUE_TASK_H
 
 #include "cpp/condition_variable.h"
 #include "itask.h"
 
 namespace ffrt {
 class IHandler;
-class SerialTask : public ITask {
+class QueueTask : public ITask {
 public:
-    SerialTask();
-    ~SerialTask() override;
+    QueueTask();
+    ~QueueTask() override;
     void Wait() override;
     void Notify() override;
     ITask* SetQueHandler(IHandler* handler) override;
@@ -35,4 +35,4 @@ private:
 };
 } // namespace ffrt
 
-#endif // FFRT_SERIAL_TASK_H
+#endif // FFRT_QUEUE_TASK_H
@@ -14,8 +14,9 @@
  */
 
 #include "serial_queue.h"
-#include <chrono>
 #include "dfx/log/ffrt_log_api.h"
+#include "sync/sync.h"
+#include "util/slab.h"
 
 namespace ffrt {
 SerialQueue::~SerialQueue()
@@ -31,17 +32,34 @@ void SerialQueue::Quit()
         return;
     }
     isExit_ = true;
-    cond_.notify_all();
+
+    if (timer_ != nullptr && DelayedRemove(timer_)) {
+        SimpleAllocator<WaitUntilEntry>::freeMem(timer_);
+        timer_ = nullptr;
+    }
 
     for (auto it = whenMap_.begin(); it != whenMap_.end(); it++) {
         for (auto itList = it->second.begin(); itList != it->second.end(); itList++) {
             if (*itList != nullptr) {
-                (*itList)->Notify();
-                (*itList)->DecDeleteRef();
+                Drop(*itList);
             }
         }
     }
     whenMap_.clear();
+    UpdateDelayedHeadLocked();
+
+    // a running drain or a firing timer still uses the queue, a running drain drops what it finds
+    while (timer_ != nullptr || draining_.exchange(true)) {
+        cond_.wait(lock);
+    }
+
+    // immediate tasks pushed while the queue went down
+    ITask* task = immHead_.exchange(nullptr);
+    while (task != nullptr) {
+        ITask* next = task->next_;
+        Drop(task);
+        task = next;
+    }
     FFRT_LOGD("quit serial queue %s leave", name_.c_str());
 }
 
@@ -49,15 +67,29 @@ int SerialQueue::PushTask(ITask* task, uint64_t upTime)
 {
     std::unique_lock lock(mutex_);
     FFRT_COND_DO_ERR((task == nullptr), return -1, "failed to push task, task is nullptr");
+    FFRT_COND_DO_ERR(isExit_, return -1, "failed to push task, serial queue [%s] is quit", name_.c_str());
     whenMap_[upTime].emplace_back(task);
-    if (upTime == whenMap_.begin()->first) {
-        FFRT_LOGD("serial task [0x%x] notify all", task);
-        cond_.notify_all();
+    UpdateDelayedHeadLocked();
+    // a running drain picks the task up itself
+    if (!draining_ && upTime == whenMap_.begin()->first) {
+        ScheduleLocked(QueueNowUs());
     }
     return 0;
 }
 
-int SerialQueue::RemoveTask(const ITask* task)
+int SerialQueue::PushImmediate(ITask* task)
+{
+    FFRT_COND_DO_ERR((task == nullptr), return -1, "failed to push task, task is nullptr");
+    FFRT_COND_DO_ERR(isExit_, return -1, "failed to push task, serial queue [%s] is quit", name_.c_str());
+    ITask* head = immHead_.load(std::memory_order_relaxed);
+    do {
+        task->next_ = head;
+    } while (!immHead_.compare_exchange_weak(head, task));
+    TrySubmitDrain();
+    return 0;
+}
+
+int SerialQueue::RemoveTask(ITask* task)
 {
     std::unique_lock lock(mutex_);
     FFRT_COND_DO_ERR((task == nullptr), return -1, "failed to remove task, task is nullptr");
@@ -69,8 +101,13 @@ int SerialQueue::RemoveTask(const ITask* task)
                 continue;
             }
             it->second.erase(itList++);
+            if (it->second.empty()) {
+                whenMap_.erase(it);
+            }
+            UpdateDelayedHeadLocked();
+            task->claimed_ = true;
             FFRT_LOGD("remove serial task [0x%x] leave", task);
-            // a task can be submitted only once through the C interface
+            // a task can be submitted only once through the C interface, an armed timer finds nothing due
             return 0;
         }
 
@@ -80,42 +117,186 @@ int SerialQueue::RemoveTask(const ITask* task)
             it++;
         }
     }
+
+    // an immediate task cannot be unlinked, the drain skips it and drops the reference added for it
+    if (!task->claimed_.exchange(true)) {
+        task->IncDeleteRef();
+        FFRT_LOGD("remove serial task [0x%x] leave", task);
+        return 0;
+    }
     FFRT_LOGD("remove serial task [0x%x] failed, task not in ready queue", task);
     return 1;
 }
 
+ITask* SerialQueue::PopLocked(uint64_t now)
+{
+    auto it = whenMap_.begin();
+    if (it == whenMap_.end() || it->first > now) {
+        return nullptr;
+    }
+    ITask* task = it->second.front();
+    it->second.pop_front();
+    if (it->second.empty()) {
+        whenMap_.erase(it);
+    }
+    UpdateDelayedHeadLocked();
+    return task;
+}
+
+void SerialQueue::UpdateDelayedHeadLocked()
+{
+    delayedHead_.store(whenMap_.empty() ? UINT64_MAX : whenMap_.begin()->first, std::memory_order_relaxed);
+}
+
+// start a drain for a due head task, otherwise wait for the head with the timer
+void SerialQueue::ScheduleLocked(uint64_t now)
+{
+    if (whenMap_.empty()) {
+        return;
+    }
+    uint64_t upTime = whenMap_.begin()->first;
+    if (upTime > now) {
+        ArmTimerLocked(upTime);
+        return;
+    }
+    TrySubmitDrain();
+}
+
+// detached, the task pushing the first task neither waits for the drain nor cancels it
+void SerialQueue::SubmitDrain()
+{
+    submit([this] { Drain(); }, {}, {}, task_attr().name(name_.c_str()).qos(qos_).detached(true));
+}
+
+void SerialQueue::TrySubmitDrain()
+{
+    // pairs with the drain giving up draining_ and then looking at the immediate list once more
+    if (!draining_.load() && !draining_.exchange(true)) {
+        SubmitDrain();
+    }
+}
+
+// the taken immediate batch first, then the delayed tasks due by now, then a new batch
 ITask* SerialQueue::Next()
 {
-    std::unique_lock lock(mutex_);
-    while (whenMap_.empty() && !isExit_) {
-        FFRT_LOGD("serial queue [%s] is empty, begin to wait", name_.c_str());
-        cond_.wait(lock);
+    if (batch_ == nullptr) {
+        // the clock is only read between batches and while there are delayed tasks
+        if (delayedHead_.load(std::memory_order_relaxed) != UINT64_MAX) {
+            uint64_t now = QueueNowUs();
+            if (delayedHead_.load(std::memory_order_relaxed) <= now) {
+                std::unique_lock lock(mutex_);
+                ITask* task = PopLocked(now);
+                if (task != nullptr) {
+                    return task;
+                }
+            }
+        }
+
+        // take all immediate tasks at once and put them back in submission order
+        ITask* task = immHead_.exchange(nullptr, std::memory_order_acquire);
+        while (task != nullptr) {
+            ITask* next = task->next_;
+            task->next_ = batch_;
+            batch_ = task;
+            task = next;
+        }
+    }
+    ITask* task = batch_;
+    if (task != nullptr) {
+        batch_ = task->next_;
     }
+    return task;
+}
 
+void SerialQueue::Drain()
+{
+    uint64_t start = QueueNowUs();
+    for (int i = 1; i <= SERIAL_DRAIN_BATCH; i++) {
+        ITask* task = Next();
+        if (task == nullptr) {
+            std::unique_lock lock(mutex_);
+            draining_ = false;
+            if (!isExit_) {
+                // an immediate task pushed while the drain was still marked running was left to it
+                if (immHead_.load() != nullptr) {
+                    TrySubmitDrain();
+                }
+                ScheduleLocked(QueueNowUs());
+            }
+            // the queue may be released once the lock is dropped
+            cond_.notify_all();
+            return;
+        }
+        Run(task);
+        if (i % SERIAL_DRAIN_CLOCK_STRIDE == 0 && QueueNowUs() - start >= SERIAL_DRAIN_BUDGET_US) {
+            break;
+        }
+    }
+    // the budget is used up, the remaining tasks run behind those queued meanwhile
+    SubmitDrain();
+}
+
+void SerialQueue::Run(ITask* task)
+{
     if (isExit_) {
-        FFRT_LOGD("serial queue [%s] is exit", name_.c_str());
-        return nullptr;
+        Drop(task);
+        return;
     }
+    // a cancel that came first left a reference for the queue to drop
+    if (task->claimed_.exchange(true)) {
+        task->DecDeleteRef();
+        return;
+    }
+    FFRT_LOGD("get next serial task [0x%x]", task);
+    dispatch_(task);
+}
 
-    auto nowUs = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::steady_clock::now());
-    uint64_t now = static_cast<uint64_t>(nowUs.time_since_epoch().count());
-    auto it = whenMap_.begin();
-    if (now >= it->first) {
-        if (it->second.empty()) {
-            (void)whenMap_.erase(it);
-            return nullptr;
+void SerialQueue::Drop(ITask* task)
+{
+    if (!task->claimed_.exchange(true)) {
+        task->Notify();
+    }
+    task->DecDeleteRef();
+}
+
+void SerialQueue::ArmTimerLocked(uint64_t upTime)
+{
+    if (timer_ != nullptr) {
+        if (timerTime_ <= upTime) {
+            return;
         }
-        auto nextTask = *it->second.begin();
-        it->second.pop_front();
-        if (it->second.empty()) {
-            (void)whenMap_.erase(it);
+        // an earlier head moves the timer, a firing one schedules the drain itself
+        if (!DelayedRemove(timer_)) {
+            return;
         }
-        return nextTask;
-    } else {
-        uint64_t diff = it->first - now;
-        (void)cond_.wait_for(lock, std::chrono::microseconds(diff));
+        SimpleAllocator<WaitUntilEntry>::freeMem(timer_);
+        timer_ = nullptr;
     }
 
-    return nullptr;
+    WaitUntilEntry* we = new (SimpleAllocator<WaitUntilEntry>::allocMem()) WaitUntilEntry();
+    we->cb = [this](WaitEntry* we) { OnTimer(static_cast<WaitUntilEntry*>(we)); };
+    we->tp = std::chrono::steady_clock::time_point(std::chrono::microseconds(upTime));
+    timer_ = we;
+    timerTime_ = upTime;
+    if (!DelayedWakeup(we->tp, we, we->cb)) {
+        // already due
+        timer_ = nullptr;
+        SimpleAllocator<WaitUntilEntry>::freeMem(we);
+        TrySubmitDrain();
+    }
+}
+
+void SerialQueue::OnTimer(WaitUntilEntry* we)
+{
+    std::unique_lock lock(mutex_);
+    if (timer_ == we) {
+        timer_ = nullptr;
+    }
+    if (!isExit_ && !draining_) {
+        ScheduleLocked(QueueNowUs());
+    }
+    cond_.notify_all();
+    // the callback lives in the entry, nothing of it is used from here on
+    SimpleAllocator<WaitUntilEntry>::freeMem(we);
 }
-} // namespace ffrt
\ No newline at end of file
+} // namespace ffrt
@@ -15,31 +15,68 @@
 #ifndef FFRT_SERIAL_QUEUE_H
 #define FFRT_SERIAL_QUEUE_H
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <string>
 #include "cpp/condition_variable.h"
-#include "internal_inc/non_copyable.h"
-#include "itask.h"
+#include "cpp/task.h"
+#include "sched/execute_ctx.h"
+#include "base_queue.h"
 
 namespace ffrt {
-class SerialQueue : public NonCopyable {
+constexpr int SERIAL_DRAIN_BATCH = 32; // tasks a drain runs before it hands the worker back
+constexpr uint64_t SERIAL_DRAIN_BUDGET_US = 1000; // time a drain runs before it hands the worker back
+constexpr int SERIAL_DRAIN_CLOCK_STRIDE = 8; // tasks between two checks of the time budget
+
+/*
+ * An idle queue holds no task of the scheduler. A drain task is submitted when the first task becomes due,
+ * either on push or from a timer armed for the earliest delayed task, and runs due tasks in order until the
+ * queue has none left or its budget is used up, then it submits a new drain behind the tasks queued meanwhile.
+ *
+ * Tasks without delay go to a lock-free list the drain takes over as a whole, only delayed tasks are kept
+ * ordered under the lock. Delayed tasks that became due run between two immediate batches.
+ */
+class SerialQueue : public BaseQueue {
 public:
-    explicit SerialQueue(const std::string& name) : name_(name) {}
-    ~SerialQueue();
+    SerialQueue(const std::string& name, enum qos qos, Dispatcher dispatch)
+        : name_(name), qos_(qos), dispatch_(std::move(dispatch))
+    {
+    }
+    ~SerialQueue() override;
 
-    ITask* Next();
-    int PushTask(ITask* task, uint64_t upTime);
-    int RemoveTask(const ITask* task);
-    void Quit();
+    int PushTask(ITask* task, uint64_t upTime) override;
+    int PushImmediate(ITask* task) override;
+    int RemoveTask(ITask* task) override;
+    void Quit() override;
 
 private:
+    void Drain();
+    void SubmitDrain();
+    void TrySubmitDrain();
+    ITask* Next();
+    ITask* PopLocked(uint64_t now);
+    void UpdateDelayedHeadLocked();
+    void Run(ITask* task);
+    void Drop(ITask* task);
+    void ScheduleLocked(uint64_t now);
+    void ArmTimerLocked(uint64_t upTime);
+    void OnTimer(WaitUntilEntry* we);
+
     ffrt::mutex mutex_;
-    ffrt::condition_variable cond_;
-    bool isExit_ = false;
+    ffrt::condition_variable cond_; // Quit waits here for the drain and the timer
+    std::atomic_bool isExit_ {false};
+    std::atomic_bool draining_ {false}; // a drain task is queued or running
+    std::atomic<ITask*> immHead_ {nullptr}; // immediate tasks, newest first
+    ITask* batch_ = nullptr; // immediate tasks taken by the drain, oldest first
+    std::atomic<uint64_t> delayedHead_ {UINT64_MAX}; // uptime of the earliest delayed task
+    WaitUntilEntry* timer_ = nullptr; // armed for the earliest delayed task while no drain is
+    uint64_t timerTime_ = 0;
     std::string name_;
+    enum qos qos_;
+    Dispatcher dispatch_;
     std::map<uint64_t, std::list<ITask*>> whenMap_;
 };
 } // namespace ffrt
 
-#endif // FFRT_SERIAL_QUEUE_H
\ No newline at end of file
+#endif // FFRT_SERIAL_QUEUE_H
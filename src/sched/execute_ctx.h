@@ -38,6 +38,7 @@ const int TIMEOUT = 2;
 } // namespace we_status
 
 struct TaskCtx;
+class mutexPrivate;
 
 struct WaitEntry {
     WaitEntry() : prev(this), next(this), task(nullptr), weType(0) {
@@ -49,6 +50,15 @@ struct WaitEntry {
     WaitEntry* next;
     TaskCtx* task;
     int weType;
+    bool lockGranted = false; // a handoff unlock passed the mutex to this waiter
+
+    // owned by the delayed worker between DelayedWakeup and the callback or DelayedRemove
+    LinkedList timerNode;
+    WaitEntry* armNext = nullptr;
+    const std::function<void(WaitEntry*)>* timerCb = nullptr;
+    uint64_t expireTick = 0;
+    uint32_t timerSlot = 0;
+    bool timerArmed = false;
 };
 
 struct WaitUntilEntry : WaitEntry {
@@ -60,6 +70,8 @@ struct WaitUntilEntry : WaitEntry {
     }
     std::atomic_int32_t status;
     bool hasWaitTime;
+    mutexPrivate* morphMutex = nullptr; // untimed task waits of a condition variable, the mutex to reacquire
+    bool morphed = false; // a notify moved the task onto the wait list of morphMutex
     time_point_t tp;
     std::function<void(WaitEntry*)> cb;
     std::mutex wl;
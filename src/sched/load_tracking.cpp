@@ -15,7 +15,8 @@
 
 #include "sched/load_tracking.h"
 
-#include <unordered_set>
+#include <algorithm>
+#include <vector>
 #include <unordered_map>
 
 #include <unistd.h>
@@ -34,28 +35,27 @@ void UserSpaceLoadRecord::UpdateTaskSwitch(TaskCtx* prev, TaskCtx* next)
         return;
     }
 
-    auto getIntersect = [](const std::unordered_set<Interval*>& thisSet,
-                            const std::unordered_set<Interval*>& otherSet) {
-        std::unordered_set<Interval*> set;
+    auto getIntersect = [](const InlineSet<Interval*, 2>& thisSet, const InlineSet<Interval*, 2>& otherSet) {
+        std::vector<Interval*> set;
         for (auto it : thisSet) {
             if (otherSet.find(it) != otherSet.end()) {
-                set.insert(it);
+                set.push_back(it);
             }
         }
         return set;
     };
 
-    auto updateLt = [](const std::unordered_set<Interval*>& set, const std::unordered_set<Interval*>& intersetSet,
+    auto updateLt = [](const InlineSet<Interval*, 2>& set, const std::vector<Interval*>& intersetSet,
                         TaskSwitchState state) {
         for (auto it : set) {
-            if (intersetSet.find(it) != intersetSet.end()) {
+            if (std::find(intersetSet.begin(), intersetSet.end(), it) != intersetSet.end()) {
                 continue;
             }
             it->UpdateTaskSwitch(state);
         }
     };
 
-    std::unordered_set<Interval*> intersectSet;
+    std::vector<Interval*> intersectSet;
     if (prev && next) {
         intersectSet = getIntersect(prev->relatedIntervals, next->relatedIntervals);
         for (auto it : intersectSet) {
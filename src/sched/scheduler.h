@@ -23,6 +23,7 @@
 #include <atomic>
 #include <array>
 #include "internal_inc/types.h"
+#include "internal_inc/osal.h"
 #include "core/entity.h"
 #include "eu/execute_unit.h"
 #include "sync/sync.h"
@@ -30,6 +31,12 @@
 #include "eu/worker_thread.h"
 
 namespace ffrt {
+enum class SchedPolicy {
+    FIFO,
+    WORK_STEALING,
+    EDF,
+};
+
 class FFRTScheduler {
 public:
     FFRTScheduler(const FFRTScheduler&) = delete;
@@ -45,32 +52,131 @@ public:
         return &sched;
     }
 
-#ifdef QOS_DEPENDENCY
-    void onWait(const std::vector<VersionCtx*>& waitDatas, int64_t deadline)
+    FIFOScheduler& GetScheduler(const QoS& qos)
     {
-        for (auto data : waitDatas) {
-            if (!data->childVersions.empty()) {
-                auto waitVersion = data->childVersions.back();
-                if (waitVersion->status != DataStatus::IDLE) { // 数据已经被生产出来
-                    continue;
-                }
-                FFRT_LOGD("wait task=%p deadline=%ld", waitVersion->myProducer, deadline);
-                updateTask(waitVersion->myProducer, deadline);
-                updateVersion(waitVersion->preVersion, deadline);
+        return fifoQue[static_cast<size_t>(qos)];
+    }
+
+    WSScheduler& GetWSScheduler(const QoS& qos)
+    {
+        return wsQue[static_cast<size_t>(qos)];
+    }
+
+    EDFScheduler& GetEDFScheduler(const QoS& qos)
+    {
+        return edfQue[static_cast<size_t>(qos)];
+    }
+
+    SchedPolicy GetPolicy(const QoS& qos) const
+    {
+        return policy[static_cast<size_t>(qos)];
+    }
+
+    TaskCtx* PickNextTask(const QoS& qos)
+    {
+        switch (GetPolicy(qos)) {
+            case SchedPolicy::WORK_STEALING:
+                return GetWSScheduler(qos).PickNextTask();
+            case SchedPolicy::EDF:
+                return GetEDFScheduler(qos).PickNextTask();
+            default:
+                return GetScheduler(qos).PickNextTask();
+        }
+    }
+
+    int RQSize(const QoS& qos)
+    {
+        switch (GetPolicy(qos)) {
+            case SchedPolicy::WORK_STEALING:
+                return GetWSScheduler(qos).RQSize();
+            case SchedPolicy::EDF:
+                return GetEDFScheduler(qos).RQSize();
+            default:
+                return GetScheduler(qos).RQSize();
+        }
+    }
+
+    // called when a task finishes, counts the tasks that finished after their deadline
+    void CheckDeadline(const TaskCtx* task)
+    {
+        if (likely(task->ddl == INT64_MAX) || DeadlineNow() <= task->ddl) {
+            return;
+        }
+        ddlMissNum[static_cast<size_t>(task->qos())].fetch_add(1, std::memory_order_relaxed);
+        FFRT_LOGD("task[%lu] missed its deadline", task->gid);
+    }
+
+    /*
+     * Lends ddl to a task some waiter depends on, returns false when the task is already as urgent.
+     * A queued task moves up on an edf qos only. Fifo and work stealing queues keep their order and the
+     * qos of the task is left as it is, the deadline it inherited only counts once it is on an edf qos.
+     */
+    bool BoostTask(TaskCtx* task, int64_t ddl)
+    {
+        int64_t cur = task->boostDdl.load(std::memory_order_relaxed);
+        do {
+            if (ddl >= cur) {
+                return false;
             }
+        } while (!task->boostDdl.compare_exchange_weak(cur, ddl, std::memory_order_relaxed));
+        auto level = task->qos();
+        if (level != qos_inherit && GetPolicy(level) == SchedPolicy::EDF) {
+            GetEDFScheduler(level).Boost(task, ddl);
         }
+        FFRT_LOGD("task[%lu] boosted to deadline %ld", task->gid, ddl);
+        return true;
     }
-#endif
 
-    FIFOScheduler& GetScheduler(const QoS& qos)
+    uint64_t GetDeadlineMissNum(const QoS& qos) const
     {
-        return fifoQue[static_cast<size_t>(qos)];
+        return ddlMissNum[static_cast<size_t>(qos)].load(std::memory_order_relaxed);
     }
 
 private:
     FFRTScheduler()
     {
+        InitPolicy();
         TaskState::RegisterOps(TaskState::READY, std::bind(&FFRTScheduler::WakeupTask, this, std::placeholders::_1));
+        TaskState::RegisterBatchOps(TaskState::READY,
+            std::bind(&FFRTScheduler::WakeupTasks, this, std::placeholders::_1));
+    }
+
+    /*
+     * FFRT_SCHED_POLICY=fifo|ws|edf selects the ready queue of every qos,
+     * a comma separated list like "fifo,ws,ws" selects it per qos starting from the lowest one.
+     */
+    void InitPolicy()
+    {
+#ifdef FFRT_WORK_STEALING
+        policy.fill(SchedPolicy::WORK_STEALING);
+#else
+        policy.fill(SchedPolicy::FIFO);
+#endif
+        std::string env = GetEnv("FFRT_SCHED_POLICY");
+        if (env.empty()) {
+            return;
+        }
+
+        std::vector<std::string> names;
+        size_t begin = 0;
+        for (size_t end = env.find(','); end != std::string::npos; end = env.find(',', begin)) {
+            names.emplace_back(env.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        names.emplace_back(env.substr(begin));
+
+        for (size_t i = 0; i < policy.size(); i++) {
+            const std::string& name = names.size() == 1 ? names[0] : (i < names.size() ? names[i] : "");
+            if (name == "fifo") {
+                policy[i] = SchedPolicy::FIFO;
+            } else if (name == "ws") {
+                policy[i] = SchedPolicy::WORK_STEALING;
+            } else if (name == "edf") {
+                policy[i] = SchedPolicy::EDF;
+            } else if (!name.empty()) {
+                FFRT_LOGW("unknown sched policy[%s] for qos[%zu]", name.c_str(), i);
+            }
+        }
     }
 
     bool WakeupTask(TaskCtx* task)
@@ -82,58 +188,65 @@ private:
                 return false;
             }
         }
-        auto lock = ExecuteUnit::Instance().GetSleepCtl(level);
-        lock->lock();
-        fifoQue[static_cast<size_t>(level)].WakeupTask(task);
-        lock->unlock();
+        auto p = policy[static_cast<size_t>(level)];
+        if (p == SchedPolicy::WORK_STEALING) {
+            wsQue[static_cast<size_t>(level)].WakeupTask(task);
+        } else {
+            auto lock = ExecuteUnit::Instance().GetSleepCtl(level);
+            lock->lock();
+            if (p == SchedPolicy::EDF) {
+                edfQue[static_cast<size_t>(level)].WakeupTask(task);
+            } else {
+                fifoQue[static_cast<size_t>(level)].WakeupTask(task);
+            }
+            lock->unlock();
+        }
         FFRT_LOGI("qos[%d] task[%lu] entered q", level, task->gid);
         ExecuteUnit::Instance().NotifyTaskAdded(level);
         return true;
     }
 
-    std::array<FIFOScheduler, QoS::Max()> fifoQue;
-
-#ifdef QOS_DEPENDENCY
-    void resetDeadline(TaskCtx* task, int64_t deadline)
-    {
-        auto it = std::find_if(readyTasks.begin(), readyTasks.end(), [task](auto& p) { return p.second == task; });
-        if (it == readyTasks.end()) {
-            return;
-        }
-        auto node = readyTasks.extract(it);
-        task->qos.deadline.relative += deadline - task->qos.deadline.absolute;
-        task->qos.deadline.absolute = deadline;
-        readyTasks.insert(std::move(node));
-    }
-    void updateTask(TaskCtx* task, int64_t deadline)
-    {
-        if (task == nullptr) {
-            return;
-        }
-        resetDeadline(task, deadline);
-        onWait(task->ins, deadline);
-        for (auto data : task->outs) {
-            updateVersion(data, deadline);
-        }
-        updateChildTask(task, deadline);
-    }
-    void updateChildTask(TaskCtx* task, int64_t deadline)
+    // tasks are enqueued per run of the same qos, one sized wakeup is issued for every run
+    bool WakeupTasks(const std::vector<TaskCtx*>& tasks)
     {
-        (void)task;
-        (void)deadline;
-    }
-    void updateVersion(VersionCtx* data, int64_t deadline)
-    {
-        if (data == nullptr) {
-            return;
-        }
-        updateTask(data->myProducer, deadline);
-        for (auto task : data->consumers) {
-            updateTask(task, deadline);
+        size_t begin = 0;
+        while (begin < tasks.size()) {
+            auto level = tasks[begin]->qos();
+            size_t end = begin + 1;
+            while (end < tasks.size() && tasks[end]->qos() == level) {
+                end++;
+            }
+            if (level == qos_inherit) {
+                begin = end;
+                continue;
+            }
+
+            size_t num = end - begin;
+            auto p = policy[static_cast<size_t>(level)];
+            if (p == SchedPolicy::WORK_STEALING) {
+                wsQue[static_cast<size_t>(level)].WakeupTasks(&tasks[begin], num);
+            } else {
+                auto lock = ExecuteUnit::Instance().GetSleepCtl(level);
+                lock->lock();
+                if (p == SchedPolicy::EDF) {
+                    edfQue[static_cast<size_t>(level)].WakeupTasks(&tasks[begin], num);
+                } else {
+                    fifoQue[static_cast<size_t>(level)].WakeupTasks(&tasks[begin], num);
+                }
+                lock->unlock();
+            }
+            FFRT_LOGI("qos[%d] %zu tasks entered q", level, num);
+            ExecuteUnit::Instance().NotifyTaskAdded(level, static_cast<int>(num));
+            begin = end;
         }
-        updateVersion(data->preVersion, deadline);
+        return true;
     }
-#endif
+
+    std::array<FIFOScheduler, QoS::Max()> fifoQue;
+    std::array<WSScheduler, QoS::Max()> wsQue;
+    std::array<EDFScheduler, QoS::Max()> edfQue;
+    std::array<SchedPolicy, QoS::Max()> policy;
+    std::array<std::atomic_uint64_t, QoS::Max()> ddlMissNum {};
 };
 } // namespace ffrt
 #endif
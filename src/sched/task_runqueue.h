@@ -16,6 +16,9 @@
 #ifndef FFRT_TASK_RUNQUEUE_HPP
 #define FFRT_TASK_RUNQUEUE_HPP
 
+#include <atomic>
+#include <vector>
+#include <memory>
 
 #include "core/task_ctx.h"
 
@@ -54,7 +57,7 @@ private:
     {
         auto entry = &task->fq_we;
         list.PushBack(entry->node);
-        size++;
+        size.store(size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     }
 
     TaskCtx* DeQueueImpl()
@@ -66,7 +69,7 @@ private:
         auto entry = list.PopFront()->ContainerOf(&WaitEntry::node);
         TaskCtx* tsk = entry->task;
 
-        size--;
+        size.store(size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
         return tsk;
     }
 
@@ -77,11 +80,194 @@ private:
 
     int SizeImpl()
     {
-        return size;
+        return size.load(std::memory_order_relaxed);
     }
 
     LinkedList list;
-    int size = 0;
+    std::atomic<int> size {0}; // written under the queue lock, idle workers poll it without
+};
+
+/*
+ * Earliest deadline first: tasks are ordered by their effective deadline, tasks without a deadline come last,
+ * ties keep the enqueue order.
+ */
+class EDFQueue : public RunQueue<EDFQueue> {
+    friend class RunQueue<EDFQueue>;
+
+public:
+    // a waiter lent the task an earlier deadline, a queued task moves up
+    void Boost(TaskCtx* task, int64_t ddl)
+    {
+        if (ddl < task->edfKey && heap.Contains(task)) {
+            task->edfKey = ddl;
+            heap.DecreaseKey(task);
+        }
+    }
+
+private:
+    struct DeadlineLess {
+        bool operator()(const TaskCtx* a, const TaskCtx* b) const
+        {
+            return a->edfKey < b->edfKey || (a->edfKey == b->edfKey && a->edfSeq < b->edfSeq);
+        }
+    };
+
+    void EnQueueImpl(TaskCtx* task)
+    {
+        task->edfSeq = seq++;
+        task->edfKey = task->EffectiveDeadline();
+        heap.Push(task);
+        size.store(size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    TaskCtx* DeQueueImpl()
+    {
+        TaskCtx* task = heap.Pop();
+        if (task != nullptr) {
+            size.store(size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    bool EmptyImpl()
+    {
+        return heap.Empty();
+    }
+
+    int SizeImpl()
+    {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    PairingHeap<TaskCtx, &TaskCtx::edfNode, DeadlineLess> heap;
+    uint64_t seq = 0;
+    std::atomic<int> size {0};
+};
+
+/*
+ * Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+ * EnQueue/DeQueue may only be called by the owner worker and work on the bottom end (LIFO),
+ * Steal may be called by any thread and takes from the top end (FIFO).
+ * Buffers replaced on growth are retired instead of freed, a concurrent thief may still read them.
+ */
+class WSDeque : public RunQueue<WSDeque> {
+    friend class RunQueue<WSDeque>;
+
+public:
+    explicit WSDeque(int64_t capacity = DEFAULT_CAPACITY)
+    {
+        auto buf = std::make_unique<Buffer>(capacity);
+        buffer.store(buf.get(), std::memory_order_relaxed);
+        buffers.emplace_back(std::move(buf));
+    }
+
+    TaskCtx* Steal()
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        TaskCtx* task = buffer.load(std::memory_order_acquire)->Get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr; // lost the race against the owner or another thief
+        }
+        return task;
+    }
+
+private:
+    static constexpr int64_t DEFAULT_CAPACITY = 256;
+
+    struct Buffer {
+        explicit Buffer(int64_t cap) : mask(cap - 1), slots(new std::atomic<TaskCtx*>[cap])
+        {
+        }
+
+        int64_t Capacity() const
+        {
+            return mask + 1;
+        }
+
+        TaskCtx* Get(int64_t i) const
+        {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+
+        void Put(int64_t i, TaskCtx* task)
+        {
+            slots[i & mask].store(task, std::memory_order_relaxed);
+        }
+
+        int64_t mask;
+        std::unique_ptr<std::atomic<TaskCtx*>[]> slots;
+    };
+
+    void EnQueueImpl(TaskCtx* task)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        if (b - t > buf->Capacity() - 1) {
+            buf = Grow(buf, t, b);
+        }
+        buf->Put(b, task);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    TaskCtx* DeQueueImpl()
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        TaskCtx* task = buf->Get(b);
+        if (t == b) {
+            // last element, race against thieves
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    bool EmptyImpl()
+    {
+        return SizeImpl() == 0;
+    }
+
+    int SizeImpl()
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<int>(b - t) : 0;
+    }
+
+    Buffer* Grow(Buffer* old, int64_t t, int64_t b)
+    {
+        auto buf = std::make_unique<Buffer>(old->Capacity() << 1);
+        for (int64_t i = t; i < b; i++) {
+            buf->Put(i, old->Get(i));
+        }
+        Buffer* ret = buf.get();
+        buffers.emplace_back(std::move(buf));
+        buffer.store(ret, std::memory_order_release);
+        return ret;
+    }
+
+    alignas(64) std::atomic<int64_t> top {0};
+    alignas(64) std::atomic<int64_t> bottom {0};
+    std::atomic<Buffer*> buffer {nullptr};
+    std::vector<std::unique_ptr<Buffer>> buffers; // owner only
 };
 } // namespace ffrt
 
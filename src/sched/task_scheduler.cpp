@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sched/task_scheduler.h"
+#include "sched/execute_ctx.h"
+#include "dfx/log/ffrt_log_api.h"
+#include "util/cpu_topology.h"
+
+namespace ffrt {
+namespace {
+// 当前Worker线程绑定的本地队列
+struct WSWorkerCtx {
+    WSScheduler* sched = nullptr;
+    WSDeque* que = nullptr;
+    int index = -1;
+    uint32_t tick = 0;
+    uint32_t seed = 0;
+    int llc = 0;
+};
+
+thread_local WSWorkerCtx wsCtx;
+
+inline uint32_t NextRandom(uint32_t& seed)
+{
+    // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+} // namespace
+
+WSScheduler::~WSScheduler()
+{
+    for (auto& que : localQue) {
+        delete que.load(std::memory_order_relaxed);
+        que.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+void WSScheduler::BindWorker()
+{
+    if (wsCtx.sched == this) {
+        return;
+    }
+
+    wsCtx.sched = this;
+    wsCtx.que = nullptr;
+    wsCtx.index = -1;
+    wsCtx.seed = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&wsCtx) >> 4) | 1;
+    for (int i = 0; i < MAX_LOCAL_QUEUE_NUM; i++) {
+        bool expected = false;
+        if (!localQueUsed[i].compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        WSDeque* que = localQue[i].load(std::memory_order_acquire);
+        if (que == nullptr) {
+            que = new (std::nothrow) WSDeque();
+            if (que == nullptr) {
+                localQueUsed[i].store(false, std::memory_order_release);
+                break;
+            }
+            localQue[i].store(que, std::memory_order_release);
+        }
+
+        int num = localQueNum.load(std::memory_order_relaxed);
+        while (num < i + 1 && !localQueNum.compare_exchange_weak(num, i + 1, std::memory_order_release)) {
+        }
+        wsCtx.que = que;
+        wsCtx.index = i;
+        wsCtx.llc = CpuTopology::Instance().CurrentLlc();
+        localQueLlc[i].store(wsCtx.llc, std::memory_order_relaxed);
+        return;
+    }
+    FFRT_LOGW("no local queue available, worker falls back to global queue");
+}
+
+void WSScheduler::UnbindWorker()
+{
+    if (wsCtx.sched != this) {
+        return;
+    }
+
+    if (wsCtx.que != nullptr) {
+        while (TaskCtx* task = wsCtx.que->DeQueue()) {
+            localTaskNum.fetch_sub(1, std::memory_order_relaxed);
+            std::lock_guard lg(globalMutex);
+            globalQue.EnQueue(task);
+            globalTaskNum.fetch_add(1, std::memory_order_release);
+        }
+        localQueUsed[wsCtx.index].store(false, std::memory_order_release);
+    }
+    wsCtx = WSWorkerCtx();
+}
+
+TaskCtx* WSScheduler::PickNextTaskImpl()
+{
+    TaskCtx* task = nullptr;
+    if (wsCtx.sched == this && wsCtx.que != nullptr) {
+        // look at the global queue once in a while, so a busy deque can not starve it
+        if (++wsCtx.tick % GLOBAL_QUEUE_CHECK_INTERVAL == 0) {
+            // an unpinned worker may have moved to another llc group meanwhile
+            wsCtx.llc = CpuTopology::Instance().CurrentLlc();
+            localQueLlc[wsCtx.index].store(wsCtx.llc, std::memory_order_relaxed);
+            task = PickGlobalTask();
+            if (task != nullptr) {
+                return task;
+            }
+        }
+
+        task = wsCtx.que->DeQueue();
+        if (task != nullptr) {
+            localTaskNum.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    task = PickGlobalTask();
+    if (task != nullptr) {
+        return task;
+    }
+    return StealTask();
+}
+
+bool WSScheduler::WakeupTaskImpl(TaskCtx* task)
+{
+    // a task requeued by its own worker (yield) goes to the global queue, otherwise it is popped right again
+    if (wsCtx.sched == this && wsCtx.que != nullptr && task != ExecuteCtx::Cur()->task) {
+        // count first, a thief may take the task before EnQueue returns
+        localTaskNum.fetch_add(1, std::memory_order_release);
+        wsCtx.que->EnQueue(task);
+        return true;
+    }
+
+    std::lock_guard lg(globalMutex);
+    globalQue.EnQueue(task);
+    globalTaskNum.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void WSScheduler::WakeupTasksImpl(TaskCtx* const* tasks, size_t num)
+{
+    // a batch submitted by a worker stays local, siblings steal from it
+    if (wsCtx.sched == this && wsCtx.que != nullptr) {
+        localTaskNum.fetch_add(static_cast<int>(num), std::memory_order_release);
+        for (size_t i = 0; i < num; i++) {
+            wsCtx.que->EnQueue(tasks[i]);
+        }
+        return;
+    }
+
+    std::lock_guard lg(globalMutex);
+    for (size_t i = 0; i < num; i++) {
+        globalQue.EnQueue(tasks[i]);
+    }
+    globalTaskNum.fetch_add(static_cast<int>(num), std::memory_order_release);
+}
+
+TaskCtx* WSScheduler::PickGlobalTask()
+{
+    if (globalTaskNum.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard lg(globalMutex);
+    TaskCtx* task = globalQue.DeQueue();
+    if (task != nullptr) {
+        globalTaskNum.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+// 0 for a deque in the same llc group, 1 for one on the same numa node, 2 for a remote one
+int WSScheduler::StealDistance(int victim) const
+{
+    auto& topology = CpuTopology::Instance();
+    int llc = localQueLlc[victim].load(std::memory_order_relaxed);
+    if (llc == wsCtx.llc) {
+        return 0;
+    }
+    if (llc >= topology.LlcNum() || topology.NodeOfLlc(llc) == topology.NodeOfLlc(wsCtx.llc)) {
+        return 1;
+    }
+    return STEAL_DISTANCE_MAX;
+}
+
+TaskCtx* WSScheduler::StealTask()
+{
+    int num = localQueNum.load(std::memory_order_acquire);
+    if (num == 0 || localTaskNum.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    // nearer deques are scanned completely before farther ones are looked at
+    bool self = wsCtx.sched == this;
+    int maxDistance = self && CpuTopology::Instance().LlcNum() > 1 ? STEAL_DISTANCE_MAX : 0;
+    int start = static_cast<int>(NextRandom(wsCtx.seed) % static_cast<uint32_t>(num));
+    for (int distance = 0; distance <= maxDistance; distance++) {
+        for (int i = 0; i < num; i++) {
+            int victim = (start + i) % num;
+            if (self && victim == wsCtx.index) {
+                continue;
+            }
+            if (maxDistance > 0 && StealDistance(victim) != distance) {
+                continue;
+            }
+
+            WSDeque* que = localQue[victim].load(std::memory_order_acquire);
+            if (que == nullptr) {
+                continue;
+            }
+
+            TaskCtx* task = que->Steal();
+            if (task != nullptr) {
+                localTaskNum.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+} // namespace ffrt
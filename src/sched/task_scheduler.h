@@ -17,6 +17,8 @@
 #define FFRT_TASK_SCHEDULER_HPP
 
 #include <mutex>
+#include <array>
+#include <atomic>
 
 #include "core/entity.h"
 #include "sched/task_runqueue.h"
@@ -34,6 +36,9 @@ public:
 
     TaskCtx* PickNextTask()
     {
+        if constexpr (Sched::SELF_SYNC) {
+            return static_cast<Sched*>(this)->PickNextTaskImpl();
+        }
         std::unique_lock lock(mutex);
         return static_cast<Sched*>(this)->PickNextTaskImpl();
     }
@@ -43,12 +48,32 @@ public:
         bool ret = false;
         {
             FFRT_READY_MARKER(task->gid);
-            std::unique_lock lock(mutex);
-            ret = static_cast<Sched*>(this)->WakeupTaskImpl(task);
+            if constexpr (Sched::SELF_SYNC) {
+                ret = static_cast<Sched*>(this)->WakeupTaskImpl(task);
+            } else {
+                std::unique_lock lock(mutex);
+                ret = static_cast<Sched*>(this)->WakeupTaskImpl(task);
+            }
         }
         return ret;
     }
 
+    // enqueue tasks of the same qos with one lock round trip
+    void WakeupTasks(TaskCtx* const* tasks, size_t num)
+    {
+        for (size_t i = 0; i < num; i++) {
+            FFRT_READY_MARKER(tasks[i]->gid);
+        }
+        if constexpr (Sched::SELF_SYNC) {
+            static_cast<Sched*>(this)->WakeupTasksImpl(tasks, num);
+        } else {
+            std::unique_lock lock(mutex);
+            for (size_t i = 0; i < num; i++) {
+                static_cast<Sched*>(this)->WakeupTaskImpl(tasks[i]);
+            }
+        }
+    }
+
     bool RQEmpty()
     {
         return static_cast<Sched*>(this)->RQEmptyImpl();
@@ -59,8 +84,10 @@ public:
         return static_cast<Sched*>(this)->RQSizeImpl();
     }
 
-private:
+protected:
     fast_mutex mutex;
+
+private:
     semaphore sem;
 };
 
@@ -68,6 +95,8 @@ class FIFOScheduler : public TaskScheduler<FIFOScheduler> {
     friend class TaskScheduler<FIFOScheduler>;
 
 private:
+    static constexpr bool SELF_SYNC = false;
+
     TaskCtx* PickNextTaskImpl()
     {
         TaskCtx* task = que.DeQueue();
@@ -93,6 +122,96 @@ private:
     FIFOQueue que;
 };
 
+class EDFScheduler : public TaskScheduler<EDFScheduler> {
+    friend class TaskScheduler<EDFScheduler>;
+
+public:
+    void Boost(TaskCtx* task, int64_t ddl)
+    {
+        std::unique_lock lock(mutex);
+        que.Boost(task, ddl);
+    }
+
+private:
+    static constexpr bool SELF_SYNC = false;
+
+    TaskCtx* PickNextTaskImpl()
+    {
+        return que.DeQueue();
+    }
+
+    bool WakeupTaskImpl(TaskCtx* task)
+    {
+        que.EnQueue(task);
+        return true;
+    }
+
+    bool RQEmptyImpl()
+    {
+        return que.Empty();
+    }
+
+    int RQSizeImpl()
+    {
+        return que.Size();
+    }
+
+    EDFQueue que;
+};
+
+constexpr int MAX_LOCAL_QUEUE_NUM = 256;
+constexpr uint32_t GLOBAL_QUEUE_CHECK_INTERVAL = 61;
+constexpr int STEAL_DISTANCE_MAX = 2;
+
+/*
+ * Work-stealing scheduler of one QoS level: every worker owns a WSDeque which tasks readied on that worker
+ * are pushed to, tasks readied elsewhere go through a locked global queue. An idle worker pops its own deque,
+ * then the global queue, then steals from the deques of its siblings: those sharing its last level cache first,
+ * then those on its numa node, then the rest.
+ */
+class WSScheduler : public TaskScheduler<WSScheduler> {
+    friend class TaskScheduler<WSScheduler>;
+
+public:
+    ~WSScheduler() override;
+
+    // bind the calling worker thread to a local deque, no-op when already bound
+    void BindWorker();
+    // hand the local deque of the calling worker back, remaining tasks are moved to the global queue
+    void UnbindWorker();
+
+private:
+    static constexpr bool SELF_SYNC = true;
+
+    TaskCtx* PickNextTaskImpl();
+    bool WakeupTaskImpl(TaskCtx* task);
+    void WakeupTasksImpl(TaskCtx* const* tasks, size_t num);
+
+    bool RQEmptyImpl()
+    {
+        return RQSizeImpl() == 0;
+    }
+
+    int RQSizeImpl()
+    {
+        return globalTaskNum.load(std::memory_order_acquire) + localTaskNum.load(std::memory_order_acquire);
+    }
+
+    TaskCtx* PickGlobalTask();
+    TaskCtx* StealTask();
+    int StealDistance(int victim) const;
+
+    fast_mutex globalMutex;
+    FIFOQueue globalQue;
+    std::atomic<int> globalTaskNum {0};
+    std::atomic<int> localTaskNum {0};
+
+    std::array<std::atomic<WSDeque*>, MAX_LOCAL_QUEUE_NUM> localQue {};
+    std::array<std::atomic_bool, MAX_LOCAL_QUEUE_NUM> localQueUsed {};
+    std::array<std::atomic<int>, MAX_LOCAL_QUEUE_NUM> localQueLlc {}; // llc group the owner last ran on
+    std::atomic<int> localQueNum {0};
+};
+
 } // namespace ffrt
 
 #endif
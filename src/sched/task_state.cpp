@@ -14,6 +14,7 @@
  */
 
 #include "sched/task_state.h"
+#include <algorithm>
 #include "core/task_ctx.h"
 #include "sched/task_manager.h"
 #include "dfx/log/ffrt_log_api.h"
@@ -21,32 +22,41 @@
 
 namespace ffrt {
 std::array<TaskState::Op, static_cast<size_t>(TaskState::MAX)> TaskState::ops;
+std::array<TaskState::BatchOp, static_cast<size_t>(TaskState::MAX)> TaskState::batchOps;
 
-int TaskState::OnTransition(State state, TaskCtx* task, Op&& op)
+bool TaskState::Transit(State state, TaskCtx* task)
 {
     if (task == nullptr) {
         FFRT_LOGE("task nullptr");
-        return -1;
+        return false;
     }
     if (task->IsRoot()) {
         FFRT_LOGD("task root no state transition");
-        return 0;
+        return false;
     }
 
     if (task->state == TaskState::EXITED) {
-        FFRT_LOGE("task[%s] have finished", task->label.c_str());
-        return -1;
+        FFRT_LOGE("task[%s] have finished", task->GetLabel().c_str());
+        return false;
     }
 
     task->state.preState = task->state.curState;
     task->state.curState = state;
 
     FFRT_LOGD(
-        "task(%s) status: %s -=> %s ", task->label.c_str(), String(task->state.preState), String(task->state.curState));
+        "task(%s) status: %s -=> %s ", task->GetLabel().c_str(), String(task->state.preState), String(task->state.curState));
 
 #if (TASKSTAT_LOG_ENABLE == 1)
     task->state.stat.Count(task);
 #endif
+    return true;
+}
+
+int TaskState::OnTransition(State state, TaskCtx* task, Op&& op)
+{
+    if (!Transit(state, task)) {
+        return (task != nullptr && task->IsRoot()) ? 0 : -1;
+    }
 
     if (ops[static_cast<size_t>(state)] &&
         !ops[static_cast<size_t>(state)](task)) {
@@ -60,6 +70,29 @@ int TaskState::OnTransition(State state, TaskCtx* task, Op&& op)
     return 0;
 }
 
+int TaskState::OnBatchTransition(State state, std::vector<TaskCtx*>& tasks)
+{
+    auto it = std::remove_if(tasks.begin(), tasks.end(), [state](TaskCtx* task) { return !Transit(state, task); });
+    tasks.erase(it, tasks.end());
+    if (tasks.empty()) {
+        return 0;
+    }
+
+    auto& batchOp = batchOps[static_cast<size_t>(state)];
+    if (batchOp) {
+        return batchOp(tasks) ? 0 : -1;
+    }
+
+    int ret = 0;
+    auto& op = ops[static_cast<size_t>(state)];
+    for (auto task : tasks) {
+        if (op && !op(task)) {
+            ret = -1;
+        }
+    }
+    return ret;
+}
+
 uint64_t TaskState::TaskStateStat::WaitingTime() const
 {
     return CalcDuration(TaskState::READY, TaskState::RUNNING);
@@ -17,6 +17,7 @@
 #define FFRT_TASK_STATE_HPP
 
 #include <array>
+#include <vector>
 #include <string_view>
 #include <functional>
 #include <mutex>
@@ -31,6 +32,7 @@ public:
     enum State { PENDING, READY, RUNNING, BLOCKED, EXITED, MAX };
 
     using Op = typename std::function<bool(TaskCtx*)>;
+    using BatchOp = typename std::function<bool(const std::vector<TaskCtx*>&)>;
 
     TaskState() = default;
 
@@ -93,7 +95,14 @@ public:
         ops[static_cast<size_t>(state)] = op;
     }
 
+    // a batch op handles all tasks of one OnBatchTransition at once, the per task op is used when none is registered
+    static void RegisterBatchOps(State state, BatchOp&& op)
+    {
+        batchOps[static_cast<size_t>(state)] = op;
+    }
+
     static int OnTransition(State state, TaskCtx* task, Op&& op = Op());
+    static int OnBatchTransition(State state, std::vector<TaskCtx*>& tasks);
 
     static const char* String(State state)
     {
@@ -103,6 +112,8 @@ public:
     }
 
 private:
+    static bool Transit(State state, TaskCtx* task);
+
     class TaskStateStat {
     public:
         uint64_t WaitingTime() const;
@@ -125,6 +136,7 @@ private:
     State preState = PENDING;
 
     static std::array<Op, static_cast<size_t>(TaskState::MAX)> ops;
+    static std::array<BatchOp, static_cast<size_t>(TaskState::MAX)> batchOps;
 };
 } // namespace ffrt
 
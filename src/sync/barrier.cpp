@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpp/barrier.h"
+#include <new>
+#include <vector>
+#include "sync/barrier_private.h"
+#include "dfx/log/ffrt_log_api.h"
+
+namespace ffrt {
+void latchPrivate::count_down(uint32_t n)
+{
+    int64_t left = count.fetch_sub(n, std::memory_order_acq_rel) - n;
+    if (left < 0) {
+        FFRT_LOGE("latch counted down below zero");
+    }
+    if (left != 0) {
+        return;
+    }
+    LinkedList batch;
+    waiters.lock.lock();
+    waiters.PopLocked(batch);
+    waiters.lock.unlock();
+    WaitList::Wake(batch);
+}
+
+void latchPrivate::wait()
+{
+    if (try_wait()) {
+        return;
+    }
+    waiters.Wait([this] { return !try_wait(); });
+}
+
+barrierPrivate::barrierPrivate(uint32_t count, ffrt_barrier_completion_t completion, void* arg)
+    : expected(count), completion(completion), arg(arg)
+{
+    std::vector<uint32_t> levels;
+    for (uint32_t n = (count + BARRIER_FANIN - 1) / BARRIER_FANIN;; n = (n + BARRIER_FANIN - 1) / BARRIER_FANIN) {
+        levels.push_back(n);
+        if (n == 1) {
+            break;
+        }
+    }
+    leafNum = levels[0];
+    nodeNum = 0;
+    for (auto n : levels) {
+        nodeNum += n;
+    }
+    nodes = new BarrierNode[nodeNum];
+
+    uint32_t begin = 0;
+    for (size_t level = 0; level + 1 < levels.size(); level++) {
+        uint32_t parentBegin = begin + levels[level];
+        for (uint32_t i = 0; i < levels[level]; i++) {
+            nodes[begin + i].parent = parentBegin + i / BARRIER_FANIN;
+        }
+        begin = parentBegin;
+    }
+    layout();
+}
+
+barrierPrivate::~barrierPrivate()
+{
+    delete[] nodes;
+}
+
+// spreads the participants evenly over the leaves, a node waits for its children that have any
+void barrierPrivate::layout()
+{
+    for (uint32_t i = 0; i < nodeNum; i++) {
+        nodes[i].arrived.store(0, std::memory_order_relaxed);
+        nodes[i].capacity = i < leafNum ? expected / leafNum + (i < expected % leafNum ? 1 : 0) : 0;
+    }
+    for (uint32_t i = 0; i < nodeNum; i++) {
+        if (nodes[i].capacity != 0 && nodes[i].parent != BARRIER_ROOT) {
+            nodes[nodes[i].parent].capacity++;
+        }
+    }
+}
+
+// leaf is set to the leaf of the arrival, or nullptr for the last arrival of the phase
+bool barrierPrivate::arrive(BarrierNode*& leaf)
+{
+    leaf = nullptr;
+    bool last = false;
+    uint32_t start = ThreadSlot() % leafNum;
+    for (uint32_t i = 0; i < leafNum && leaf == nullptr; i++) {
+        BarrierNode* node = &nodes[(start + i) % leafNum];
+        uint32_t c = node->arrived.load(std::memory_order_relaxed);
+        while (c < node->capacity) {
+            if (node->arrived.compare_exchange_weak(c, c + 1, std::memory_order_acq_rel)) {
+                leaf = node;
+                last = c + 1 == node->capacity;
+                break;
+            }
+        }
+    }
+    // all places of the phase are taken and it cannot complete before this arrival leaves
+    if (leaf == nullptr) {
+        FFRT_LOGE("more arrivals than barrier participants");
+        return false;
+    }
+
+    BarrierNode* node = leaf;
+    while (last) {
+        if (node->parent == BARRIER_ROOT) {
+            leaf = nullptr;
+            return true;
+        }
+        node = &nodes[node->parent];
+        last = node->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == node->capacity;
+    }
+    return true;
+}
+
+void barrierPrivate::complete()
+{
+    expected -= dropped.exchange(0, std::memory_order_relaxed);
+    layout();
+    if (completion != nullptr) {
+        completion(arg);
+    }
+    phase.fetch_add(1, std::memory_order_release);
+
+    LinkedList batch;
+    for (uint32_t i = 0; i < leafNum; i++) {
+        WaitList& waiters = nodes[i].waiters;
+        waiters.lock.lock();
+        waiters.PopLocked(batch);
+        waiters.lock.unlock();
+    }
+    WaitList::Wake(batch);
+}
+
+bool barrierPrivate::arrive_and_wait()
+{
+    uint32_t cur = phase.load(std::memory_order_acquire);
+    BarrierNode* leaf;
+    if (!arrive(leaf)) {
+        return false;
+    }
+    if (leaf == nullptr) {
+        complete();
+        return true;
+    }
+    leaf->waiters.Wait([this, cur] { return phase.load(std::memory_order_acquire) == cur; });
+    return true;
+}
+
+bool barrierPrivate::arrive_and_drop()
+{
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    BarrierNode* leaf;
+    if (!arrive(leaf)) {
+        dropped.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (leaf == nullptr) {
+        complete();
+    }
+    return true;
+}
+} // namespace ffrt
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+API_ATTRIBUTE((visibility("default")))
+int ffrt_latch_init(ffrt_latch_t* latch, uint32_t count)
+{
+    if (!latch) {
+        FFRT_LOGE("latch should not be empty");
+        return ffrt_error_inval;
+    }
+    static_assert(sizeof(ffrt::latchPrivate) <= ffrt_latch_storage_size,
+        "size must be less than ffrt_latch_storage_size");
+
+    new (latch)ffrt::latchPrivate(count);
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_latch_count_down(ffrt_latch_t* latch, uint32_t n)
+{
+    if (!latch) {
+        FFRT_LOGE("latch should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::latchPrivate*)latch;
+    p->count_down(n);
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_latch_try_wait(const ffrt_latch_t* latch)
+{
+    if (!latch) {
+        FFRT_LOGE("latch should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (const ffrt::latchPrivate*)latch;
+    return p->try_wait() ? ffrt_success : ffrt_error_busy;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_latch_wait(ffrt_latch_t* latch)
+{
+    if (!latch) {
+        FFRT_LOGE("latch should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::latchPrivate*)latch;
+    p->wait();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_latch_arrive_and_wait(ffrt_latch_t* latch, uint32_t n)
+{
+    if (!latch) {
+        FFRT_LOGE("latch should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::latchPrivate*)latch;
+    p->count_down(n);
+    p->wait();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_latch_destroy(ffrt_latch_t* latch)
+{
+    if (!latch) {
+        FFRT_LOGE("latch should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::latchPrivate*)latch;
+    p->~latchPrivate();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_barrier_init(ffrt_barrier_t* barrier, uint32_t count, ffrt_barrier_completion_t completion, void* arg)
+{
+    if (!barrier || count == 0) {
+        FFRT_LOGE("barrier should not be empty and count should be positive");
+        return ffrt_error_inval;
+    }
+    static_assert(sizeof(ffrt::barrierPrivate) <= ffrt_barrier_storage_size,
+        "size must be less than ffrt_barrier_storage_size");
+
+    new (barrier)ffrt::barrierPrivate(count, completion, arg);
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_barrier_arrive_and_wait(ffrt_barrier_t* barrier)
+{
+    if (!barrier) {
+        FFRT_LOGE("barrier should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::barrierPrivate*)barrier;
+    return p->arrive_and_wait() ? ffrt_success : ffrt_error_inval;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_barrier_arrive_and_drop(ffrt_barrier_t* barrier)
+{
+    if (!barrier) {
+        FFRT_LOGE("barrier should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::barrierPrivate*)barrier;
+    return p->arrive_and_drop() ? ffrt_success : ffrt_error_inval;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_barrier_destroy(ffrt_barrier_t* barrier)
+{
+    if (!barrier) {
+        FFRT_LOGE("barrier should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::barrierPrivate*)barrier;
+    p->~barrierPrivate();
+    return ffrt_success;
+}
+#ifdef __cplusplus
+}
+#endif
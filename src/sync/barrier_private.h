@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _BARRIER_PRIVATE_H_
+#define _BARRIER_PRIVATE_H_
+
+#include <atomic>
+#include "c/barrier.h"
+#include "sync/wait_list.h"
+
+namespace ffrt {
+constexpr uint32_t BARRIER_FANIN = 8; // arrivals a tree node counts before its last arrival moves on to the parent
+constexpr uint32_t BARRIER_ROOT = UINT32_MAX;
+
+class latchPrivate {
+    std::atomic<int64_t> count;
+    WaitList waiters;
+
+public:
+    explicit latchPrivate(uint32_t count) : count(count)
+    {
+    }
+    latchPrivate(latchPrivate const&) = delete;
+    void operator=(latchPrivate const&) = delete;
+
+    void count_down(uint32_t n);
+    bool try_wait() const
+    {
+        return count.load(std::memory_order_acquire) == 0;
+    }
+    void wait();
+};
+
+struct alignas(64) BarrierNode {
+    std::atomic<uint32_t> arrived {0};
+    uint32_t capacity = 0;
+    uint32_t parent = BARRIER_ROOT;
+    WaitList waiters; // leaves only
+};
+
+/*
+ * Arrivals take a free place in a leaf, starting at the leaf of their thread, and only the last arrival of a
+ * node counts itself in the parent. The last arrival at the root runs the completion, resets the tree and
+ * wakes the waiters of all leaves in one batch. Leaves are nodes [0, leafNum), each level follows the one below.
+ */
+class barrierPrivate {
+    BarrierNode* nodes;
+    uint32_t nodeNum;
+    uint32_t leafNum;
+    uint32_t expected; // written by the last arrival of a phase only
+    std::atomic<uint32_t> dropped {0};
+    std::atomic<uint32_t> phase {0};
+    ffrt_barrier_completion_t completion;
+    void* arg;
+
+    void layout();
+    bool arrive(BarrierNode*& leaf);
+    void complete();
+
+public:
+    barrierPrivate(uint32_t count, ffrt_barrier_completion_t completion, void* arg);
+    ~barrierPrivate();
+    barrierPrivate(barrierPrivate const&) = delete;
+    void operator=(barrierPrivate const&) = delete;
+
+    bool arrive_and_wait();
+    bool arrive_and_drop();
+};
+} // namespace ffrt
+
+#endif
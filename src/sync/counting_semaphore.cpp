@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpp/semaphore.h"
+#include <new>
+#include "sync/counting_semaphore_private.h"
+#include "dfx/log/ffrt_log_api.h"
+
+namespace ffrt {
+bool semaphorePrivate::try_acquire()
+{
+    int64_t c = count.load(std::memory_order_relaxed);
+    while (c > 0) {
+        if (count.compare_exchange_weak(c, c - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void semaphorePrivate::acquire()
+{
+    if (try_acquire()) {
+        return;
+    }
+    waiters.Wait([this] { return !try_acquire(); });
+}
+
+void semaphorePrivate::release(uint32_t n)
+{
+    LinkedList batch;
+    waiters.lock.lock();
+    size_t granted = waiters.PopLocked(batch, n);
+    if (granted < n) {
+        count.fetch_add(n - granted, std::memory_order_release);
+    }
+    waiters.lock.unlock();
+    WaitList::Wake(batch);
+}
+} // namespace ffrt
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+API_ATTRIBUTE((visibility("default")))
+int ffrt_sem_init(ffrt_sem_t* sem, uint32_t value)
+{
+    if (!sem) {
+        FFRT_LOGE("sem should not be empty");
+        return ffrt_error_inval;
+    }
+    if (value > INT32_MAX) {
+        FFRT_LOGE("sem value %u is too large", value);
+        return ffrt_error_inval;
+    }
+    static_assert(sizeof(ffrt::semaphorePrivate) <= ffrt_sem_storage_size,
+        "size must be less than ffrt_sem_storage_size");
+
+    new (sem)ffrt::semaphorePrivate(value);
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_sem_wait(ffrt_sem_t* sem)
+{
+    if (!sem) {
+        FFRT_LOGE("sem should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::semaphorePrivate*)sem;
+    p->acquire();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_sem_trywait(ffrt_sem_t* sem)
+{
+    if (!sem) {
+        FFRT_LOGE("sem should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::semaphorePrivate*)sem;
+    return p->try_acquire() ? ffrt_success : ffrt_error_busy;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_sem_post(ffrt_sem_t* sem, uint32_t count)
+{
+    if (!sem) {
+        FFRT_LOGE("sem should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::semaphorePrivate*)sem;
+    p->release(count);
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_sem_getvalue(const ffrt_sem_t* sem, int* value)
+{
+    if (!sem || !value) {
+        FFRT_LOGE("sem and value should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (const ffrt::semaphorePrivate*)sem;
+    *value = static_cast<int>(p->value());
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_sem_destroy(ffrt_sem_t* sem)
+{
+    if (!sem) {
+        FFRT_LOGE("sem should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::semaphorePrivate*)sem;
+    p->~semaphorePrivate();
+    return ffrt_success;
+}
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _COUNTING_SEMAPHORE_PRIVATE_H_
+#define _COUNTING_SEMAPHORE_PRIVATE_H_
+
+#include <atomic>
+#include "sync/wait_list.h"
+
+namespace ffrt {
+// a post hands its permits to parked waiters directly, only the rest raise the count
+class semaphorePrivate {
+    std::atomic<int64_t> count;
+    WaitList waiters;
+
+public:
+    explicit semaphorePrivate(uint32_t value) : count(value)
+    {
+    }
+    semaphorePrivate(semaphorePrivate const&) = delete;
+    void operator=(semaphorePrivate const&) = delete;
+
+    bool try_acquire();
+    void acquire();
+    void release(uint32_t n);
+
+    int64_t value() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+};
+} // namespace ffrt
+
+#endif
@@ -16,29 +16,35 @@
 #include "delayed_worker.h"
 
 #include <unistd.h>
+#include <sched.h>
 #include <sys/syscall.h>
 #include <sys/prctl.h>
+#include <algorithm>
 #include <thread>
 #include <linux/futex.h>
 namespace ffrt {
-DelayedWorker::DelayedWorker() : futex(0)
+namespace {
+constexpr uint64_t NS_PER_SEC = 1000000000;
+constexpr uint64_t WHEEL_SLOT_MASK = WHEEL_SLOT_NUM - 1;
+constexpr uint64_t WHEEL_SPAN = 1ULL << (WHEEL_SLOT_BITS * WHEEL_LEVEL_NUM);
+
+inline uint64_t NowTick()
 {
-    std::thread t([this]() {
-        prctl(PR_SET_NAME, "delayed_worker");
-        for (;;) {
-            lock.lock();
-            if (futex < 0) {
-                lock.unlock();
-                exited = true;
-                break;
-            }
-            struct timespec ts;
-            struct timespec *p = &ts;
-            HandleWork(&p);
-            lock.unlock();
-            syscall(SYS_futex, &futex, FUTEX_WAIT_BITSET, 0, p, 0, -1);
-        }
-    });
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<uint64_t>(ns) / DELAYED_TICK_NS;
+}
+
+inline uint64_t RotateRight(uint64_t bits, uint32_t n)
+{
+    n &= WHEEL_SLOT_MASK;
+    return n == 0 ? bits : ((bits >> n) | (bits << (WHEEL_SLOT_NUM - n)));
+}
+} // namespace
+
+DelayedWorker::DelayedWorker() : curTick(NowTick()), futex(0)
+{
+    std::thread t([this]() { Run(); });
     t.detach();
 }
 
@@ -53,40 +59,153 @@ DelayedWorker::~DelayedWorker()
     }
 }
 
-void DelayedWorker::HandleWork(struct timespec** p)
+void DelayedWorker::Run()
 {
-    const int NS_PER_SEC = 1000000000;
-
-    while (!map.empty()) {
-        time_point_t now = std::chrono::steady_clock::now();
-        auto cur = map.begin();
-        if (cur->first <= now) {
-            DelayedWork w = cur->second;
-            map.erase(cur);
+    prctl(PR_SET_NAME, "delayed_worker");
+    LinkedList due;
+    for (;;) {
+        lock.lock();
+        if (futex < 0) {
             lock.unlock();
-            (*w.cb)(w.we);
-            lock.lock();
-            if (futex < 0) {
-                return;
+            break;
+        }
+        futex = 0;
+        Drain();
+        Advance(NowTick(), due);
+        uint64_t next = NextTick();
+        wakeTick = next;
+        lock.unlock();
+
+        if (!due.Empty()) {
+            while (!due.Empty()) {
+                // the entry may be re-armed by its owner once the callback ran, read it before
+                WaitEntry* we = due.RemoveNext<WaitEntry>(&WaitEntry::timerNode);
+                // the callback usually lives in the entry or on the waiter's stack and may be
+                // released by the call itself, invoke a copy
+                std::function<void(WaitEntry*)> cb = *we->timerCb;
+                cb(we);
+            }
+            continue;
+        }
+        if (!ArmBufferEmpty()) {
+            continue;
+        }
+
+        struct timespec ts;
+        struct timespec* p = nullptr;
+        if (next != UINT64_MAX) {
+            uint64_t ns = next * DELAYED_TICK_NS;
+            ts.tv_sec = static_cast<time_t>(ns / NS_PER_SEC);
+            ts.tv_nsec = static_cast<long>(ns % NS_PER_SEC);
+            p = &ts;
+        }
+        syscall(SYS_futex, &futex, FUTEX_WAIT_BITSET, 0, p, 0, -1);
+    }
+    exited = true;
+}
+
+void DelayedWorker::Drain()
+{
+    for (auto& buf : armBuf) {
+        WaitEntry* we = buf.head.exchange(nullptr);
+        while (we != nullptr) {
+            WaitEntry* next = we->armNext;
+            if (we->expireTick <= curTick) {
+                we->expireTick = curTick + 1;
             }
-        } else {
-            std::chrono::nanoseconds ns = cur->first.time_since_epoch();
-            (*p)->tv_sec = ns.count() / NS_PER_SEC;
-            (*p)->tv_nsec = ns.count() % NS_PER_SEC;
-            futex = 0;
-            return;
+            Insert(we);
+            we = next;
         }
     }
+}
 
-    *p = nullptr;
-    futex = 0;
+bool DelayedWorker::ArmBufferEmpty() const
+{
+    return std::all_of(armBuf.begin(), armBuf.end(), [](const ArmBuffer& buf) { return buf.head == nullptr; });
 }
 
-bool DelayedWorker::dispatch(const time_point_t& to, WaitEntry* we, const std::function<void(WaitEntry*)>& wakeup)
+void DelayedWorker::Insert(WaitEntry* we)
 {
-    bool w = false;
-    std::lock_guard<decltype(lock)> l(lock);
+    uint64_t delta = we->expireTick > curTick ? we->expireTick - curTick : 0;
+    uint64_t expire = we->expireTick;
+    if (delta >= WHEEL_SPAN) {
+        // parked in the farthest slot of the top level and re-inserted when it is cascaded
+        delta = WHEEL_SPAN - 1;
+        expire = curTick + delta;
+    }
+    uint32_t level = delta < WHEEL_SLOT_NUM ? 0 :
+        static_cast<uint32_t>(63 - __builtin_clzll(delta)) / WHEEL_SLOT_BITS;
+    uint32_t slot = static_cast<uint32_t>((expire >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK);
+    wheel[level][slot].PushBack(we->timerNode);
+    bitmap[level] |= 1ULL << slot;
+    we->timerSlot = level * WHEEL_SLOT_NUM + slot;
+    we->timerArmed = true;
+}
 
+void DelayedWorker::Unlink(WaitEntry* we)
+{
+    uint32_t level = we->timerSlot / WHEEL_SLOT_NUM;
+    uint32_t slot = we->timerSlot % WHEEL_SLOT_NUM;
+    LinkedList::Delete(we->timerNode);
+    if (wheel[level][slot].Empty()) {
+        bitmap[level] &= ~(1ULL << slot);
+    }
+    we->timerArmed = false;
+}
+
+void DelayedWorker::Cascade(uint32_t level)
+{
+    uint32_t slot = static_cast<uint32_t>((curTick >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK);
+    LinkedList& head = wheel[level][slot];
+    LinkedList moved;
+    while (!head.Empty()) {
+        moved.PushBack(head.RemoveNext());
+    }
+    bitmap[level] &= ~(1ULL << slot);
+    while (!moved.Empty()) {
+        Insert(moved.RemoveNext<WaitEntry>(&WaitEntry::timerNode));
+    }
+}
+
+uint64_t DelayedWorker::NextTick() const
+{
+    uint64_t next = UINT64_MAX;
+    for (uint32_t level = 0; level < WHEEL_LEVEL_NUM; level++) {
+        if (bitmap[level] == 0) {
+            continue;
+        }
+        // slot pos of the current rotation has been visited already, the nearest one is 1..64 slots ahead
+        uint32_t shift = level * WHEEL_SLOT_BITS;
+        uint64_t pos = (curTick >> shift) & WHEEL_SLOT_MASK;
+        uint64_t ahead = static_cast<uint64_t>(__builtin_ctzll(RotateRight(bitmap[level], pos + 1))) + 1;
+        next = std::min(next, ((curTick >> shift) + ahead) << shift);
+    }
+    return next;
+}
+
+void DelayedWorker::Advance(uint64_t target, LinkedList& due)
+{
+    while (curTick < target) {
+        // jump over the empty ticks, nothing happens in between
+        curTick = std::min(NextTick(), target);
+        for (uint32_t level = WHEEL_LEVEL_NUM - 1; level > 0; level--) {
+            if ((curTick & ((1ULL << (level * WHEEL_SLOT_BITS)) - 1)) == 0) {
+                Cascade(level);
+            }
+        }
+        uint32_t slot = static_cast<uint32_t>(curTick & WHEEL_SLOT_MASK);
+        LinkedList& head = wheel[0][slot];
+        while (!head.Empty()) {
+            WaitEntry* we = head.RemoveNext<WaitEntry>(&WaitEntry::timerNode);
+            we->timerArmed = false;
+            due.PushBack(we->timerNode);
+        }
+        bitmap[0] &= ~(1ULL << slot);
+    }
+}
+
+bool DelayedWorker::dispatch(const time_point_t& to, WaitEntry* we, const std::function<void(WaitEntry*)>& wakeup)
+{
     if (futex < 0) {
         return false;
     }
@@ -96,15 +215,35 @@ bool DelayedWorker::dispatch(const time_point_t& to, WaitEntry* we, const std::f
         return false;
     }
 
-    if (map.empty() || to < map.begin()->first) {
-        w = true;
-    }
-    map.emplace(to, DelayedWork {we, &wakeup});
-    if (w) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(to.time_since_epoch()).count();
+    uint64_t expire = (static_cast<uint64_t>(ns) + DELAYED_TICK_NS - 1) / DELAYED_TICK_NS;
+    we->expireTick = expire;
+    we->timerCb = &wakeup;
+
+    int cpu = sched_getcpu();
+    ArmBuffer& buf = armBuf[static_cast<uint32_t>(cpu < 0 ? 0 : cpu) % DELAYED_ARM_BUFFER_NUM];
+    WaitEntry* head = buf.head.load(std::memory_order_relaxed);
+    do {
+        we->armNext = head;
+    } while (!buf.head.compare_exchange_weak(head, we));
+
+    // we may be fired and released from here on, only the local copy of its expiration is used
+    if (expire < wakeTick) {
         futex = 1;
         syscall(SYS_futex, &futex, FUTEX_WAKE, 1);
     }
+    return true;
+}
 
+bool DelayedWorker::cancel(WaitEntry* we)
+{
+    std::lock_guard<decltype(lock)> l(lock);
+    // the entry may still sit in an arm buffer
+    Drain();
+    if (!we->timerArmed) {
+        return false;
+    }
+    Unlink(we);
     return true;
 }
-} // namespace ffrt
\ No newline at end of file
+} // namespace ffrt
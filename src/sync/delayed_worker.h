@@ -16,25 +16,48 @@
 #ifndef _DELAYED_WORKER_H_
 #define _DELAYED_WORKER_H_
 
-#include <map>
+#include <array>
+#include <atomic>
 #include <functional>
 #include "cpp/sleep.h"
 #include "sched/execute_ctx.h"
 namespace ffrt {
 using time_point_t = std::chrono::steady_clock::time_point;
 
-struct DelayedWork {
-    WaitEntry* we;
-    const std::function<void(WaitEntry*)>* cb;
-};
+constexpr uint64_t DELAYED_TICK_NS = 100000; // expirations within one tick are fired together
+constexpr uint32_t WHEEL_SLOT_BITS = 6;
+constexpr uint32_t WHEEL_SLOT_NUM = 1U << WHEEL_SLOT_BITS;
+constexpr uint32_t WHEEL_LEVEL_NUM = 4; // covers 64^4 ticks, later expirations are re-cascaded
+constexpr uint32_t DELAYED_ARM_BUFFER_NUM = 16;
 
+/*
+ * Hierarchical hashed timer wheel. Level l holds the entries expiring within 64^(l+1) ticks, hashed by
+ * (expireTick >> 6l) & 63, and its slots are cascaded to the lower levels when the wheel reaches them.
+ * Callers arm entries by pushing them to a per-cpu lock-free buffer which the timer thread drains, so the
+ * wheel lock is only taken by the timer thread and by cancellation.
+ */
 class DelayedWorker {
-    std::multimap<time_point_t, DelayedWork> map;
+    struct alignas(64) ArmBuffer {
+        std::atomic<WaitEntry*> head {nullptr};
+    };
+
+    std::array<std::array<LinkedList, WHEEL_SLOT_NUM>, WHEEL_LEVEL_NUM> wheel;
+    std::array<uint64_t, WHEEL_LEVEL_NUM> bitmap {};
+    uint64_t curTick;
     std::mutex lock;
+    std::array<ArmBuffer, DELAYED_ARM_BUFFER_NUM> armBuf;
+    std::atomic_uint64_t wakeTick {UINT64_MAX}; // tick the timer thread sleeps until
     std::atomic_int futex;
-    bool exited = false;
+    std::atomic_bool exited {false};
 
-    void HandleWork(struct timespec** p);
+    void Run();
+    void Drain();
+    bool ArmBufferEmpty() const;
+    void Insert(WaitEntry* we);
+    void Unlink(WaitEntry* we);
+    void Cascade(uint32_t level);
+    uint64_t NextTick() const;
+    void Advance(uint64_t target, LinkedList& due);
 
 public:
     DelayedWorker(DelayedWorker const&) = delete;
@@ -45,6 +68,9 @@ public:
     ~DelayedWorker();
 
     bool dispatch(const time_point_t& to, WaitEntry* we, const std::function<void(WaitEntry*)>& wakeup);
+
+    // true if the entry was still armed, its callback will not run then
+    bool cancel(WaitEntry* we);
 };
 } // namespace ffrt
 #endif
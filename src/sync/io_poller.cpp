@@ -20,23 +20,32 @@
 #include "dfx/log/ffrt_log_api.h"
 #include "dfx/trace/ffrt_trace.h"
 
+#include <algorithm>
 #include <cassert>
+#include <poll.h>
+#include "internal_inc/osal.h"
+#include "util/cpu_topology.h"
 
 namespace ffrt {
-constexpr unsigned int DEFAULT_CPUINDEX_LIMIT = 7;
+constexpr unsigned int IO_POLLER_MAX = 4;
+constexpr unsigned int CPUS_PER_IO_POLLER = 8;
+constexpr int IO_INLINE_EVENTS = 16;
 struct IOPollerInstance: public IOPoller {
-    IOPollerInstance() noexcept: m_runner([&] { RunForever(); })
+    explicit IOPollerInstance(int node) noexcept: m_node(node), m_runner([&] { RunForever(); })
     {
         pthread_setname_np(m_runner.native_handle(), "ffrt_io");
     }
 
+    // the poller stays on the cpus of its numa node, the tasks it readies are woken there
     void RunForever() noexcept
     {
         pid_t pid = syscall(SYS_gettid);
         cpu_set_t mask;
         CPU_ZERO(&mask);
-        for (unsigned int i = 0; i < DEFAULT_CPUINDEX_LIMIT; ++i) {
-            CPU_SET(i, &mask);
+        for (int cpu : CpuTopology::Instance().NodeCpus(m_node)) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &mask);
+            }
         }
         syscall(__NR_sched_setaffinity, pid, sizeof(mask), &mask);
         while (!m_exitFlag.load(std::memory_order_relaxed)) {
@@ -58,18 +67,70 @@ private:
     }
 
 private:
+    int m_node;
     std::thread m_runner;
     std::atomic<bool> m_exitFlag { false };
 };
 
-IOPoller& GetIOPoller() noexcept
+namespace {
+std::atomic_bool g_pollersReady { false };
+
+struct IOPollerGroup {
+    IOPollerGroup() noexcept
+    {
+        // at least one poller per numa node
+        auto& topology = CpuTopology::Instance();
+        unsigned int nodeNum = static_cast<unsigned int>(topology.NodeNum());
+        unsigned int num = std::max(nodeNum,
+            std::clamp(static_cast<unsigned int>(topology.CpuNum()) / CPUS_PER_IO_POLLER, 1U, IO_POLLER_MAX));
+        std::string env = GetEnv("FFRT_IO_POLLER_NUM");
+        if (!env.empty()) {
+            int n = atoi(env.c_str());
+            if (n > 0) {
+                num = static_cast<unsigned int>(n);
+            } else {
+                FFRT_LOGW("invalid io poller num[%s]", env.c_str());
+            }
+        }
+        for (unsigned int i = 0; i < num; i++) {
+            pollers.emplace_back(std::make_unique<IOPollerInstance>(static_cast<int>(i % nodeNum)));
+        }
+        g_pollersReady.store(true, std::memory_order_release);
+    }
+
+    std::vector<std::unique_ptr<IOPollerInstance>> pollers;
+};
+
+IOPollerGroup& GetIOPollerGroup() noexcept
+{
+    static IOPollerGroup group;
+    return group;
+}
+} // namespace
+
+IOPoller& GetIOPoller(int fd) noexcept
 {
-    static IOPollerInstance inst;
-    return inst;
+    auto& pollers = GetIOPollerGroup().pollers;
+    return *pollers[static_cast<unsigned int>(fd) % pollers.size()];
+}
+
+bool PollIOInline() noexcept
+{
+    static const bool enabled = GetEnv("FFRT_IO_INLINE_POLL") == "1";
+    // no fd has been waited yet
+    if (!enabled || !g_pollersReady.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    int woken = 0;
+    for (auto& poller : GetIOPollerGroup().pollers) {
+        woken += poller->PollInline();
+    }
+    return woken > 0;
 }
 
 IOPoller::IOPoller() noexcept: m_epFd { ::epoll_create1(EPOLL_CLOEXEC) },
-    m_events(32)
+    m_events(IO_EVENTS_INIT)
 {
     assert(m_epFd >= 0);
     {
@@ -101,6 +162,44 @@ void IOPoller::WakeUp() noexcept
     assert(n == sizeof one);
 }
 
+WakeData* IOPoller::GetWakeData(int fd)
+{
+    std::lock_guard lg(m_fdLock);
+    auto& data = m_fds[fd];
+    if (data == nullptr) {
+        data = std::make_unique<WakeData>();
+        data->fd = fd;
+        data->data = nullptr;
+        data->registered = false;
+    }
+    return data.get();
+}
+
+bool IOPoller::Arm(WakeData* data)
+{
+    epoll_event ev = { .events = EPOLLIN | EPOLLONESHOT, .data = {.ptr = static_cast<void*>(data)} };
+    if (data->registered) {
+        if (epoll_ctl(m_epFd, EPOLL_CTL_MOD, data->fd, &ev) == 0) {
+            return true;
+        }
+        // the fd was closed in between and dropped from the epoll set, its number may be reused
+        if (errno != ENOENT) {
+            return false;
+        }
+        data->registered = false;
+    }
+    if (epoll_ctl(m_epFd, EPOLL_CTL_ADD, data->fd, &ev) == 0) {
+        data->registered = true;
+        return true;
+    }
+    // registered by someone else with the same fd number, e.g. a dup
+    if (errno == EEXIST && epoll_ctl(m_epFd, EPOLL_CTL_MOD, data->fd, &ev) == 0) {
+        data->registered = true;
+        return true;
+    }
+    return false;
+}
+
 void IOPoller::WaitFdEvent(int fd) noexcept
 {
     auto ctx = ExecuteCtx::Cur();
@@ -108,42 +207,80 @@ void IOPoller::WaitFdEvent(int fd) noexcept
         FFRT_LOGI("nonworker shall not call this fun.");
         return;
     }
-    struct WakeData data = {.fd = fd, .data = static_cast<void *>(ctx->task)};
+    if (ThreadWaitMode(ctx->task)) {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN, .revents = 0 };
+        while (::poll(&pfd, 1, -1) < 0 && errno == EINTR) {
+        }
+        return;
+    }
 
-    epoll_event ev = { .events = EPOLLIN, .data = {.ptr = static_cast<void*>(&data)} };
+    WakeData* data = GetWakeData(fd);
     FFRT_BLOCK_TRACER(ctx->task->gid, fd);
     CoWait([&](TaskCtx *task)->bool {
-        (void)task;
-        if (epoll_ctl(m_epFd, EPOLL_CTL_ADD, fd, &ev) == 0) {
+        void* expected = nullptr;
+        if (!data->data.compare_exchange_strong(expected, task)) {
+            FFRT_LOGI("fd=%d is waited by another task", fd);
+            return false;
+        }
+        if (Arm(data)) {
             return true;
         }
-        FFRT_LOGI("epoll_ctl add err:efd:=%d, fd=%d errorno = %d", m_epFd, fd, errno);
+        data->data = nullptr;
+        FFRT_LOGI("epoll_ctl arm err:efd:=%d, fd=%d errorno = %d", m_epFd, fd, errno);
         return false;
     });
 }
 
-void IOPoller::PollOnce(int timeout) noexcept
+int IOPoller::HandleEvents(const epoll_event* events, int num) noexcept
+{
+    int woken = 0;
+    for (int i = 0; i < num; ++i) {
+        struct WakeData *data = reinterpret_cast<struct WakeData *>(events[i].data.ptr);
+        if (data == &m_wakeData) {
+            continue;
+        }
+        // the oneshot registration is disarmed now, the fd stays in the set until the next wait re-arms it
+        auto task = static_cast<TaskCtx*>(data->data.exchange(nullptr));
+        if (task != nullptr) {
+            CoWake(task, false);
+            woken++;
+        }
+    }
+    return woken;
+}
+
+int IOPoller::PollOnce(int timeout) noexcept
 {
     int ndfs = epoll_wait(m_epFd, m_events.data(), m_events.size(), timeout);
     if (ndfs <= 0) {
-        FFRT_LOGE("epoll_wait error: efd = %d, errorno= %d", m_epFd, errno);
-        return;
+        if (ndfs < 0 && errno != EINTR) {
+            FFRT_LOGE("epoll_wait error: efd = %d, errorno= %d", m_epFd, errno);
+        }
+        return 0;
     }
 
-    for (unsigned int i = 0; i < static_cast<unsigned int>(ndfs); ++i) {
-        struct WakeData *data = reinterpret_cast<struct WakeData *>(m_events[i].data.ptr);
-
-        if (data->fd == m_wakeData.fd) {
+    for (int i = 0; i < ndfs; ++i) {
+        if (m_events[i].data.ptr == &m_wakeData) {
             uint64_t one = 1;
             ssize_t n = ::read(m_wakeData.fd, &one, sizeof one);
             assert(n == sizeof one);
-        } else {
-            if (epoll_ctl(m_epFd, EPOLL_CTL_DEL, data->fd, nullptr) == 0) {
-                CoWake(reinterpret_cast<TaskCtx *>(data->data), false);
-            } else {
-                FFRT_LOGI("epoll_ctl fd = %d errorno = %d", data->fd, errno);
-            }
         }
     }
+    int woken = HandleEvents(m_events.data(), ndfs);
+    if (static_cast<size_t>(ndfs) == m_events.size() && m_events.size() < IO_EVENTS_MAX) {
+        m_events.resize(m_events.size() * 2);
+    }
+    return woken;
+}
+
+int IOPoller::PollInline() noexcept
+{
+    // the wakeup eventfd is left to the poller thread, it is level triggered and stays readable
+    epoll_event events[IO_INLINE_EVENTS];
+    int ndfs = epoll_wait(m_epFd, events, IO_INLINE_EVENTS, 0);
+    if (ndfs <= 0) {
+        return 0;
+    }
+    return HandleEvents(events, ndfs);
 }
 }
@@ -21,17 +21,27 @@
 #endif
 #include <thread>
 #include <vector>
-#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <atomic>
 #include "ffrt.h"
 #include "internal_inc/non_copyable.h"
 
 namespace ffrt {
+constexpr size_t IO_EVENTS_INIT = 32;
+constexpr size_t IO_EVENTS_MAX = 4096;
+
 struct WakeData {
     int fd;
-    void* data;
+    std::atomic<void*> data; // task waiting for the fd
+    bool registered; // the fd stays in the epoll set between waits, disarmed by EPOLLONESHOT
 };
 
+/*
+ * One epoll set served by one thread. A waited fd is registered once with EPOLLONESHOT, later waits
+ * re-arm it with EPOLL_CTL_MOD, so a readiness event costs a single epoll_ctl.
+ */
 struct IOPoller: private NonCopyable {
     IOPoller() noexcept;
 
@@ -40,23 +50,40 @@ struct IOPoller: private NonCopyable {
     void WakeUp() noexcept;
     bool CasStrong(std::atomic<int> &a, int cmp, int exc);
     void WaitFdEvent(int fd) noexcept;
-    void PollOnce(int timeout = -1) noexcept;
+    // returns the number of woken tasks
+    int PollOnce(int timeout = -1) noexcept;
+    // non-blocking poll from an idle worker, it shares the epoll set with the poller thread
+    int PollInline() noexcept;
 
 private:
+    WakeData* GetWakeData(int fd);
+    bool Arm(WakeData* data);
+#ifndef _MSC_VER
+    int HandleEvents(const epoll_event* events, int num) noexcept;
+#endif
+
     int m_epFd;
     struct WakeData m_wakeData;
 #ifndef _MSC_VER
     std::vector<epoll_event> m_events;
 #endif
+    std::mutex m_fdLock;
+    std::unordered_map<int, std::unique_ptr<WakeData>> m_fds;
 };
 
-IOPoller& GetIOPoller() noexcept;
+/*
+ * FFRT_IO_POLLER_NUM sets the number of poller threads, fds are sharded among them.
+ * FFRT_IO_INLINE_POLL=1 lets idle workers poll before they sleep.
+ */
+IOPoller& GetIOPoller(int fd) noexcept;
+// true if an idle worker woke some io waiting task and should look for work again
+bool PollIOInline() noexcept;
 }
 
 static inline void ffrt_wait_fd(int fd)
 {
 #ifndef _MSC_VER
-    ffrt::GetIOPoller().WaitFdEvent(fd);
+    ffrt::GetIOPoller(fd).WaitFdEvent(fd);
 #endif
 }
 #endif
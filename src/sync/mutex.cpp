@@ -19,6 +19,7 @@
 #define _GNU_SOURCE
 #endif
 
+#include <algorithm>
 #include <map>
 #include <functional>
 #include "sync/sync.h"
@@ -26,14 +27,64 @@
 #include "eu/co_routine.h"
 #include "internal_inc/osal.h"
 #include "sync/mutex_private.h"
+#include "util/cpu_topology.h"
 #include "dfx/log/ffrt_log_api.h"
 #include "dfx/trace/ffrt_trace.h"
 
 namespace ffrt {
+namespace {
+// 0 when spinning cannot help because the owner needs the only cpu
+int MutexSpinMax()
+{
+    static const int spinMax = [] {
+        int n = CpuTopology::Instance().CpuNum() > 1 ? MUTEX_SPIN_MAX : 0;
+        std::string env = GetEnv("FFRT_MUTEX_SPIN_MAX");
+        if (!env.empty()) {
+            n = std::clamp(atoi(env.c_str()), 0, static_cast<int>(UINT16_MAX));
+        }
+        return n;
+    }();
+    return spinMax;
+}
+} // namespace
+
+void MutexOwnerParked(TaskCtx* task, bool parked)
+{
+    for (mutexPrivate* m = task->heldMutex; m != nullptr; m = m->nextHeld) {
+        m->ownerParked.store(parked, std::memory_order_relaxed);
+    }
+}
+
+void mutexPrivate::held_push(TaskCtx* task)
+{
+    if (task != nullptr) {
+        nextHeld = task->heldMutex;
+        task->heldMutex = this;
+    }
+}
+
+void mutexPrivate::held_remove(TaskCtx* task)
+{
+    if (task == nullptr) {
+        return;
+    }
+    // mutexes are mostly released in reverse order, this one is the head then
+    for (mutexPrivate** p = &task->heldMutex; *p != nullptr; p = &(*p)->nextHeld) {
+        if (*p == this) {
+            *p = nextHeld;
+            break;
+        }
+    }
+    nextHeld = nullptr;
+}
+
 bool mutexPrivate::try_lock()
 {
     int v = sync_detail::UNLOCK;
     bool ret = l.compare_exchange_strong(v, sync_detail::LOCK, std::memory_order_acquire, std::memory_order_relaxed);
+    if (ret) {
+        held_push(ExecuteCtx::Cur()->task);
+    }
 #ifdef FFRT_MUTEX_DEADLOCK_CHECK
     if (ret) {
         uint64_t task = ExecuteCtx::Cur()->task ? reinterpret_cast<uint64_t>(ExecuteCtx::Cur()->task) : GetTid();
@@ -46,10 +97,12 @@ bool mutexPrivate::try_lock()
 
 void mutexPrivate::lock()
 {
+    // the task stays the same if the wait moves it to another worker
+    TaskCtx* curTask = ExecuteCtx::Cur()->task;
 #ifdef FFRT_MUTEX_DEADLOCK_CHECK
     uint64_t task;
     uint64_t ownerTask;
-    task = ExecuteCtx::Cur()->task ? reinterpret_cast<uint64_t>(ExecuteCtx::Cur()->task) : GetTid();
+    task = curTask ? reinterpret_cast<uint64_t>(curTask) : GetTid();
     ownerTask = owner.load(std::memory_order_relaxed);
     if (ownerTask) {
         MutexGraph::Instance().AddNode(task, ownerTask, true);
@@ -58,21 +111,88 @@ void mutexPrivate::lock()
     }
 #endif
     int v = sync_detail::UNLOCK;
-    if (l.compare_exchange_strong(v, sync_detail::LOCK, std::memory_order_acquire, std::memory_order_relaxed)) {
-        goto lock_out;
+    if (!l.compare_exchange_strong(v, sync_detail::LOCK, std::memory_order_acquire, std::memory_order_relaxed)) {
+        lock_contended();
     }
-    if (l.load(std::memory_order_relaxed) == sync_detail::WAIT) {
-        wait();
+    held_push(curTask);
+#ifdef FFRT_MUTEX_DEADLOCK_CHECK
+    owner.store(task, std::memory_order_relaxed);
+#endif
+}
+
+void mutexPrivate::lock_morphed(TaskCtx* task)
+{
+    if (!task->fq_we.lockGranted) {
+        while (l.exchange(sync_detail::WAIT, std::memory_order_acquire) != sync_detail::UNLOCK) {
+            if (wait()) {
+                break;
+            }
+        }
+    }
+    held_push(task);
+#ifdef FFRT_MUTEX_DEADLOCK_CHECK
+    uint64_t cur = reinterpret_cast<uint64_t>(task);
+    MutexGraph::Instance().AddNode(cur, 0, false);
+    owner.store(cur, std::memory_order_relaxed);
+#endif
+}
+
+bool mutexPrivate::requeue(TaskCtx* task)
+{
+    wlock.lock();
+    int v = sync_detail::LOCK;
+    // the unlock of the owner then wakes the list
+    if (!l.compare_exchange_strong(v, sync_detail::WAIT, std::memory_order_relaxed) && v != sync_detail::WAIT) {
+        wlock.unlock();
+        return false;
+    }
+    task->fq_we.lockGranted = false;
+    list.PushBack(task->fq_we.node);
+    wlock.unlock();
+    return true;
+}
+
+void mutexPrivate::lock_contended()
+{
+    stat.contended.fetch_add(1, std::memory_order_relaxed);
+    if (spin()) {
+        stat.spun.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // a granted waiter owns the mutex without taking it
+    if (l.load(std::memory_order_relaxed) == sync_detail::WAIT && wait()) {
+        return;
     }
     while (l.exchange(sync_detail::WAIT, std::memory_order_acquire) != sync_detail::UNLOCK) {
-        wait();
+        if (wait()) {
+            return;
+        }
     }
+}
 
-lock_out:
-#ifdef FFRT_MUTEX_DEADLOCK_CHECK
-    owner.store(task, std::memory_order_relaxed);
-#endif
-    return;
+bool mutexPrivate::spin()
+{
+    int spinMax = MutexSpinMax();
+    if (spinMax == 0) {
+        return false;
+    }
+    int cur = spins.load(std::memory_order_relaxed);
+    int limit = std::min(spinMax, cur * 2 + MUTEX_SPIN_MIN);
+    int cnt = 0;
+    for (; cnt < limit; cnt++) {
+        int v = l.load(std::memory_order_relaxed);
+        // a switched out owner does not release soon, queued waiters get a handoff mutex first
+        if (ownerParked.load(std::memory_order_relaxed) || (handoff && v == sync_detail::WAIT)) {
+            return false;
+        }
+        if (v == sync_detail::UNLOCK &&
+            l.compare_exchange_weak(v, sync_detail::LOCK, std::memory_order_acquire, std::memory_order_relaxed)) {
+            break;
+        }
+        sync_detail::spin();
+    }
+    spins.store(static_cast<uint16_t>(cur + (cnt - cur) / 8), std::memory_order_relaxed);
+    return cnt < limit;
 }
 
 void mutexPrivate::unlock()
@@ -82,28 +202,65 @@ void mutexPrivate::unlock()
     uint64_t task = ExecuteCtx::Cur()->task ? reinterpret_cast<uint64_t>(ExecuteCtx::Cur()->task) : GetTid();
     MutexGraph::Instance().RemoveNode(task);
 #endif
+    held_remove(ExecuteCtx::Cur()->task);
+    if (handoff) {
+        unlock_handoff();
+        return;
+    }
     if (l.exchange(sync_detail::UNLOCK, std::memory_order_release) == sync_detail::WAIT) {
         wake();
     }
 }
 
-void mutexPrivate::wait()
+void mutexPrivate::unlock_handoff()
+{
+    int v = sync_detail::LOCK;
+    if (l.compare_exchange_strong(v, sync_detail::UNLOCK, std::memory_order_release, std::memory_order_relaxed)) {
+        return;
+    }
+    wlock.lock();
+    WaitEntry* we = list.Empty() ? nullptr : list.PopFront(&WaitEntry::node);
+    if (we == nullptr) {
+        // the waiter that marked the mutex is not queued yet, it finds it unlocked
+        l.store(sync_detail::UNLOCK, std::memory_order_release);
+        wlock.unlock();
+        return;
+    }
+    // the mutex stays locked for the first waiter, later lockers queue behind the rest
+    l.store(list.Empty() ? sync_detail::LOCK : sync_detail::WAIT, std::memory_order_relaxed);
+    we->lockGranted = true;
+    stat.handoff.fetch_add(1, std::memory_order_relaxed);
+    wake_locked(we);
+}
+
+bool mutexPrivate::wait()
 {
     auto ctx = ExecuteCtx::Cur();
     auto task = ctx->task;
-    if (task == nullptr) {
+    if (ThreadWaitMode(task)) {
+        WaitUntilEntry& wn = ctx->wn;
+        wn.lockGranted = false;
         wlock.lock();
         if (l.load(std::memory_order_relaxed) != sync_detail::WAIT) {
             wlock.unlock();
-            return;
+            return false;
         }
-        list.PushBack(ctx->wn.node);
-        std::unique_lock<std::mutex> lk(ctx->wn.wl);
+        wn.status.store(we_status::INIT, std::memory_order_relaxed);
+        list.PushBack(wn.node);
+        stat.parked.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lk(wn.wl);
         wlock.unlock();
-        ctx->wn.cv.wait(lk);
-        return;
+        if (task != nullptr) {
+            MutexOwnerParked(task, true);
+        }
+        wn.cv.wait(lk, [&wn] { return wn.status.load(std::memory_order_relaxed) == we_status::NOTIFIED; });
+        if (task != nullptr) {
+            MutexOwnerParked(task, false);
+        }
+        return wn.lockGranted;
     } else {
         FFRT_BLOCK_TRACER(task->gid, mtx);
+        task->fq_we.lockGranted = false;
         CoWait([this](TaskCtx* inTask) -> bool {
             wlock.lock();
             if (l.load(std::memory_order_relaxed) != sync_detail::WAIT) {
@@ -111,9 +268,11 @@ void mutexPrivate::wait()
                 return false;
             }
             list.PushBack(inTask->fq_we.node);
+            stat.parked.fetch_add(1, std::memory_order_relaxed);
             wlock.unlock();
             return true;
         });
+        return task->fq_we.lockGranted;
     }
 }
 
@@ -129,10 +288,17 @@ void mutexPrivate::wake()
         wlock.unlock();
         return;
     }
+    wake_locked(we);
+}
+
+// releases wlock, the mutex may be gone once the waiter runs
+void mutexPrivate::wake_locked(WaitEntry* we)
+{
     TaskCtx* task = we->task;
     if (we->weType == 2) {
         WaitUntilEntry* wue = static_cast<WaitUntilEntry*>(we);
         std::unique_lock lk(wue->wl);
+        wue->status.store(we_status::NOTIFIED, std::memory_order_relaxed);
         wlock.unlock();
         wue->cv.notify_one();
     } else {
@@ -140,11 +306,66 @@ void mutexPrivate::wake()
         CoWake(task, false);
     }
 }
+
+void mutexPrivate::get_stat(ffrt_mutex_stat_t* s) const
+{
+    s->contended = stat.contended.load(std::memory_order_relaxed);
+    s->spun = stat.spun.load(std::memory_order_relaxed);
+    s->parked = stat.parked.load(std::memory_order_relaxed);
+    s->handoff = stat.handoff.load(std::memory_order_relaxed);
+}
 } // namespace ffrt
 
 #ifdef __cplusplus
 extern "C" {
 #endif
+API_ATTRIBUTE((visibility("default")))
+int ffrt_mutexattr_init(ffrt_mutexattr_t* attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should not be empty");
+        return ffrt_error_inval;
+    }
+    attr->storage = ffrt_mutex_normal;
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_mutexattr_settype(ffrt_mutexattr_t* attr, int type)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should not be empty");
+        return ffrt_error_inval;
+    }
+    if (type != ffrt_mutex_normal && type != ffrt_mutex_handoff) {
+        FFRT_LOGE("mutex type %d is not supported", type);
+        return ffrt_error_inval;
+    }
+    attr->storage = type;
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_mutexattr_gettype(const ffrt_mutexattr_t* attr, int* type)
+{
+    if (!attr || !type) {
+        FFRT_LOGE("attr and type should not be empty");
+        return ffrt_error_inval;
+    }
+    *type = static_cast<int>(attr->storage);
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_mutexattr_destroy(ffrt_mutexattr_t* attr)
+{
+    if (!attr) {
+        FFRT_LOGE("attr should not be empty");
+        return ffrt_error_inval;
+    }
+    return ffrt_success;
+}
+
 API_ATTRIBUTE((visibility("default")))
 int ffrt_mutex_init(ffrt_mutex_t *mutex, const ffrt_mutexattr_t* attr)
 {
@@ -152,14 +373,11 @@ int ffrt_mutex_init(ffrt_mutex_t *mutex, const ffrt_mutexattr_t* attr)
         FFRT_LOGE("mutex should not be empty");
         return ffrt_error_inval;
     }
-    if (attr != nullptr) {
-        FFRT_LOGE("only support normal mutex");
-        return ffrt_error;
-    }
     static_assert(sizeof(ffrt::mutexPrivate) <= ffrt_mutex_storage_size,
         "size must be less than ffrt_mutex_storage_size");
 
-    new (mutex)ffrt::mutexPrivate();
+    bool handoff = attr != nullptr && attr->storage == ffrt_mutex_handoff;
+    new (mutex)ffrt::mutexPrivate(handoff);
     return ffrt_success;
 }
 
@@ -209,6 +427,18 @@ int ffrt_mutex_destroy(ffrt_mutex_t* mutex)
     p->~mutexPrivate();
     return ffrt_success;
 }
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_mutex_get_stat(ffrt_mutex_t* mutex, ffrt_mutex_stat_t* stat)
+{
+    if (!mutex || !stat) {
+        FFRT_LOGE("mutex and stat should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::mutexPrivate*)mutex;
+    p->get_stat(stat);
+    return ffrt_success;
+}
 #ifdef __cplusplus
 }
 #endif
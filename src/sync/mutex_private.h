@@ -16,6 +16,7 @@
 #ifndef _MUTEX_PRIVATE_H_
 #define _MUTEX_PRIVATE_H_
 
+#include "c/mutex.h"
 #include "sync/sync.h"
 
 #ifdef FFRT_MUTEX_DEADLOCK_CHECK
@@ -95,6 +96,21 @@ public:
 };
 #endif
 
+constexpr int MUTEX_SPIN_MIN = 10; // spins a contended lock tries at least
+constexpr int MUTEX_SPIN_MAX = 1000; // spins a contended lock tries at most, FFRT_MUTEX_SPIN_MAX overrides it
+
+struct MutexStat {
+    std::atomic<uint32_t> contended {0};
+    std::atomic<uint32_t> spun {0};
+    std::atomic<uint32_t> parked {0};
+    std::atomic<uint32_t> handoff {0};
+};
+
+/*
+ * A contended lock spins first, up to twice the spins recent contended locks needed, as long as the owner runs.
+ * Owners switched out in CoWait mark the mutexes they hold, chained through nextHeld from TaskCtx::heldMutex.
+ * In handoff mode an unlock with waiters keeps the mutex locked and grants it to the first one.
+ */
 class mutexPrivate {
     std::atomic<int> l;
 #ifdef FFRT_MUTEX_DEADLOCK_CHECK
@@ -102,23 +118,44 @@ class mutexPrivate {
 #endif
     fast_mutex wlock;
     LinkedList list;
+    mutexPrivate* nextHeld = nullptr;
+    std::atomic<uint16_t> spins {0};
+    std::atomic<bool> ownerParked {false};
+    const bool handoff;
+    MutexStat stat;
 
-    void wait();
+    void lock_contended();
+    bool spin();
+    bool wait();
     void wake();
+    void wake_locked(WaitEntry* we);
+    void unlock_handoff();
+    void held_push(TaskCtx* task);
+    void held_remove(TaskCtx* task);
+
+    friend void MutexOwnerParked(TaskCtx* task, bool parked);
 
 public:
 #ifdef FFRT_MUTEX_DEADLOCK_CHECK
-    mutexPrivate() : l(sync_detail::UNLOCK), owner(0) {}
+    explicit mutexPrivate(bool handoff = false) : l(sync_detail::UNLOCK), owner(0), handoff(handoff) {}
 #else
-    mutexPrivate() : l(sync_detail::UNLOCK) {}
+    explicit mutexPrivate(bool handoff = false) : l(sync_detail::UNLOCK), handoff(handoff) {}
 #endif
     mutexPrivate(mutexPrivate const &) = delete;
     void operator = (mutexPrivate const &) = delete;
 
     bool try_lock();
     void lock();
+    // reacquire by a task a notify moved onto the wait list, it must leave the mutex marked for the others
+    void lock_morphed(TaskCtx* task);
+    // moves a parked task onto the wait list while the mutex is locked, false if the mutex is free
+    bool requeue(TaskCtx* task);
     void unlock();
+    void get_stat(ffrt_mutex_stat_t* s) const;
 };
+
+// called by a task around being switched out
+void MutexOwnerParked(TaskCtx* task, bool parked);
 } // namespace ffrt
 
 #endif
\ No newline at end of file
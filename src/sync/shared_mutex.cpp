@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpp/shared_mutex.h"
+#include <new>
+#include "core/task_ctx.h"
+#include "eu/co_routine.h"
+#include "sync/shared_mutex_private.h"
+#include "util/cpu_topology.h"
+#include "dfx/log/ffrt_log_api.h"
+#include "dfx/trace/ffrt_trace.h"
+
+namespace ffrt {
+namespace {
+uint32_t RwlockSlotNum()
+{
+    static const uint32_t slotNum = [] {
+        uint32_t n = 1;
+        while (n < static_cast<uint32_t>(CpuTopology::Instance().CpuNum()) && n < RWLOCK_SLOT_MAX) {
+            n <<= 1;
+        }
+        return n;
+    }();
+    return slotNum;
+}
+} // namespace
+
+rwlockPrivate::rwlockPrivate() : slots(new RwlockSlot[RwlockSlotNum()]), slotMask(RwlockSlotNum() - 1)
+{
+}
+
+rwlockPrivate::~rwlockPrivate()
+{
+    delete[] slots;
+}
+
+RwlockSlot& rwlockPrivate::cur_slot()
+{
+    return slots[ThreadSlot() & slotMask];
+}
+
+int64_t rwlockPrivate::reader_sum() const
+{
+    int64_t sum = 0;
+    for (uint32_t i = 0; i <= slotMask; i++) {
+        sum += slots[i].readers.load();
+    }
+    return sum;
+}
+
+bool rwlockPrivate::try_rdlock()
+{
+    // pairs with the writer setting RWLOCK_WRITER before summing the slots, one of both sees the other
+    cur_slot().readers.fetch_add(1);
+    if (!(state.load() & RWLOCK_WRITER)) {
+        return true;
+    }
+    reader_leave();
+    return false;
+}
+
+void rwlockPrivate::rdlock()
+{
+    if (try_rdlock()) {
+        return;
+    }
+    // a granted reader is counted by the writer unlock
+    wait(&readers, [this] {
+        if (state.load(std::memory_order_relaxed) & RWLOCK_WRITER) {
+            return true;
+        }
+        cur_slot().readers.fetch_add(1);
+        return false;
+    });
+}
+
+void rwlockPrivate::reader_leave()
+{
+    cur_slot().readers.fetch_sub(1);
+    if (!(state.load() & RWLOCK_WRITER)) {
+        return;
+    }
+    wlock.lock();
+    WaitEntry* we = drainer;
+    if (we == nullptr || reader_sum() != 0) {
+        wlock.unlock();
+        return;
+    }
+    drainer = nullptr;
+    wlock.unlock();
+    wake(we);
+}
+
+bool rwlockPrivate::try_wrlock()
+{
+    wlock.lock();
+    if (state.load(std::memory_order_relaxed) != 0) {
+        wlock.unlock();
+        return false;
+    }
+    state.store(RWLOCK_WRITER);
+    if (reader_sum() != 0) {
+        // readers turned away meanwhile retry under wlock and find the flag gone
+        state.store(0);
+        wlock.unlock();
+        return false;
+    }
+    state.store(RWLOCK_WRITER | RWLOCK_WRITER_OWNED, std::memory_order_relaxed);
+    wlock.unlock();
+    return true;
+}
+
+void rwlockPrivate::wrlock()
+{
+    // a granted writer inherits RWLOCK_WRITER from the unlock
+    wait(&writers, [this] {
+        if (state.load(std::memory_order_relaxed) & RWLOCK_WRITER) {
+            return true;
+        }
+        state.store(RWLOCK_WRITER);
+        return false;
+    });
+    wait(nullptr, [this] { return reader_sum() != 0; });
+    state.store(RWLOCK_WRITER | RWLOCK_WRITER_OWNED, std::memory_order_relaxed);
+}
+
+void rwlockPrivate::unlock()
+{
+    // readers never see the owned bit, it is only set once they are all gone
+    if (state.load(std::memory_order_relaxed) & RWLOCK_WRITER_OWNED) {
+        writer_unlock();
+    } else {
+        reader_leave();
+    }
+}
+
+void rwlockPrivate::writer_unlock()
+{
+    LinkedList batch;
+    int64_t n = 0;
+    wlock.lock();
+    while (!readers.Empty()) {
+        WaitEntry* we = readers.PopFront(&WaitEntry::node);
+        batch.PushBack(we->node);
+        n++;
+    }
+    if (n != 0) {
+        cur_slot().readers.fetch_add(n);
+    }
+    WaitEntry* next = writers.Empty() ? nullptr : writers.PopFront(&WaitEntry::node);
+    state.store(next != nullptr ? RWLOCK_WRITER : 0);
+    wlock.unlock();
+
+    while (!batch.Empty()) {
+        wake(batch.PopFront(&WaitEntry::node));
+    }
+    if (next != nullptr) {
+        wake(next);
+    }
+}
+
+// parks on queue, or as the drainer without one, while cond holds under wlock, false if it never parked
+template <typename Cond>
+bool rwlockPrivate::wait(LinkedList* queue, Cond cond)
+{
+    auto ctx = ExecuteCtx::Cur();
+    auto task = ctx->task;
+    auto enqueue = [this, queue](WaitEntry& we) {
+        if (queue != nullptr) {
+            queue->PushBack(we.node);
+        } else {
+            drainer = &we;
+        }
+    };
+    if (ThreadWaitMode(task)) {
+        WaitUntilEntry& wn = ctx->wn;
+        wlock.lock();
+        if (!cond()) {
+            wlock.unlock();
+            return false;
+        }
+        wn.status.store(we_status::INIT, std::memory_order_relaxed);
+        enqueue(wn);
+        std::unique_lock<std::mutex> lk(wn.wl);
+        wlock.unlock();
+        wn.cv.wait(lk, [&wn] { return wn.status.load(std::memory_order_relaxed) == we_status::NOTIFIED; });
+        return true;
+    }
+    FFRT_BLOCK_TRACER(task->gid, rwl);
+    bool parked = false;
+    CoWait([&](TaskCtx* inTask) -> bool {
+        wlock.lock();
+        if (!cond()) {
+            wlock.unlock();
+            return false;
+        }
+        parked = true;
+        enqueue(inTask->fq_we);
+        wlock.unlock();
+        return true;
+    });
+    return parked;
+}
+
+void rwlockPrivate::wake(WaitEntry* we)
+{
+    if (we->weType == 2) {
+        WaitUntilEntry* wue = static_cast<WaitUntilEntry*>(we);
+        std::unique_lock lk(wue->wl);
+        wue->status.store(we_status::NOTIFIED, std::memory_order_relaxed);
+        wue->cv.notify_one();
+    } else {
+        CoWake(we->task, false);
+    }
+}
+} // namespace ffrt
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+API_ATTRIBUTE((visibility("default")))
+int ffrt_rwlock_init(ffrt_rwlock_t* rwlock, const ffrt_rwlockattr_t* attr)
+{
+    if (!rwlock) {
+        FFRT_LOGE("rwlock should not be empty");
+        return ffrt_error_inval;
+    }
+    if (attr != nullptr) {
+        FFRT_LOGE("only support default rwlock attr");
+        return ffrt_error;
+    }
+    static_assert(sizeof(ffrt::rwlockPrivate) <= ffrt_rwlock_storage_size,
+        "size must be less than ffrt_rwlock_storage_size");
+
+    new (rwlock)ffrt::rwlockPrivate();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_rwlock_wrlock(ffrt_rwlock_t* rwlock)
+{
+    if (!rwlock) {
+        FFRT_LOGE("rwlock should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::rwlockPrivate*)rwlock;
+    p->wrlock();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_rwlock_trywrlock(ffrt_rwlock_t* rwlock)
+{
+    if (!rwlock) {
+        FFRT_LOGE("rwlock should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::rwlockPrivate*)rwlock;
+    return p->try_wrlock() ? ffrt_success : ffrt_error_busy;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_rwlock_rdlock(ffrt_rwlock_t* rwlock)
+{
+    if (!rwlock) {
+        FFRT_LOGE("rwlock should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::rwlockPrivate*)rwlock;
+    p->rdlock();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_rwlock_tryrdlock(ffrt_rwlock_t* rwlock)
+{
+    if (!rwlock) {
+        FFRT_LOGE("rwlock should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::rwlockPrivate*)rwlock;
+    return p->try_rdlock() ? ffrt_success : ffrt_error_busy;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_rwlock_unlock(ffrt_rwlock_t* rwlock)
+{
+    if (!rwlock) {
+        FFRT_LOGE("rwlock should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::rwlockPrivate*)rwlock;
+    p->unlock();
+    return ffrt_success;
+}
+
+API_ATTRIBUTE((visibility("default")))
+int ffrt_rwlock_destroy(ffrt_rwlock_t* rwlock)
+{
+    if (!rwlock) {
+        FFRT_LOGE("rwlock should not be empty");
+        return ffrt_error_inval;
+    }
+    auto p = (ffrt::rwlockPrivate*)rwlock;
+    p->~rwlockPrivate();
+    return ffrt_success;
+}
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SHARED_MUTEX_PRIVATE_H_
+#define _SHARED_MUTEX_PRIVATE_H_
+
+#include <atomic>
+#include "sync/sync.h"
+
+namespace ffrt {
+constexpr int RWLOCK_WRITER = 1; // a writer holds the lock or waits for the readers to leave
+constexpr int RWLOCK_WRITER_OWNED = 2; // the writer holds the lock
+constexpr uint32_t RWLOCK_SLOT_MAX = 64;
+
+// one cache line of reader count, a reader may leave through another slot than it entered
+struct alignas(64) RwlockSlot {
+    std::atomic<int64_t> readers {0};
+};
+
+/*
+ * Readers count themselves in the slot of their thread and only look at the shared state, so concurrent
+ * readers do not bounce a cache line. A writer sets RWLOCK_WRITER, which sends new readers to the queue, and
+ * waits until the slots sum up to zero. Its unlock admits all queued readers at once, counting them on their
+ * behalf, and passes the writer flag to the next queued writer, which then waits for that batch to leave.
+ */
+class rwlockPrivate {
+    std::atomic<int> state {0};
+    fast_mutex wlock;
+    LinkedList readers;
+    LinkedList writers;
+    WaitEntry* drainer = nullptr; // the writer waiting for the readers to leave
+    RwlockSlot* slots;
+    uint32_t slotMask;
+
+    RwlockSlot& cur_slot();
+    int64_t reader_sum() const;
+    void reader_leave();
+    void writer_unlock();
+    template <typename Cond>
+    bool wait(LinkedList* queue, Cond cond);
+    void wake(WaitEntry* we);
+
+public:
+    rwlockPrivate();
+    ~rwlockPrivate();
+    rwlockPrivate(rwlockPrivate const&) = delete;
+    void operator=(rwlockPrivate const&) = delete;
+
+    void wrlock();
+    bool try_wrlock();
+    void rdlock();
+    bool try_rdlock();
+    void unlock();
+};
+} // namespace ffrt
+
+#endif
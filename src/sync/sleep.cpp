@@ -41,7 +41,7 @@ TaskCtx* ExecuteCtxTask()
 
 void sleep_until_impl(const time_point_t& to)
 {
-    if (ExecuteCtxTask() == nullptr) {
+    if (ThreadWaitMode(ExecuteCtxTask())) {
         std::this_thread::sleep_until(to);
         return;
     }
@@ -66,7 +66,7 @@ extern "C" {
 API_ATTRIBUTE((visibility("default")))
 void ffrt_yield()
 {
-    if (ffrt::this_task::ExecuteCtxTask() == nullptr) {
+    if (ffrt::ThreadWaitMode(ffrt::this_task::ExecuteCtxTask())) {
         std::this_thread::yield();
         return;
     }
@@ -30,10 +30,27 @@
 #undef NS_PER_SEC
 #endif
 namespace ffrt {
-bool DelayedWakeup(const time_point_t& to, WaitEntry* we, const std::function<void(WaitEntry*)>& wakeup)
+uint32_t ThreadSlot()
+{
+    static std::atomic<uint32_t> next {0};
+    static thread_local uint32_t slot = next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+static DelayedWorker& GetDelayedWorker()
 {
     static DelayedWorker w;
-    return w.dispatch(to, we, wakeup);
+    return w;
+}
+
+bool DelayedWakeup(const time_point_t& to, WaitEntry* we, const std::function<void(WaitEntry*)>& wakeup)
+{
+    return GetDelayedWorker().dispatch(to, we, wakeup);
+}
+
+bool DelayedRemove(WaitEntry* we)
+{
+    return GetDelayedWorker().cancel(we);
 }
 
 void spin_mutex::lock_contended()
@@ -48,24 +65,13 @@ void spin_mutex::lock_contended()
 }
 
 #ifndef _MSC_VER
-static void spin()
-{
-#if defined(__x86_64__)
-    asm volatile("pause");
-#elif defined(__aarch64__)
-    asm volatile("isb sy");
-#elif defined(__arm__)
-    asm volatile("yield");
-#endif
-}
-
 void fast_mutex::lock_contended()
 {
     int v;
     // lightly contended
     for (uint32_t n = static_cast<uint32_t>(1 + rand() % 4); n <= 64; n <<= 1) {
         for (uint32_t i = 0; i < n; ++i) {
-            spin();
+            sync_detail::spin();
         }
         v = __atomic_load_n(&l, __ATOMIC_RELAXED);
         if (v == sync_detail::WAIT) {
@@ -33,6 +33,18 @@ namespace sync_detail {
 const int UNLOCK = 0;
 const int LOCK = 1;
 const int WAIT = 2;
+
+// hint the cpu that this is a busy wait loop
+static inline void spin()
+{
+#if defined(__x86_64__)
+    asm volatile("pause");
+#elif defined(__aarch64__)
+    asm volatile("isb sy");
+#elif defined(__arm__)
+    asm volatile("yield");
+#endif
+}
 } // namespace sync_detail
 
 class spin_mutex {
@@ -92,6 +104,11 @@ public:
 };
 #endif
 
+// a small number per thread handed out in creation order, spreads threads over striped counters
+uint32_t ThreadSlot();
+
 bool DelayedWakeup(const time_point_t& to, WaitEntry* we, const std::function<void(WaitEntry*)>& wakeup);
+// cancels an armed DelayedWakeup, false if its callback already ran or is about to run
+bool DelayedRemove(WaitEntry* we);
 } // namespace ffrt
 #endif
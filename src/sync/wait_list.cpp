@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sync/wait_list.h"
+#include <vector>
+
+namespace ffrt {
+size_t WaitList::PopLocked(LinkedList& batch, size_t num)
+{
+    size_t n = 0;
+    for (; n < num && !list.Empty(); n++) {
+        WaitEntry* we = list.PopFront(&WaitEntry::node);
+        batch.PushBack(we->node);
+    }
+    return n;
+}
+
+void WaitList::Wake(LinkedList& batch)
+{
+    std::vector<TaskCtx*> tasks;
+    while (!batch.Empty()) {
+        WaitEntry* we = batch.PopFront(&WaitEntry::node);
+        if (we->weType == 2) {
+            WaitUntilEntry* wue = static_cast<WaitUntilEntry*>(we);
+            std::unique_lock lk(wue->wl);
+            wue->status.store(we_status::NOTIFIED, std::memory_order_relaxed);
+            wue->cv.notify_one();
+        } else {
+            tasks.push_back(we->task);
+        }
+    }
+    if (!tasks.empty()) {
+        CoWakeBatch(tasks);
+    }
+}
+} // namespace ffrt
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FFRT_WAIT_LIST_H
+#define FFRT_WAIT_LIST_H
+
+#include <mutex>
+#include "sync/sync.h"
+#include "core/task_ctx.h"
+#include "eu/co_routine.h"
+#include "dfx/trace/ffrt_trace.h"
+
+namespace ffrt {
+/*
+ * Waiters of a primitive whose wakeup hands them what they waited for, so a woken waiter never checks again.
+ * Tasks are switched out with CoWait, threads block on the condition variable of their ExecuteCtx.
+ */
+class WaitList {
+public:
+    fast_mutex lock;
+
+    // parks the caller while cond holds under lock, false if it did not park
+    template <typename Cond>
+    bool Wait(Cond&& cond);
+
+    bool Empty() const
+    {
+        return list.Empty();
+    }
+
+    // moves up to num waiters in arrival order to batch, lock must be held
+    size_t PopLocked(LinkedList& batch, size_t num = SIZE_MAX);
+
+    // wakes all tasks of the batch at once, the waiters may be gone once this returns
+    static void Wake(LinkedList& batch);
+
+private:
+    LinkedList list;
+};
+
+template <typename Cond>
+bool WaitList::Wait(Cond&& cond)
+{
+    auto ctx = ExecuteCtx::Cur();
+    auto task = ctx->task;
+    if (ThreadWaitMode(task)) {
+        WaitUntilEntry& wn = ctx->wn;
+        lock.lock();
+        if (!cond()) {
+            lock.unlock();
+            return false;
+        }
+        wn.status.store(we_status::INIT, std::memory_order_relaxed);
+        list.PushBack(wn.node);
+        std::unique_lock<std::mutex> lk(wn.wl);
+        lock.unlock();
+        wn.cv.wait(lk, [&wn] { return wn.status.load(std::memory_order_relaxed) == we_status::NOTIFIED; });
+        return true;
+    }
+    FFRT_BLOCK_TRACER(task->gid, wtl);
+    bool parked = false;
+    CoWait([&](TaskCtx* inTask) -> bool {
+        lock.lock();
+        if (!cond()) {
+            lock.unlock();
+            return false;
+        }
+        parked = true;
+        list.PushBack(inTask->fq_we.node);
+        lock.unlock();
+        return true;
+    });
+    return parked;
+}
+} // namespace ffrt
+#endif
@@ -67,11 +67,12 @@ void WaitQueue::SuspendAndWait(mutexPrivate* lk)
 {
     ExecuteCtx* ctx = ExecuteCtx::Cur();
     TaskCtx* task = ctx->task;
-    if (ctx->task == nullptr) {
+    if (ThreadWaitMode(task)) {
         ThreadWait(&ctx->wn, lk);
         return;
     }
     task->wue = new WaitUntilEntry(task);
+    task->wue->morphMutex = lk;
     FFRT_BLOCK_TRACER(task->gid, cnd);
     CoWait([&](TaskCtx* inTask) -> bool {
         wqlock.lock();
@@ -80,9 +81,14 @@ void WaitQueue::SuspendAndWait(mutexPrivate* lk)
         wqlock.unlock();
         return true;
     });
+    bool morphed = task->wue->morphed;
     delete task->wue;
     task->wue = nullptr;
-    lk->lock();
+    if (morphed) {
+        lk->lock_morphed(task);
+    } else {
+        lk->lock();
+    }
 }
 
 bool WeTimeoutProc(WaitUntilEntry* wue)
@@ -103,7 +109,7 @@ bool WaitQueue::SuspendAndWaitUntil(mutexPrivate* lk, const TimePoint& tp) noexc
     bool ret = false;
     ExecuteCtx* ctx = ExecuteCtx::Cur();
     TaskCtx* task = ctx->task;
-    if (task == nullptr) {
+    if (ThreadWaitMode(task)) {
         return ThreadWaitUntil(&ctx->wn, lk, tp);
     }
 
@@ -116,7 +122,7 @@ bool WaitQueue::SuspendAndWaitUntil(mutexPrivate* lk, const TimePoint& tp) noexc
         if (!WeTimeoutProc(wue)) {
             return;
         }
-        FFRT_LOGD("task(%s) timeout out", task->label.c_str());
+        FFRT_LOGD("task(%s) timeout out", task->GetLabel().c_str());
         CoWake(task, true);
     });
     FFRT_BLOCK_TRACER(task->gid, cnt);
@@ -160,6 +166,28 @@ bool WaitQueue::WeNotifyProc(WaitUntilEntry* we)
     return true;
 }
 
+void WaitQueue::CancelTimeout(WaitUntilEntry* we)
+{
+    // the timeout callback would only find the entry notified and delete it
+    if (we->hasWaitTime && DelayedRemove(we)) {
+        delete we;
+    }
+}
+
+// waking a task that would only park again on the mutex is left to the unlock of the mutex
+bool WaitQueue::Morph(WaitUntilEntry* we)
+{
+    if (we->morphMutex == nullptr) {
+        return false;
+    }
+    we->morphed = true;
+    if (we->morphMutex->requeue(we->task)) {
+        return true;
+    }
+    we->morphed = false;
+    return false;
+}
+
 void WaitQueue::NotifyOne() noexcept
 {
     wqlock.lock();
@@ -169,6 +197,10 @@ void WaitQueue::NotifyOne() noexcept
     }
     WaitUntilEntry* we = pop_front();
     TaskCtx* task = we->task;
+    if (Morph(we)) {
+        wqlock.unlock();
+        return;
+    }
     if (we->weType == 2) {
         std::unique_lock<std::mutex> lk(we->wl);
         wqlock.unlock();
@@ -178,6 +210,7 @@ void WaitQueue::NotifyOne() noexcept
         if (!WeNotifyProc(we)) {
             return;
         }
+        CancelTimeout(we);
         CoWake(task, false);
     }
 }
@@ -187,6 +220,9 @@ void WaitQueue::NotifyAll() noexcept
     while (!empty()) {
         WaitUntilEntry* we = pop_front();
         TaskCtx* task = we->task;
+        if (Morph(we)) {
+            continue;
+        }
         if (we->weType == 2) {
             std::unique_lock<std::mutex> lk(we->wl);
             wqlock.unlock();
@@ -196,6 +232,7 @@ void WaitQueue::NotifyAll() noexcept
             if (!WeNotifyProc(we)) {
                 continue;
             }
+            CancelTimeout(we);
             CoWake(task, false);
         }
         wqlock.lock();
@@ -90,6 +90,9 @@ public:
     }
 
 private:
+    void CancelTimeout(WaitUntilEntry* we);
+    bool Morph(WaitUntilEntry* we);
+
     inline bool empty() const
     {
         return (whead->next == whead);
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "util/cpu_topology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <dirent.h>
+#include <sched.h>
+#include "dfx/log/ffrt_log_api.h"
+
+namespace ffrt {
+namespace {
+std::string ReadLine(const std::string& path)
+{
+    std::ifstream in(path);
+    std::string line;
+    if (in) {
+        std::getline(in, line);
+    }
+    return line;
+}
+
+// node numbers found under <root>/node, sorted
+std::vector<int> ListNodes(const std::string& root)
+{
+    std::vector<int> nodes;
+    DIR* dir = opendir((root + "/node").c_str());
+    if (dir == nullptr) {
+        return nodes;
+    }
+    while (struct dirent* ent = readdir(dir)) {
+        const char* name = ent->d_name;
+        if (strncmp(name, "node", 4) != 0 || name[4] < '0' || name[4] > '9') {
+            continue;
+        }
+        nodes.push_back(atoi(name + 4));
+    }
+    closedir(dir);
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+}
+} // namespace
+
+std::vector<int> CpuTopology::ParseCpuList(const std::string& list)
+{
+    std::vector<int> ret;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string part = list.substr(pos, end - pos);
+        pos = end + 1;
+
+        char* next = nullptr;
+        long first = strtol(part.c_str(), &next, 10);
+        if (next == part.c_str() || first < 0) {
+            continue;
+        }
+        long last = first;
+        if (*next == '-') {
+            const char* lastStr = next + 1;
+            last = strtol(lastStr, &next, 10);
+            if (next == lastStr || last < first) {
+                continue;
+            }
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            ret.push_back(static_cast<int>(cpu));
+        }
+    }
+    std::sort(ret.begin(), ret.end());
+    ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+    return ret;
+}
+
+CpuTopology::CpuTopology(const std::string& root, bool allowedOnly)
+{
+    cpus = ParseCpuList(ReadLine(root + "/cpu/online"));
+    if (cpus.empty()) {
+        unsigned int num = std::max(1U, std::thread::hardware_concurrency());
+        for (unsigned int i = 0; i < num; i++) {
+            cpus.push_back(static_cast<int>(i));
+        }
+    }
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (allowedOnly && sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        std::vector<int> allowed;
+        for (int cpu : cpus) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &mask)) {
+                allowed.push_back(cpu);
+            }
+        }
+        if (!allowed.empty()) {
+            cpus.swap(allowed);
+        }
+    }
+
+    cpuLlc.assign(cpus.back() + 1, -1);
+    cpuNode.assign(cpus.back() + 1, -1);
+    ReadNodes(root);
+    ReadLlcs(root);
+    FFRT_LOGI("%d cpus, %d llc groups, %d numa nodes", CpuNum(), LlcNum(), NodeNum());
+}
+
+void CpuTopology::ReadNodes(const std::string& root)
+{
+    std::vector<std::vector<int>> groups;
+    for (int n : ListNodes(root)) {
+        std::vector<int> group;
+        for (int cpu : ParseCpuList(ReadLine(root + "/node/node" + std::to_string(n) + "/cpulist"))) {
+            if (cpu < static_cast<int>(cpuNode.size()) && cpuNode[cpu] == -1 &&
+                std::binary_search(cpus.begin(), cpus.end(), cpu)) {
+                cpuNode[cpu] = 0;
+                group.push_back(cpu);
+            }
+        }
+        if (!group.empty()) {
+            groups.push_back(std::move(group));
+        }
+    }
+
+    // cpus no node claims go to the first one
+    std::vector<int> rest;
+    for (int cpu : cpus) {
+        if (cpuNode[cpu] == -1) {
+            rest.push_back(cpu);
+        }
+    }
+    if (groups.empty()) {
+        groups.push_back(std::move(rest));
+    } else {
+        groups[0].insert(groups[0].end(), rest.begin(), rest.end());
+        std::sort(groups[0].begin(), groups[0].end());
+    }
+
+    std::sort(groups.begin(), groups.end(),
+        [](const std::vector<int>& a, const std::vector<int>& b) { return a.front() < b.front(); });
+    for (size_t node = 0; node < groups.size(); node++) {
+        for (int cpu : groups[node]) {
+            cpuNode[cpu] = static_cast<int>(node);
+        }
+    }
+    nodeCpus.swap(groups);
+}
+
+void CpuTopology::ReadLlcs(const std::string& root)
+{
+    for (int cpu : cpus) {
+        if (cpuLlc[cpu] != -1) {
+            continue;
+        }
+
+        // the highest data or unified cache level is the last level cache
+        std::string cacheDir = root + "/cpu/cpu" + std::to_string(cpu) + "/cache/index";
+        int llcLevel = 0;
+        std::string shared;
+        for (int index = 0;; index++) {
+            std::string dir = cacheDir + std::to_string(index);
+            std::string level = ReadLine(dir + "/level");
+            if (level.empty()) {
+                break;
+            }
+            if (ReadLine(dir + "/type") == "Instruction" || atoi(level.c_str()) <= llcLevel) {
+                continue;
+            }
+            llcLevel = atoi(level.c_str());
+            shared = ReadLine(dir + "/shared_cpu_list");
+        }
+
+        // a cache shared across nodes is split along them, a missing one is the whole node
+        int node = cpuNode[cpu];
+        std::vector<int> group;
+        std::vector<int> members = shared.empty() ? nodeCpus[node] : ParseCpuList(shared);
+        for (int member : members) {
+            if (member < static_cast<int>(cpuLlc.size()) && cpuNode[member] == node && cpuLlc[member] == -1) {
+                group.push_back(member);
+            }
+        }
+        if (std::find(group.begin(), group.end(), cpu) == group.end()) {
+            group.insert(std::lower_bound(group.begin(), group.end(), cpu), cpu);
+        }
+
+        int llc = static_cast<int>(llcCpus.size());
+        for (int member : group) {
+            cpuLlc[member] = llc;
+        }
+        llcCpus.push_back(std::move(group));
+        llcNode.push_back(node);
+    }
+}
+
+int CpuTopology::LlcOfCpu(int cpu) const
+{
+    if (cpu < 0 || cpu >= static_cast<int>(cpuLlc.size()) || cpuLlc[cpu] < 0) {
+        return 0;
+    }
+    return cpuLlc[cpu];
+}
+
+int CpuTopology::NodeOfCpu(int cpu) const
+{
+    if (cpu < 0 || cpu >= static_cast<int>(cpuNode.size()) || cpuNode[cpu] < 0) {
+        return 0;
+    }
+    return cpuNode[cpu];
+}
+
+int CpuTopology::CurrentLlc() const
+{
+    return llcCpus.size() > 1 ? LlcOfCpu(sched_getcpu()) : 0;
+}
+
+int CpuTopology::CurrentNode() const
+{
+    return nodeCpus.size() > 1 ? NodeOfCpu(sched_getcpu()) : 0;
+}
+} // namespace ffrt
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FFRT_CPU_TOPOLOGY_H
+#define FFRT_CPU_TOPOLOGY_H
+
+#include <string>
+#include <vector>
+
+namespace ffrt {
+constexpr const char* SYSFS_SYSTEM_ROOT = "/sys/devices/system";
+constexpr int NUMA_NODE_SLOT_NUM = 8; // per node caches keep this many slots, further nodes share them
+
+/*
+ * Cpus usable by the process grouped by last level cache and by numa node, read from
+ * <root>/cpu/online, <root>/cpu/cpuN/cache/indexK and <root>/node/nodeN/cpulist.
+ * Llc and node ids are dense indexes in the order of their lowest cpu. Missing cache information makes
+ * every node one llc group, missing node information makes the machine one node.
+ */
+class CpuTopology {
+public:
+    static CpuTopology& Instance()
+    {
+        static CpuTopology ins(SYSFS_SYSTEM_ROOT, true);
+        return ins;
+    }
+
+    // allowedOnly leaves out the cpus the calling thread may not run on
+    CpuTopology(const std::string& root, bool allowedOnly);
+
+    // "0-3,8,10-11" to {0, 1, 2, 3, 8, 10, 11}, malformed parts are skipped
+    static std::vector<int> ParseCpuList(const std::string& list);
+
+    int CpuNum() const
+    {
+        return static_cast<int>(cpus.size());
+    }
+
+    int LlcNum() const
+    {
+        return static_cast<int>(llcCpus.size());
+    }
+
+    int NodeNum() const
+    {
+        return static_cast<int>(nodeCpus.size());
+    }
+
+    const std::vector<int>& Cpus() const
+    {
+        return cpus;
+    }
+
+    const std::vector<int>& LlcCpus(int llc) const
+    {
+        return llcCpus[llc];
+    }
+
+    const std::vector<int>& NodeCpus(int node) const
+    {
+        return nodeCpus[node];
+    }
+
+    int NodeOfLlc(int llc) const
+    {
+        return llcNode[llc];
+    }
+
+    // unknown cpus belong to llc 0 and node 0
+    int LlcOfCpu(int cpu) const;
+    int NodeOfCpu(int cpu) const;
+
+    // where the calling thread runs right now
+    int CurrentLlc() const;
+    int CurrentNode() const;
+
+    int CurrentNodeSlot() const
+    {
+        return nodeCpus.size() > 1 ? CurrentNode() % NUMA_NODE_SLOT_NUM : 0;
+    }
+
+private:
+    void ReadNodes(const std::string& root);
+    void ReadLlcs(const std::string& root);
+
+    std::vector<int> cpus; // sorted
+    std::vector<int> cpuLlc; // indexed by cpu id, -1 for unusable cpus
+    std::vector<int> cpuNode;
+    std::vector<std::vector<int>> llcCpus;
+    std::vector<int> llcNode;
+    std::vector<std::vector<int>> nodeCpus;
+};
+} // namespace ffrt
+#endif
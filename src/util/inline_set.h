@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FFRT_INLINE_SET_HPP
+#define FFRT_INLINE_SET_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+
+namespace ffrt {
+template <typename T>
+struct InlineSetIdentity {
+    T operator()(const T& v) const
+    {
+        return v;
+    }
+};
+
+/*
+ * Unordered set of a few trivially copyable values (pointers mostly) kept in a flat array, unique by KeyOf(value).
+ * The first N elements live inline and are looked up linearly, which beats hashing as long as the set stays small.
+ * Beyond that the array moves to the heap and doubles, and a hash index from key to position takes over lookups.
+ * Erase moves the last element into the hole.
+ */
+template <typename T, uint32_t N, typename KeyOf = InlineSetIdentity<T>>
+class InlineSet {
+    static_assert(std::is_trivially_copyable_v<T>, "InlineSet only holds trivially copyable values");
+    static_assert(N > 0, "InlineSet needs inline capacity");
+    using Key = std::invoke_result_t<KeyOf, const T&>;
+
+public:
+    InlineSet() = default;
+    InlineSet(const InlineSet&) = delete;
+    InlineSet& operator=(const InlineSet&) = delete;
+
+    const T* begin() const
+    {
+        return Data();
+    }
+
+    const T* end() const
+    {
+        return Data() + num;
+    }
+
+    uint32_t size() const
+    {
+        return num;
+    }
+
+    bool empty() const
+    {
+        return num == 0;
+    }
+
+    const T* find_key(const Key& k) const
+    {
+        const T* d = Data();
+        if (index) {
+            auto it = index->find(k);
+            return it == index->end() ? end() : d + it->second;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            if (KeyOf()(d[i]) == k) {
+                return d + i;
+            }
+        }
+        return end();
+    }
+
+    const T* find(const T& v) const
+    {
+        const T* it = find_key(KeyOf()(v));
+        return it != end() && *it == v ? it : end();
+    }
+
+    // fails for a value whose key is in the set already
+    bool insert(const T& v)
+    {
+        Key k = KeyOf()(v);
+        if (find_key(k) != end()) {
+            return false;
+        }
+        if (num == Capacity()) {
+            Grow();
+        }
+        Data()[num] = v;
+        if (index) {
+            index->emplace(k, num);
+        }
+        num++;
+        return true;
+    }
+
+    bool erase(const T& v)
+    {
+        const T* it = find(v);
+        if (it == end()) {
+            return false;
+        }
+        T* d = Data();
+        uint32_t pos = static_cast<uint32_t>(it - d);
+        if (index) {
+            index->erase(KeyOf()(v));
+            if (pos != num - 1) {
+                (*index)[KeyOf()(d[num - 1])] = pos;
+            }
+        }
+        d[pos] = d[num - 1];
+        num--;
+        return true;
+    }
+
+    void clear()
+    {
+        num = 0;
+        if (index) {
+            index->clear();
+        }
+    }
+
+private:
+    T* Data()
+    {
+        return heap ? heap.get() : inlineBuf;
+    }
+
+    const T* Data() const
+    {
+        return heap ? heap.get() : inlineBuf;
+    }
+
+    uint32_t Capacity() const
+    {
+        return heap ? heapCap : N;
+    }
+
+    void Grow()
+    {
+        uint32_t cap = Capacity() * 2;
+        std::unique_ptr<T[]> buf(new T[cap]);
+        std::memcpy(buf.get(), Data(), sizeof(T) * num);
+        heap = std::move(buf);
+        heapCap = cap;
+        if (!index) {
+            index = std::make_unique<std::unordered_map<Key, uint32_t>>();
+            for (uint32_t i = 0; i < num; i++) {
+                index->emplace(KeyOf()(heap[i]), i);
+            }
+        }
+    }
+
+    T inlineBuf[N];
+    uint32_t num = 0;
+    uint32_t heapCap = 0;
+    std::unique_ptr<T[]> heap;
+    std::unique_ptr<std::unordered_map<Key, uint32_t>> index;
+};
+} // namespace ffrt
+#endif
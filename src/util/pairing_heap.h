@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FFRT_PAIRING_HEAP_H
+#define FFRT_PAIRING_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace ffrt {
+struct PairingHeapNode {
+    PairingHeapNode* child = nullptr;
+    PairingHeapNode* sibling = nullptr;
+    PairingHeapNode* prev = nullptr; // parent for the first child, left sibling otherwise, null for the root
+};
+
+/*
+ * Intrusive min pairing heap: O(1) push and meld, O(log n) amortized pop and decrease key. Elements embed a
+ * PairingHeapNode, Less compares two elements.
+ */
+template <typename T, PairingHeapNode T::*Member, typename Less>
+class PairingHeap {
+public:
+    bool Empty() const
+    {
+        return root == nullptr;
+    }
+
+    T* Top() const
+    {
+        return root == nullptr ? nullptr : Owner(root);
+    }
+
+    void Push(T* elem)
+    {
+        PairingHeapNode* node = &(elem->*Member);
+        node->child = nullptr;
+        node->sibling = nullptr;
+        node->prev = nullptr;
+        root = root == nullptr ? node : Meld(root, node);
+        root->prev = nullptr;
+    }
+
+    bool Contains(const T* elem) const
+    {
+        const PairingHeapNode* node = &(elem->*Member);
+        return node == root || node->prev != nullptr;
+    }
+
+    // the key of elem was lowered, elem must be in the heap
+    void DecreaseKey(T* elem)
+    {
+        PairingHeapNode* node = &(elem->*Member);
+        if (node == root) {
+            return;
+        }
+        // cut the subtree of node and meld it back with the root
+        if (node->prev->child == node) {
+            node->prev->child = node->sibling;
+        } else {
+            node->prev->sibling = node->sibling;
+        }
+        if (node->sibling != nullptr) {
+            node->sibling->prev = node->prev;
+        }
+        node->sibling = nullptr;
+        node->prev = nullptr;
+        root = Meld(root, node);
+        root->prev = nullptr;
+    }
+
+    T* Pop()
+    {
+        if (root == nullptr) {
+            return nullptr;
+        }
+        PairingHeapNode* top = root;
+        root = MergePairs(top->child);
+        if (root != nullptr) {
+            root->prev = nullptr;
+        }
+        top->child = nullptr;
+        return Owner(top);
+    }
+
+private:
+    static T* Owner(PairingHeapNode* node)
+    {
+        auto offset = reinterpret_cast<uintptr_t>(&(reinterpret_cast<T*>(0)->*Member));
+        return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(node) - offset);
+    }
+
+    static PairingHeapNode* Meld(PairingHeapNode* a, PairingHeapNode* b)
+    {
+        if (Less()(Owner(b), Owner(a))) {
+            std::swap(a, b);
+        }
+        b->sibling = a->child;
+        if (a->child != nullptr) {
+            a->child->prev = b;
+        }
+        b->prev = a;
+        a->child = b;
+        return a;
+    }
+
+    // two pass merge of a child list: meld pairs left to right, then fold the results right to left
+    static PairingHeapNode* MergePairs(PairingHeapNode* first)
+    {
+        PairingHeapNode* paired = nullptr;
+        while (first != nullptr) {
+            PairingHeapNode* a = first;
+            PairingHeapNode* b = a->sibling;
+            if (b == nullptr) {
+                a->sibling = paired;
+                paired = a;
+                break;
+            }
+            first = b->sibling;
+            a->sibling = nullptr;
+            b->sibling = nullptr;
+            PairingHeapNode* m = Meld(a, b);
+            m->sibling = paired;
+            paired = m;
+        }
+
+        PairingHeapNode* merged = nullptr;
+        while (paired != nullptr) {
+            PairingHeapNode* next = paired->sibling;
+            paired->sibling = nullptr;
+            merged = merged == nullptr ? paired : Meld(merged, paired);
+            paired = next;
+        }
+        return merged;
+    }
+
+    PairingHeapNode* root = nullptr;
+};
+} // namespace ffrt
+#endif
@@ -17,225 +17,617 @@
 #define UTIL_SLAB_HPP
 
 #include <new>
+#include <array>
 #include <vector>
 #include <mutex>
-#ifdef FFRT_BBOX_ENABLE
+#include <algorithm>
 #include <unordered_set>
-#endif
+#include <cstdio>
 #ifndef _MSC_VER
 #include <sys/mman.h>
+#include <unistd.h>
 #endif
+#include "internal_inc/osal.h"
 #include "sync/sync.h"
+#include "util/cpu_topology.h"
 
 namespace ffrt {
 const std::size_t BatchAllocSize = 0.5 * 1024 * 1024;
+constexpr std::size_t SLAB_ALIGN = 16;
+constexpr std::size_t MAGAZINE_BYTES = 64 * 1024;
+constexpr std::size_t MAGAZINE_MAX_ROUNDS = 64;
+constexpr std::size_t TRIM_WATERMARK_CHUNKS = 4;
 
-template <typename T, size_t MmapSz = BatchAllocSize>
-class SimpleAllocator {
+struct SlabStats {
+    std::size_t objSize = 0;
+    std::size_t chunkSize = 0;
+    std::size_t chunkNum = 0; // chunks currently mapped
+    std::size_t reservedBytes = 0; // bytes currently mapped
+    std::size_t carvedObjs = 0; // objects carved from the mapped chunks, cached or in use
+    std::size_t depotObjs = 0; // free objects cached in the global depot
+    std::size_t releasedChunks = 0; // chunks returned to the os so far
+};
+
+/*
+ * Slab allocator with per-thread magazines (Bonwick & Adams, "Magazines and Vmem").
+ * A thread allocates from and frees to its two magazines without any lock, the locked depot is only
+ * visited to exchange a whole magazine or to carve a magazine of objects out of an mmap'd chunk.
+ * Chunks whose objects all came back to the depot are unmapped once the depot caches too much.
+ * The depot keeps full magazines and the chunk being carved per numa node of the thread handing them in, so an
+ * allocating thread gets objects whose pages it or its node neighbours touched first.
+ * Every Tag has a single instance which is never destroyed, exiting threads flush their magazines into it.
+ */
+template <typename Tag>
+class MagazineSlab {
 public:
-    SimpleAllocator(SimpleAllocator const&) = delete;
-    void operator=(SimpleAllocator const&) = delete;
+    // align has to be a power of two, objects are aligned to it and to SLAB_ALIGN
+    MagazineSlab(std::size_t size, std::size_t chunk, std::size_t align = SLAB_ALIGN)
+        : objSize((size + std::max(align, SLAB_ALIGN) - 1) & ~(std::max(align, SLAB_ALIGN) - 1)),
+          chunkSize(RoundUpToPage(std::max(chunk, objSize))),
+          rounds(std::clamp<std::size_t>(MAGAZINE_BYTES / objSize, 1, MAGAZINE_MAX_ROUNDS))
+    {
+    }
+    MagazineSlab(const MagazineSlab&) = delete;
+    MagazineSlab& operator=(const MagazineSlab&) = delete;
 
-    static SimpleAllocator<T>* instance()
+    void* Alloc()
     {
-        static SimpleAllocator<T> ins;
-        return &ins;
+        ThreadCache& tc = cache;
+        if (likely(tc.loaded != nullptr && tc.loaded->num > 0)) {
+            return tc.loaded->Objs()[--tc.loaded->num];
+        }
+        return AllocSlow(tc);
     }
 
-    // NOTE: call constructor after allocMem
-    static T* allocMem()
+    void Free(void* p)
     {
-        return instance()->alloc();
+        ThreadCache& tc = cache;
+        if (likely(tc.loaded != nullptr && tc.loaded->num < rounds)) {
+            tc.loaded->Objs()[tc.loaded->num++] = p;
+            return;
+        }
+        FreeSlow(tc, p);
     }
 
-    // NOTE: call destructor before freeMem
-    static void freeMem(T* t)
+    // returns the bytes given back to the os
+    std::size_t Trim()
     {
-        t->~T();
-        instance()->free(t);
+        std::lock_guard lg(depotLock);
+        return TrimLocked();
     }
 
-    // only used for BBOX
-    static std::vector<T*> getUnfreedMem()
+    SlabStats GetStats()
     {
-        return instance()->getUnfreed();
+        std::lock_guard lg(depotLock);
+        SlabStats stats;
+        stats.objSize = objSize;
+        stats.chunkSize = chunkSize;
+        stats.chunkNum = chunks.size();
+        stats.reservedBytes = chunks.size() * chunkSize;
+        stats.carvedObjs = carvedObjs;
+        stats.depotObjs = depotObjs;
+        stats.releasedChunks = releasedChunks;
+        return stats;
     }
+
+    // only used for BBOX, magazines of other threads are read without synchronization
+    std::vector<void*> GetUnfreed()
+    {
+        std::lock_guard lg(depotLock);
+        std::unordered_set<void*> freed;
+        auto collect = [&freed](Magazine* m) {
+            for (std::size_t i = 0; m != nullptr && i < m->num; i++) {
+                freed.insert(m->Objs()[i]);
+            }
+        };
+        for (Magazine* head : fullMags) {
+            for (Magazine* m = head; m != nullptr; m = m->next) {
+                collect(m);
+            }
+        }
+        for (ThreadCache* tc = caches; tc != nullptr; tc = tc->next) {
+            collect(tc->loaded);
+            collect(tc->previous);
+        }
+
+        std::vector<void*> ret;
+        for (const auto& c : chunks) {
+            std::size_t carved = CarvedIn(c.base);
+            for (std::size_t i = 0; i < carved; i++) {
+                void* p = c.base + i * objSize;
+                if (freed.find(p) == freed.end()) {
+                    ret.push_back(p);
+                }
+            }
+        }
+        return ret;
+    }
+
 private:
-#ifdef MUTEX_PERF // Mutex Lock&Unlock Cycles Statistic
-    xx::mutex lock {"SimpleAllocator::lock"};
+    struct Magazine {
+        Magazine* next = nullptr;
+        std::size_t num = 0;
+
+        void** Objs()
+        {
+            return reinterpret_cast<void**>(this + 1);
+        }
+    };
+
+    struct ThreadCache {
+        ~ThreadCache()
+        {
+            if (owner != nullptr) {
+                owner->Detach(*this);
+            }
+            exited = true;
+        }
+
+        MagazineSlab* owner = nullptr;
+        bool exited = false; // freed by a later thread_local destructor, bypass the cache
+        Magazine* loaded = nullptr;
+        Magazine* previous = nullptr; // always full or empty
+        ThreadCache* prev = nullptr;
+        ThreadCache* next = nullptr;
+    };
+
+    struct Chunk {
+        char* base;
+    };
+
+    static inline thread_local ThreadCache cache;
+
+    static std::size_t RoundUpToPage(std::size_t size)
+    {
+#ifndef _MSC_VER
+        std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
 #else
-    fast_mutex lock;
-#endif
-    std::vector<T*> primaryCache;
-#ifdef FFRT_BBOX_ENABLE
-    std::unordered_set<T*> secondaryCache;
+        std::size_t page = 4 * 1024;
 #endif
-    T* basePtr = nullptr;
-    uint32_t count = 0;
+        return (size + page - 1) / page * page;
+    }
 
-    std::vector<T*> getUnfreed()
+    std::size_t ObjsPerChunk() const
     {
-        lock.lock();
-        std::vector<T*> ret;
-#ifdef FFRT_BBOX_ENABLE
-        ret.reserve(MmapSz / sizeof(T) + secondaryCache.size());
-        for (std::size_t i = 0; i < MmapSz / sizeof(T); ++i) {
-            if (basePtr != nullptr &&
-                std::find(primaryCache.begin(), primaryCache.end(), &basePtr[i]) == primaryCache.end()) {
-                ret.push_back(&basePtr[i]);
+        return chunkSize / objSize;
+    }
+
+    static int CurrentNode()
+    {
+        return CpuTopology::Instance().CurrentNodeSlot();
+    }
+
+    bool IsBump(const char* base) const
+    {
+        return std::find(bumpBase.begin(), bumpBase.end(), base) != bumpBase.end();
+    }
+
+    std::size_t CarvedIn(const char* base) const
+    {
+        for (int node = 0; node < NUMA_NODE_SLOT_NUM; node++) {
+            if (bumpBase[node] == base) {
+                return bumpCarved[node];
             }
         }
-        for (auto ite = secondaryCache.cbegin(); ite != secondaryCache.cend(); ite++) {
-            ret.push_back(*ite);
+        return ObjsPerChunk();
+    }
+
+    Magazine* NewMagazine()
+    {
+        if (emptyMags != nullptr) {
+            Magazine* m = emptyMags;
+            emptyMags = m->next;
+            m->next = nullptr;
+            return m;
         }
-#endif
-        lock.unlock();
-        return ret;
+        void* mem = ::operator new(sizeof(Magazine) + rounds * sizeof(void*), std::nothrow);
+        return mem == nullptr ? nullptr : new (mem) Magazine();
     }
 
-    void init()
+    void PutMagazine(Magazine* m, int node)
     {
-        basePtr = reinterpret_cast<T*>(::operator new(MmapSz));
-        count = MmapSz / sizeof(T);
-        primaryCache.reserve(count);
-        for (std::size_t i = 0; i < count; ++i) {
-            primaryCache.push_back(&basePtr[i]);
+        if (m->num > 0) {
+            m->next = fullMags[node];
+            fullMags[node] = m;
+            depotObjs += m->num;
+        } else {
+            m->next = emptyMags;
+            emptyMags = m;
         }
     }
 
-    T* alloc()
+    bool Attach(ThreadCache& tc)
     {
-        lock.lock();
-        T* t = nullptr;
-        if (count == 0) {
-            if (basePtr != nullptr) {
-                t = reinterpret_cast<T*>(::operator new(sizeof(T)));
-#ifdef FFRT_BBOX_ENABLE
-                secondaryCache.insert(t);
-#endif
-                lock.unlock();
-                return t;
+        std::lock_guard lg(depotLock);
+        Magazine* loaded = NewMagazine();
+        Magazine* previous = NewMagazine();
+        if (loaded == nullptr || previous == nullptr) {
+            if (loaded != nullptr) {
+                PutMagazine(loaded, 0);
             }
-            init();
+            return false;
+        }
+        tc.loaded = loaded;
+        tc.previous = previous;
+        tc.owner = this;
+        tc.next = caches;
+        if (caches != nullptr) {
+            caches->prev = &tc;
         }
-        t = primaryCache.back();
-        primaryCache.pop_back();
-        count--;
-        lock.unlock();
-        return t;
+        caches = &tc;
+        return true;
     }
 
-    void free(T* t)
+    void Detach(ThreadCache& tc)
     {
-        lock.lock();
-        if (basePtr != nullptr &&
-            basePtr <= t &&
-            static_cast<size_t>(reinterpret_cast<uintptr_t>(t)) <
-            static_cast<size_t>(reinterpret_cast<uintptr_t>(basePtr)) + MmapSz) {
-            primaryCache.push_back(t);
-            count++;
+        int node = CurrentNode();
+        std::lock_guard lg(depotLock);
+        PutMagazine(tc.loaded, node);
+        PutMagazine(tc.previous, node);
+        if (tc.prev != nullptr) {
+            tc.prev->next = tc.next;
         } else {
-            ::operator delete(t);
-#ifdef FFRT_BBOX_ENABLE
-            secondaryCache.erase(t);
-#endif
+            caches = tc.next;
+        }
+        if (tc.next != nullptr) {
+            tc.next->prev = tc.prev;
         }
-        lock.unlock();
+        tc.owner = nullptr;
+        tc.loaded = nullptr;
+        tc.previous = nullptr;
+        tc.prev = nullptr;
+        tc.next = nullptr;
     }
 
-    SimpleAllocator()
+    bool MapChunk(int node)
     {
+#ifndef _MSC_VER
+        void* p = mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (p == MAP_FAILED) {
+            perror("mmap");
+            return false;
+        }
+#else
+        void* p = ::operator new(chunkSize, std::nothrow);
+        if (p == nullptr) {
+            return false;
+        }
+#endif
+        char* base = static_cast<char*>(p);
+        auto it = std::lower_bound(chunks.begin(), chunks.end(), base,
+            [](const Chunk& c, const char* b) { return c.base < b; });
+        chunks.insert(it, Chunk {base});
+        bumpBase[node] = base;
+        bumpCarved[node] = 0;
+        return true;
     }
-    ~SimpleAllocator()
+
+    void UnmapChunk(char* base)
     {
-#ifdef FFRT_BBOX_ENABLE
-        for (auto ite = secondaryCache.cbegin(); ite != secondaryCache.cend(); ite++) {
-            ::operator delete(*ite);
-        }
+#ifndef _MSC_VER
+        munmap(base, chunkSize);
+#else
+        ::operator delete(base);
 #endif
-        if (basePtr) {
-            ::operator delete(basePtr);
+    }
+
+    void* CarveOne(int node)
+    {
+        if (bumpBase[node] == nullptr || bumpCarved[node] == ObjsPerChunk()) {
+            if (!MapChunk(node)) {
+                return nullptr;
+            }
         }
+        carvedObjs++;
+        return bumpBase[node] + (bumpCarved[node]++) * objSize;
     }
-};
 
-#ifndef _MSC_VER
-template <typename T, std::size_t MmapSz = 16 * 1024 * 1024>
-class QSimpleAllocator {
-    static QSimpleAllocator<T, MmapSz>* instance(std::size_t size)
+    // fill an empty magazine with never used objects
+    bool Carve(Magazine* m, int node)
     {
-        static QSimpleAllocator<T, MmapSz> ins(size);
-        return &ins;
+        while (m->num < rounds) {
+            void* p = CarveOne(node);
+            if (p == nullptr) {
+                break;
+            }
+            m->Objs()[m->num++] = p;
+        }
+        return m->num > 0;
     }
-    std::size_t TSize;
-    std::mutex lock;
-    std::vector<T*> cache;
-    uint32_t flags = MAP_ANONYMOUS | MAP_PRIVATE;
 
-    bool expand()
+    // a full magazine of the node, of another node when it has none left, objects in the depot beat new ones
+    int FindFull(int node) const
     {
-        const int prot = PROT_READ | PROT_WRITE;
-        std::size_t sz = (TSize + 15UL) & -16UL;
-        char* p = reinterpret_cast<char*>(mmap(nullptr, MmapSz, prot, flags, -1, 0));
-        if (p == (char*)MAP_FAILED) {
-            if ((flags & MAP_HUGETLB) != 0) {
-                flags = MAP_ANONYMOUS | MAP_PRIVATE;
-                p = reinterpret_cast<char*>(mmap(nullptr, MmapSz, prot, flags, -1, 0));
+        for (int i = 0; i < NUMA_NODE_SLOT_NUM; i++) {
+            int n = (node + i) % NUMA_NODE_SLOT_NUM;
+            if (fullMags[n] != nullptr) {
+                return n;
             }
-            if (p == (char*)MAP_FAILED) {
-                perror("mmap");
-                return false;
+        }
+        return -1;
+    }
+
+    // depot only paths, used when the thread cache is not available
+    void* AllocDirect(int node)
+    {
+        int n = FindFull(node);
+        if (n < 0) {
+            return CarveOne(node);
+        }
+        Magazine* m = fullMags[n];
+        void* p = m->Objs()[--m->num];
+        depotObjs--;
+        if (m->num == 0) {
+            fullMags[n] = m->next;
+            PutMagazine(m, n);
+        }
+        return p;
+    }
+
+    void FreeDirect(void* p, int node)
+    {
+        if (fullMags[node] == nullptr || fullMags[node]->num == rounds) {
+            Magazine* m = NewMagazine();
+            if (m == nullptr) {
+                return; // no memory left to remember the object, leak it
             }
+            m->next = fullMags[node];
+            fullMags[node] = m;
+        }
+        fullMags[node]->Objs()[fullMags[node]->num++] = p;
+        depotObjs++;
+    }
+
+    void* AllocSlow(ThreadCache& tc)
+    {
+        int node = CurrentNode();
+        if (tc.owner == nullptr && (tc.exited || !Attach(tc))) {
+            std::lock_guard lg(depotLock);
+            return AllocDirect(node);
         }
-        for (std::size_t i = 0; i + sz <= MmapSz; i += sz) {
-            cache.push_back(reinterpret_cast<T*>(p + i));
+        if (tc.previous->num > 0) {
+            std::swap(tc.loaded, tc.previous);
+            return tc.loaded->Objs()[--tc.loaded->num];
         }
-        return true;
+
+        std::lock_guard lg(depotLock);
+        int n = FindFull(node);
+        if (n >= 0) {
+            Magazine* m = fullMags[n];
+            fullMags[n] = m->next;
+            m->next = nullptr;
+            depotObjs -= m->num;
+            PutMagazine(tc.previous, node);
+            tc.previous = tc.loaded;
+            tc.loaded = m;
+        } else if (!Carve(tc.loaded, node)) {
+            return nullptr;
+        }
+        return tc.loaded->Objs()[--tc.loaded->num];
     }
 
-    T* alloc()
+    void FreeSlow(ThreadCache& tc, void* p)
     {
-        T* p = nullptr;
-        lock.lock();
-        if (cache.empty()) {
-            if (!expand()) {
-                lock.unlock();
-                return nullptr;
+        if (tc.owner == nullptr && (tc.exited || !Attach(tc))) {
+            int node = CurrentNode();
+            std::lock_guard lg(depotLock);
+            FreeDirect(p, node);
+            return;
+        }
+        if (tc.previous->num == 0) {
+            std::swap(tc.loaded, tc.previous);
+            tc.loaded->Objs()[tc.loaded->num++] = p;
+            return;
+        }
+
+        int node = CurrentNode();
+        std::lock_guard lg(depotLock);
+        Magazine* m = NewMagazine();
+        if (m == nullptr) {
+            FreeDirect(p, node);
+            return;
+        }
+        PutMagazine(tc.previous, node);
+        tc.previous = tc.loaded;
+        tc.loaded = m;
+        tc.loaded->Objs()[tc.loaded->num++] = p;
+
+        if (depotObjs * objSize > TRIM_WATERMARK_CHUNKS * chunkSize && depotObjs >= nextTrimObjs) {
+            TrimLocked();
+            // do not rescan the depot on every exchange when nothing could be released
+            nextTrimObjs = depotObjs + ObjsPerChunk();
+        }
+    }
+
+    std::size_t FindChunk(const void* p) const
+    {
+        auto it = std::upper_bound(chunks.begin(), chunks.end(), static_cast<const char*>(p),
+            [](const char* b, const Chunk& c) { return b < c.base; });
+        return static_cast<std::size_t>(it - chunks.begin()) - 1;
+    }
+
+    std::size_t TrimLocked()
+    {
+        std::vector<std::size_t> freeNum(chunks.size(), 0);
+        for (Magazine* head : fullMags) {
+            for (Magazine* m = head; m != nullptr; m = m->next) {
+                for (std::size_t i = 0; i < m->num; i++) {
+                    freeNum[FindChunk(m->Objs()[i])]++;
+                }
             }
         }
-        p = cache.back();
-        cache.pop_back();
-        lock.unlock();
-        return p;
+
+        // a chunk can go once all of its objects are back in the depot, the bump chunks are kept
+        std::vector<bool> release(chunks.size(), false);
+        bool any = false;
+        for (std::size_t i = 0; i < chunks.size(); i++) {
+            if (!IsBump(chunks[i].base) && freeNum[i] == ObjsPerChunk()) {
+                release[i] = true;
+                any = true;
+            }
+        }
+        if (!any) {
+            return 0;
+        }
+
+        // repack the surviving objects, every node keeps its own
+        depotObjs = 0;
+        for (int node = 0; node < NUMA_NODE_SLOT_NUM; node++) {
+            std::vector<void*> remainObjs;
+            while (fullMags[node] != nullptr) {
+                Magazine* m = fullMags[node];
+                fullMags[node] = m->next;
+                for (std::size_t i = 0; i < m->num; i++) {
+                    if (!release[FindChunk(m->Objs()[i])]) {
+                        remainObjs.push_back(m->Objs()[i]);
+                    }
+                }
+                m->num = 0;
+                PutMagazine(m, node);
+            }
+            for (std::size_t i = 0; i < remainObjs.size();) {
+                Magazine* m = emptyMags;
+                emptyMags = m->next;
+                for (; i < remainObjs.size() && m->num < rounds; i++) {
+                    m->Objs()[m->num++] = remainObjs[i];
+                }
+                PutMagazine(m, node);
+            }
+        }
+
+        std::size_t released = 0;
+        std::vector<Chunk> remain;
+        for (std::size_t i = 0; i < chunks.size(); i++) {
+            if (release[i]) {
+                UnmapChunk(chunks[i].base);
+                carvedObjs -= ObjsPerChunk();
+                releasedChunks++;
+                released += chunkSize;
+            } else {
+                remain.push_back(chunks[i]);
+            }
+        }
+        chunks.swap(remain);
+
+        while (emptyMags != nullptr) {
+            Magazine* m = emptyMags;
+            emptyMags = m->next;
+            ::operator delete(m);
+        }
+        return released;
     }
 
-    void free(T* p)
+    const std::size_t objSize;
+    const std::size_t chunkSize;
+    const std::size_t rounds;
+
+    fast_mutex depotLock;
+    std::array<Magazine*, NUMA_NODE_SLOT_NUM> fullMags {};
+    Magazine* emptyMags = nullptr;
+    std::size_t depotObjs = 0;
+    std::size_t nextTrimObjs = 0;
+    ThreadCache* caches = nullptr;
+
+    std::vector<Chunk> chunks; // sorted by address
+    std::array<char*, NUMA_NODE_SLOT_NUM> bumpBase {}; // chunk each node carves from
+    std::array<std::size_t, NUMA_NODE_SLOT_NUM> bumpCarved {};
+    std::size_t carvedObjs = 0;
+    std::size_t releasedChunks = 0;
+};
+
+template <typename T, size_t MmapSz = BatchAllocSize>
+class SimpleAllocator {
+public:
+    SimpleAllocator(SimpleAllocator const&) = delete;
+    void operator=(SimpleAllocator const&) = delete;
+
+    static SimpleAllocator<T>* instance()
+    {
+        static SimpleAllocator<T>* ins = new SimpleAllocator<T>();
+        return ins;
+    }
+
+    // NOTE: call constructor after allocMem
+    static T* allocMem()
+    {
+        void* p = instance()->slab.Alloc();
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    // NOTE: call destructor before freeMem
+    static void freeMem(T* t)
+    {
+        t->~T();
+        instance()->slab.Free(t);
+    }
+
+    // only used for BBOX
+    static std::vector<T*> getUnfreedMem()
+    {
+        std::vector<T*> ret;
+        for (auto p : instance()->slab.GetUnfreed()) {
+            ret.push_back(static_cast<T*>(p));
+        }
+        return ret;
+    }
+
+    static SlabStats getStats()
+    {
+        return instance()->slab.GetStats();
+    }
+
+    static std::size_t trimMem()
     {
-        lock.lock();
-        cache.push_back(p);
-        lock.unlock();
+        return instance()->slab.Trim();
     }
 
-    QSimpleAllocator()
+private:
+    SimpleAllocator() : slab(sizeof(T), MmapSz, alignof(T))
     {
     }
 
+    MagazineSlab<SimpleAllocator<T, MmapSz>> slab;
+};
+
+#ifndef _MSC_VER
+template <typename T, std::size_t MmapSz = 16 * 1024 * 1024>
+class QSimpleAllocator {
+    static QSimpleAllocator<T, MmapSz>* instance(std::size_t size)
+    {
+        static QSimpleAllocator<T, MmapSz>* ins = new QSimpleAllocator<T, MmapSz>(size);
+        return ins;
+    }
+
+    MagazineSlab<QSimpleAllocator<T, MmapSz>> slab;
+
 public:
-    explicit QSimpleAllocator(std::size_t size = sizeof(T))
+    explicit QSimpleAllocator(std::size_t size = sizeof(T)) : slab(size, MmapSz)
     {
-        TSize = size;
     }
     QSimpleAllocator(QSimpleAllocator const&) = delete;
     void operator=(QSimpleAllocator const&) = delete;
 
     static T* allocMem(std::size_t size = sizeof(T))
     {
-        return instance(size)->alloc();
+        return static_cast<T*>(instance(size)->slab.Alloc());
     }
 
     static void freeMem(T* p, std::size_t size = sizeof(T))
     {
-        instance(size)->free(p);
+        instance(size)->slab.Free(p);
+    }
+
+    static SlabStats getStats(std::size_t size = sizeof(T))
+    {
+        return instance(size)->slab.GetStats();
+    }
+
+    static std::size_t trimMem(std::size_t size = sizeof(T))
+    {
+        return instance(size)->slab.Trim();
     }
 };
 #endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+class BarrierTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: LatchTest
+ * @tc.desc: Test whether latch waiters are released only once the count reaches zero.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BarrierTest, LatchTest, TestSize.Level1)
+{
+    constexpr int taskNum = 16;
+    ffrt::latch ready(taskNum);
+    ffrt::latch start(1);
+    std::atomic<int> started {0};
+    std::atomic<int> early {0};
+    for (int i = 0; i < taskNum; i++) {
+        ffrt::submit([&] {
+            ready.count_down();
+            start.wait();
+            if (!start.try_wait()) {
+                early++;
+            }
+            started++;
+        }, {}, {});
+    }
+    std::thread t([&] { start.wait(); started++; });
+    ready.wait();
+    EXPECT_TRUE(ready.try_wait());
+    EXPECT_FALSE(start.try_wait());
+    EXPECT_EQ(started.load(), 0);
+    start.count_down();
+    ffrt::wait();
+    t.join();
+    EXPECT_EQ(started.load(), taskNum + 1);
+    EXPECT_EQ(early.load(), 0);
+}
+
+/**
+ * @tc.name: PhaseTest
+ * @tc.desc: Test whether no participant enters a phase before all left the previous one, on a flat and a tree
+ *           barrier, and whether the completion runs once per phase.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BarrierTest, PhaseTest, TestSize.Level1)
+{
+    constexpr int phaseNum = 20;
+    for (int taskNum : {4, 100}) {
+        std::vector<int> progress(taskNum, 0);
+        std::atomic<int> skew {0};
+        int completions = 0;
+        ffrt::barrier sync(taskNum, [&completions]() noexcept { completions++; });
+        for (int i = 0; i < taskNum; i++) {
+            ffrt::submit([&, i] {
+                for (int p = 0; p < phaseNum; p++) {
+                    progress[i] = p;
+                    sync.arrive_and_wait();
+                    for (int j = 0; j < taskNum; j++) {
+                        if (progress[j] < p) {
+                            skew++;
+                        }
+                    }
+                    sync.arrive_and_wait();
+                }
+            }, {}, {});
+        }
+        ffrt::wait();
+        EXPECT_EQ(skew.load(), 0);
+        EXPECT_EQ(completions, phaseNum * 2);
+    }
+}
+
+/**
+ * @tc.name: DropTest
+ * @tc.desc: Test whether dropped participants are no longer waited for from the next phase on.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BarrierTest, DropTest, TestSize.Level1)
+{
+    constexpr int taskNum = 20;
+    constexpr int phaseNum = 10;
+    std::atomic<int> phases {0};
+    ffrt::barrier sync(taskNum, [&phases]() noexcept { phases++; });
+    for (int i = 0; i < taskNum; i++) {
+        ffrt::submit([&, i] {
+            // participant i leaves at phase i % phaseNum, all are gone after the last one
+            for (int p = 0; p < phaseNum; p++) {
+                if (p == i % phaseNum) {
+                    sync.arrive_and_drop();
+                    return;
+                }
+                sync.arrive_and_wait();
+            }
+        }, {}, {});
+    }
+    ffrt::wait();
+    EXPECT_EQ(phases.load(), phaseNum);
+}
+
+/**
+ * @tc.name: InvalidTest
+ * @tc.desc: Test whether an empty barrier and arrivals beyond the participants fail instead of hanging.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BarrierTest, InvalidTest, TestSize.Level1)
+{
+    ffrt_barrier_t empty;
+    EXPECT_EQ(ffrt_barrier_init(&empty, 0, nullptr, nullptr), ffrt_error_inval);
+    {
+        ffrt::barrier<> none(0);
+        none.arrive_and_drop();
+    }
+
+    ffrt_barrier_t one;
+    EXPECT_EQ(ffrt_barrier_init(&one, 1, nullptr, nullptr), ffrt_success);
+    EXPECT_EQ(ffrt_barrier_arrive_and_drop(&one), ffrt_success);
+    EXPECT_EQ(ffrt_barrier_arrive_and_wait(&one), ffrt_error_inval);
+    EXPECT_EQ(ffrt_barrier_destroy(&one), ffrt_success);
+}
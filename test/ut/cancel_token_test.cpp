@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+class CancelTokenTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: TokenTreeTest
+ * @tc.desc: Test whether cancelling a token cancels the tokens derived from it and no others.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CancelTokenTest, TokenTreeTest, TestSize.Level1)
+{
+    ffrt::cancel_token root;
+    ffrt::cancel_token child = root.child();
+    ffrt::cancel_token sibling = root.child();
+    ffrt::cancel_token grandchild = child.child();
+    EXPECT_FALSE(grandchild.cancelled());
+
+    child.cancel();
+    EXPECT_TRUE(child.cancelled());
+    EXPECT_TRUE(grandchild.cancelled());
+    EXPECT_FALSE(root.cancelled());
+    EXPECT_FALSE(sibling.cancelled());
+
+    ffrt::cancel_token late = child.child();
+    EXPECT_TRUE(late.cancelled());
+
+    // a parent released first is kept alive by its children
+    ffrt::cancel_token* parent = new ffrt::cancel_token(root.child());
+    ffrt::cancel_token orphan = parent->child();
+    delete parent;
+    root.cancel();
+    EXPECT_TRUE(orphan.cancelled());
+    EXPECT_TRUE(sibling.cancelled());
+}
+
+/**
+ * @tc.name: SubtreeTest
+ * @tc.desc: Test whether pending tasks spawned by a task inherit its token and are skipped once it is cancelled.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CancelTokenTest, SubtreeTest, TestSize.Level1)
+{
+    int gate = 0;
+    std::atomic<int> ran {0};
+    bool parentSawCancel = false;
+    ffrt::cancel_token token;
+
+    ffrt::submit([]() { ffrt::this_task::sleep_for(std::chrono::milliseconds(20)); }, {}, {&gate});
+    ffrt::submit([&]() {
+        for (int i = 0; i < 10; i++) {
+            ffrt::submit([&]() {
+                ran++;
+                ffrt::submit([&]() { ran++; });
+            }, {&gate}, {});
+        }
+        ffrt_cancel_token_cancel(ffrt_this_task_get_cancel_token());
+        parentSawCancel = ffrt::this_task::is_cancelled();
+    }, {}, {}, ffrt::task_attr().cancel_token(token));
+    ffrt::wait();
+
+    EXPECT_TRUE(token.cancelled());
+    EXPECT_TRUE(parentSawCancel);
+    EXPECT_EQ(ran.load(), 0);
+}
+
+/**
+ * @tc.name: DependentsTest
+ * @tc.desc: Test whether tasks reading the data of a cancelled task are skipped and still release their outputs.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CancelTokenTest, DependentsTest, TestSize.Level1)
+{
+    int gate = 0;
+    int a = 0;
+    int b = 0;
+    int c = 0;
+    int other = 0;
+    ffrt::cancel_token token;
+
+    ffrt::submit([]() { ffrt::this_task::sleep_for(std::chrono::milliseconds(20)); }, {}, {&gate});
+    ffrt::submit([&]() { a = 1; }, {&gate}, {&a}, ffrt::task_attr().cancel_token(token));
+    ffrt::submit([&]() { b = a + 1; }, {&a}, {&b});
+    ffrt::submit([&]() { c = b + 1; }, {&b}, {&c});
+    ffrt::submit([&]() { other = 1; }, {&gate}, {&other});
+    token.cancel();
+
+    ffrt::wait({&c});
+    ffrt::wait();
+    EXPECT_EQ(a + b + c, 0);
+    EXPECT_EQ(other, 1);
+
+    // the versions were released, later writers run as usual
+    ffrt::submit([&]() { c = 3; }, {}, {&c});
+    ffrt::wait({&c});
+    EXPECT_EQ(c, 3);
+}
+
+/**
+ * @tc.name: PollTest
+ * @tc.desc: Test whether a running task sees the cancellation of its token.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CancelTokenTest, PollTest, TestSize.Level1)
+{
+    ffrt::cancel_token token;
+    std::atomic<bool> started {false};
+    std::atomic<int> polls {0};
+    ffrt::submit([&]() {
+        started = true;
+        while (!ffrt::this_task::is_cancelled()) {
+            polls++;
+            ffrt::this_task::yield();
+        }
+    }, {}, {}, ffrt::task_attr().cancel_token(token));
+
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_FALSE(ffrt::this_task::is_cancelled());
+    token.cancel();
+    ffrt::wait();
+    EXPECT_GT(polls.load(), 0);
+}
+
+/**
+ * @tc.name: RuntimeTaskTest
+ * @tc.desc: Test whether queue drains and future continuations started by a cancelled task still run.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CancelTokenTest, RuntimeTaskTest, TestSize.Level1)
+{
+    ffrt::cancel_token token;
+    ffrt::queue serial("cancelled_pusher");
+    ffrt::queue concurrent(ffrt::queue_concurrent, "cancelled_pusher", ffrt::queue_attr().max_concurrency(2));
+    ffrt::promise<int> p;
+    auto next = p.get_future().then([](int v) { return v + 1; });
+    std::atomic<int> ran {0};
+    ffrt::submit([&]() {
+        ffrt_cancel_token_cancel(ffrt_this_task_get_cancel_token());
+        serial.submit([&]() { ran++; });
+        concurrent.submit([&]() { ran++; });
+        p.set_value(1);
+    }, {}, {}, ffrt::task_attr().cancel_token(token));
+    ffrt::wait();
+
+    ffrt::task_handle serialLast = serial.submit_h([&]() { ran++; });
+    ffrt::task_handle concurrentLast = concurrent.submit_h([&]() { ran++; });
+    serial.wait(serialLast);
+    concurrent.wait(concurrentLast);
+    EXPECT_EQ(ran.load(), 4);
+    EXPECT_EQ(next.get(), 2);
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+class ChannelTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+static void SendRecv(size_t capacity)
+{
+    constexpr int producerNum = 4;
+    constexpr int consumerNum = 4;
+    constexpr int itemNum = 5000;
+    ffrt::channel<int> ch(capacity);
+    std::atomic<long> sum {0};
+    std::atomic<int> producing {producerNum};
+    for (int i = 0; i < consumerNum; i++) {
+        ffrt::submit([&]() {
+            int v;
+            while (ch.recv(v)) {
+                sum += v;
+            }
+        }, {}, {});
+    }
+    for (int i = 0; i < producerNum; i++) {
+        ffrt::submit([&]() {
+            for (int v = 1; v <= itemNum; v++) {
+                EXPECT_TRUE(ch.send(v));
+            }
+            if (--producing == 0) {
+                ch.close();
+            }
+        }, {}, {});
+    }
+    ffrt::wait();
+    EXPECT_EQ(sum.load(), static_cast<long>(producerNum) * itemNum * (itemNum + 1) / 2);
+}
+
+/**
+ * @tc.name: SendRecvTest
+ * @tc.desc: Test whether all items reach the receivers through bounded and unbounded channels.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ChannelTest, SendRecvTest, TestSize.Level1)
+{
+    SendRecv(1);
+    SendRecv(16);
+    SendRecv(0);
+}
+
+/**
+ * @tc.name: BatchCloseTest
+ * @tc.desc: Test whether batches keep their order, try operations respect the capacity and close drains.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ChannelTest, BatchCloseTest, TestSize.Level1)
+{
+    ffrt::channel<std::string> ch(4);
+    EXPECT_TRUE(ch.try_send("a"));
+    std::vector<std::string> batch {"b", "c", "d"};
+    EXPECT_EQ(ch.send_n(batch.data(), batch.size()), 3U);
+    EXPECT_FALSE(ch.try_send("e"));
+
+    std::string out[8];
+    EXPECT_EQ(ch.recv_n(out, 8), 4U);
+    EXPECT_EQ(out[0] + out[1] + out[2] + out[3], "abcd");
+    EXPECT_FALSE(ch.try_recv(out[0]));
+
+    // a sender blocked on a full channel gets through once a receiver makes room
+    std::vector<int> items(64);
+    for (int i = 0; i < 64; i++) {
+        items[i] = i;
+    }
+    ffrt::channel<int> ints(2);
+    size_t sent = 0;
+    ffrt::submit([&]() { sent = ints.send_n(items.data(), items.size()); }, {}, {});
+    std::vector<int> got;
+    ffrt::submit([&]() {
+        int v[5];
+        while (got.size() < items.size()) {
+            size_t n = ints.recv_n(v, 5);
+            got.insert(got.end(), v, v + n);
+        }
+    }, {}, {});
+    ffrt::wait();
+    EXPECT_EQ(sent, items.size());
+    EXPECT_EQ(got, items);
+
+    ch.send("x");
+    ch.close();
+    EXPECT_TRUE(ch.closed());
+    EXPECT_FALSE(ch.send("y"));
+    EXPECT_TRUE(ch.recv(out[0]));
+    EXPECT_EQ(out[0], "x");
+    EXPECT_FALSE(ch.recv(out[0]));
+    EXPECT_EQ(ch.recv_n(out, 8), 0U);
+}
+
+/**
+ * @tc.name: SelectTest
+ * @tc.desc: Test whether select takes items from channels of different types until all are closed.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ChannelTest, SelectTest, TestSize.Level1)
+{
+    ffrt::channel<int> ints(2);
+    ffrt::channel<std::string> strs;
+    int intSum = 0;
+    size_t strLen = 0;
+    int fired[2] = {0, 0};
+    ffrt::submit([&]() {
+        for (;;) {
+            int idx = ffrt::select(ffrt::on_recv(ints, [&](int v) { intSum += v; }),
+                ffrt::on_recv(strs, [&](std::string s) { strLen += s.size(); }));
+            if (idx < 0) {
+                break;
+            }
+            fired[idx]++;
+        }
+    }, {}, {});
+    ffrt::submit([&]() {
+        for (int i = 1; i <= 100; i++) {
+            ints.send(i);
+        }
+        ints.close();
+    }, {}, {});
+    ffrt::submit([&]() {
+        for (int i = 0; i < 50; i++) {
+            strs.send("abc");
+        }
+        strs.close();
+    }, {}, {});
+    ffrt::wait();
+    EXPECT_EQ(intSum, 5050);
+    EXPECT_EQ(strLen, 150U);
+    EXPECT_EQ(fired[0], 100);
+    EXPECT_EQ(fired[1], 50);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include <cstring>
+#include "ffrt.h"
+#include "eu/co_stack_pool.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+class CoStackPoolTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: SizeClassTest
+ * @tc.desc: Test whether stack sizes are rounded to the pool size classes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoStackPoolTest, SizeClassTest, TestSize.Level1)
+{
+    EXPECT_EQ(CoStackPool::SizeClass(0), 1ULL << CO_STACK_MIN_SHIFT);
+    EXPECT_EQ(CoStackPool::SizeClass(1 << 20), 1ULL << 20);
+    EXPECT_EQ(CoStackPool::SizeClass((1 << 20) + 1), 1ULL << 21);
+    EXPECT_EQ(CoStackPool::SizeClass(100 * 1024), 128ULL * 1024);
+    EXPECT_EQ(CoStackPool::SizeClass(1ULL << 40), 1ULL << CO_STACK_MAX_SHIFT);
+}
+
+/**
+ * @tc.name: ReclaimTest
+ * @tc.desc: Test whether released stacks above the watermark give their pages back.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoStackPoolTest, ReclaimTest, TestSize.Level1)
+{
+    constexpr uint64_t stackSize = 256 * 1024;
+    constexpr std::size_t coNum = CO_STACK_HOT_WATERMARK * 4;
+    auto& pool = CoStackPool::Instance();
+    auto base = pool.GetStats();
+
+    std::vector<CoRoutine*> cos;
+    for (std::size_t i = 0; i < coNum; i++) {
+        CoRoutine* co = pool.Alloc(stackSize);
+        ASSERT_NE(co, nullptr);
+        EXPECT_EQ(co->stkMem.size, stackSize);
+        memset(co->stkMem.stk, 0x5a, co->stkMem.size);
+        cos.push_back(co);
+    }
+    auto busy = pool.GetStats();
+    EXPECT_EQ(busy.liveNum, base.liveNum + coNum);
+    EXPECT_GE(busy.residentBytes, base.residentBytes + coNum * stackSize);
+
+    for (auto co : cos) {
+        pool.Free(co);
+    }
+    auto idle = pool.GetStats();
+    EXPECT_EQ(idle.liveNum, base.liveNum);
+    EXPECT_EQ(idle.reservedBytes, busy.reservedBytes);
+    EXPECT_GT(idle.coldNum, base.coldNum);
+    EXPECT_LT(idle.residentBytes, busy.residentBytes - (coNum - CO_STACK_HOT_WATERMARK) * stackSize / 2);
+
+    // a reclaimed stack is handed out again zero filled
+    for (std::size_t i = 0; i < coNum; i++) {
+        cos[i] = pool.Alloc(stackSize);
+    }
+    EXPECT_EQ(cos.back()->stkMem.stk[0], 0);
+    for (auto co : cos) {
+        pool.Free(co);
+    }
+}
+
+/**
+ * @tc.name: TaskStackSizeTest
+ * @tc.desc: Test whether a task runs on a stack of the size set by task_attr.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoStackPoolTest, TaskStackSizeTest, TestSize.Level1)
+{
+    int ret = 0;
+    ffrt::submit([&] {
+        // touches more than the 16K minimum class
+        volatile char buf[64 * 1024];
+        memset(const_cast<char*>(buf), 1, sizeof(buf));
+        ret = buf[sizeof(buf) - 1];
+    }, {}, {&ret}, ffrt::task_attr().stack_size(128 * 1024));
+    ffrt::wait({&ret});
+    EXPECT_EQ(ret, 1);
+}
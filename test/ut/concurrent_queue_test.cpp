@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+class ConcurrentQueueTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: MaxConcurrencyTest
+ * @tc.desc: Test whether no more tasks than the max concurrency run at once.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ConcurrentQueueTest, MaxConcurrencyTest, TestSize.Level1)
+{
+    const int maxConcurrency = 3;
+    std::atomic<int> running {0};
+    std::atomic<int> peak {0};
+    std::atomic<int> done {0};
+    {
+        queue q(queue_concurrent, "max_concurrency", queue_attr().max_concurrency(maxConcurrency));
+        std::vector<task_handle> handles;
+        for (int i = 0; i < 30; i++) {
+            handles.emplace_back(q.submit_h([&] {
+                int now = ++running;
+                int old = peak.load();
+                while (now > old && !peak.compare_exchange_weak(old, now)) {
+                }
+                this_task::sleep_for(std::chrono::milliseconds(2));
+                running--;
+                done++;
+            }));
+        }
+        for (auto& handle : handles) {
+            q.wait(handle);
+        }
+    }
+    EXPECT_EQ(done.load(), 30);
+    EXPECT_LE(peak.load(), maxConcurrency);
+    EXPECT_GE(peak.load(), 1);
+}
+
+/**
+ * @tc.name: PriorityTest
+ * @tc.desc: Test whether waiting tasks run by priority and in submission order within one.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ConcurrentQueueTest, PriorityTest, TestSize.Level1)
+{
+    std::vector<int> order;
+    std::atomic<bool> release {false};
+    queue q(queue_concurrent, "priority", queue_attr().max_concurrency(1));
+    q.submit([&] {
+        while (!release.load()) {
+            this_task::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    q.submit([&] { order.push_back(3); }, task_attr().priority(ffrt_queue_priority_idle));
+    q.submit([&] { order.push_back(2); }, task_attr().priority(ffrt_queue_priority_low));
+    q.submit([&] { order.push_back(0); }, task_attr().priority(ffrt_queue_priority_immediate));
+    q.submit([&] { order.push_back(1); }, task_attr().priority(ffrt_queue_priority_high));
+    task_handle last = q.submit_h([&] { order.push_back(4); }, task_attr().priority(ffrt_queue_priority_idle));
+    release = true;
+    q.wait(last);
+    EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+/**
+ * @tc.name: DelayCancelTest
+ * @tc.desc: Test whether delayed tasks wait for their delay and cancelled tasks do not run.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ConcurrentQueueTest, DelayCancelTest, TestSize.Level1)
+{
+    std::atomic<int> ran {0};
+    queue q(queue_concurrent, "delay_cancel", queue_attr().max_concurrency(2));
+    auto start = std::chrono::steady_clock::now();
+    int64_t delayedAfterUs = 0;
+    task_handle delayed = q.submit_h([&] {
+        delayedAfterUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        ran++;
+    }, task_attr().delay(10000));
+    task_handle cancelled = q.submit_h([&] { ran += 100; }, task_attr().delay(50000));
+    EXPECT_EQ(q.cancel(cancelled), 0);
+    q.wait(delayed);
+    q.wait(cancelled);
+    EXPECT_EQ(ran.load(), 1);
+    EXPECT_GE(delayedAfterUs, 10000);
+    EXPECT_NE(q.cancel(delayed), 0);
+}
+
+/**
+ * @tc.name: TimeoutTest
+ * @tc.desc: Test whether the timeout callback fires for each of several tasks running too long at once.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ConcurrentQueueTest, TimeoutTest, TestSize.Level1)
+{
+    std::atomic<int> timeouts {0};
+    std::function<void()> cb = [&timeouts] { timeouts++; };
+    {
+        queue q(queue_concurrent, "timeout",
+            queue_attr().max_concurrency(2).timeout(1000).timeoutCb(cb));
+        std::vector<task_handle> handles;
+        for (int i = 0; i < 2; i++) {
+            handles.emplace_back(q.submit_h([] { this_task::sleep_for(std::chrono::milliseconds(20)); }));
+        }
+        for (auto& handle : handles) {
+            q.wait(handle);
+        }
+    }
+    EXPECT_EQ(timeouts.load(), 2);
+}
+
+/**
+ * @tc.name: ProducerWaitTest
+ * @tc.desc: Test whether a task pushing to a queue does not wait for the queue in its wait for its children.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ConcurrentQueueTest, ProducerWaitTest, TestSize.Level1)
+{
+    std::atomic<bool> produced {false};
+    queue q(queue_concurrent, "producer_wait", queue_attr().max_concurrency(2));
+    task_handle handle;
+    ffrt::submit([&] {
+        handle = q.submit_h([&] {
+            while (!produced.load()) {
+                this_task::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+        ffrt::wait();
+        produced = true;
+    }, {}, {});
+    ffrt::wait();
+    q.wait(handle);
+    EXPECT_TRUE(produced.load());
+}
@@ -63,8 +63,9 @@ HWTEST_F(CpuMonitorTest, GetMonitorTid, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     uint32_t tid;
     tid = cpu.GetMonitorTid();
@@ -82,8 +83,9 @@ HWTEST_F(CpuMonitorTest, HandleBlocked, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.HandleBlocked(5);
 }
@@ -100,8 +102,9 @@ HWTEST_F(CpuMonitorTest, DecExeNumRef, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.DecExeNumRef(5);
 }
@@ -118,8 +121,9 @@ HWTEST_F(CpuMonitorTest, IncSleepingRef, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.IncSleepingRef(5);
 }
@@ -136,8 +140,9 @@ HWTEST_F(CpuMonitorTest, DecSleepingRef, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.DecSleepingRef(5);
 }
@@ -154,8 +159,9 @@ HWTEST_F(CpuMonitorTest, IntoSleep, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.IntoSleep(5);
 }
@@ -172,8 +178,9 @@ HWTEST_F(CpuMonitorTest, WakeupCount, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.WakeupCount(5);
 }
@@ -190,48 +197,13 @@ HWTEST_F(CpuMonitorTest, TimeoutCount, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.TimeoutCount(5);
 }
 
-/**
- * @tc.name: RegWorker
- * @tc.desc: Test whether the RegWorker interface are normal.
- * @tc.type: FUNC
- *
- *
- */
-HWTEST_F(CpuMonitorTest, RegWorker, TestSize.Level1)
-{
-    CPUWorkerManager *it = new CPUWorkerManager();
-    CPUMonitor cpu({
-        std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
-
-    cpu.RegWorker(5);
-}
-
-/**
- * @tc.name: UnRegWorker
- * @tc.desc: Test whether the UnRegWorker interface are normal.
- * @tc.type: FUNC
- *
- *
- */
-HWTEST_F(CpuMonitorTest, UnRegWorker, TestSize.Level1)
-{
-    CPUWorkerManager *it = new CPUWorkerManager();
-    CPUMonitor cpu({
-        std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
-
-    cpu.UnRegWorker();
-}
-
 /**
  * @tc.name: Notify
  * @tc.desc: Test whether the Notify interface are normal.
@@ -244,8 +216,9 @@ HWTEST_F(CpuMonitorTest, Notify, TestSize.Level1)
     CPUWorkerManager *it = new CPUWorkerManager();
     CPUMonitor cpu({
         std::bind(&CPUWorkerManager::IncWorker, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1),
-        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1)});
+        std::bind(&CPUWorkerManager::WakeupWorkers, it, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&CPUWorkerManager::GetTaskCount, it, std::placeholders::_1),
+        std::bind(&CPUWorkerManager::GetBlockedNum, it, std::placeholders::_1)});
 
     cpu.Notify(5, TaskNotifyType(1));
 }
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+#include "util/cpu_topology.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+namespace {
+void MakeDirs(const std::string& path)
+{
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+        mkdir(path.substr(0, pos).c_str(), 0755);
+    }
+    mkdir(path.c_str(), 0755);
+}
+
+void WriteFile(const std::string& dir, const std::string& name, const std::string& content)
+{
+    MakeDirs(dir);
+    std::ofstream out(dir + "/" + name);
+    out << content << "\n";
+}
+
+void WriteCache(const std::string& root, int cpu, int index, const std::string& level, const std::string& type,
+    const std::string& shared)
+{
+    std::string dir = root + "/cpu/cpu" + std::to_string(cpu) + "/cache/index" + std::to_string(index);
+    WriteFile(dir, "level", level);
+    WriteFile(dir, "type", type);
+    WriteFile(dir, "shared_cpu_list", shared);
+}
+}
+
+class CpuTopologyTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: ParseCpuListTest
+ * @tc.desc: Test whether sysfs cpu lists are expanded, sorted and malformed parts skipped.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CpuTopologyTest, ParseCpuListTest, TestSize.Level1)
+{
+    EXPECT_EQ(CpuTopology::ParseCpuList("0-3,8,10-11"), std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(CpuTopology::ParseCpuList("5,1-2,2"), std::vector<int>({1, 2, 5}));
+    EXPECT_EQ(CpuTopology::ParseCpuList("x,3-1,4"), std::vector<int>({4}));
+    EXPECT_TRUE(CpuTopology::ParseCpuList("").empty());
+}
+
+/**
+ * @tc.name: TwoNodeTest
+ * @tc.desc: Test whether cpus are grouped by llc and numa node on a two node machine.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CpuTopologyTest, TwoNodeTest, TestSize.Level1)
+{
+    char tmpl[] = "/tmp/ffrt_topology_XXXXXX";
+    ASSERT_NE(mkdtemp(tmpl), nullptr);
+    std::string root = tmpl;
+
+    // node 0 has two l3 caches, node 1 one
+    WriteFile(root + "/cpu", "online", "0-7");
+    WriteFile(root + "/node/node0", "cpulist", "0-3");
+    WriteFile(root + "/node/node1", "cpulist", "4-7");
+    for (int cpu = 0; cpu < 8; cpu++) {
+        WriteCache(root, cpu, 0, "1", "Data", std::to_string(cpu));
+        WriteCache(root, cpu, 1, "1", "Instruction", std::to_string(cpu));
+        WriteCache(root, cpu, 2, "3", "Unified", cpu < 2 ? "0-1" : (cpu < 4 ? "2-3" : "4-7"));
+    }
+
+    CpuTopology topology(root, false);
+    EXPECT_EQ(topology.CpuNum(), 8);
+    EXPECT_EQ(topology.NodeNum(), 2);
+    EXPECT_EQ(topology.LlcNum(), 3);
+    EXPECT_EQ(topology.LlcCpus(0), std::vector<int>({0, 1}));
+    EXPECT_EQ(topology.LlcCpus(1), std::vector<int>({2, 3}));
+    EXPECT_EQ(topology.LlcCpus(2), std::vector<int>({4, 5, 6, 7}));
+    EXPECT_EQ(topology.NodeCpus(1), std::vector<int>({4, 5, 6, 7}));
+    EXPECT_EQ(topology.NodeOfLlc(1), 0);
+    EXPECT_EQ(topology.NodeOfLlc(2), 1);
+    EXPECT_EQ(topology.LlcOfCpu(3), 1);
+    EXPECT_EQ(topology.NodeOfCpu(6), 1);
+    EXPECT_EQ(topology.LlcOfCpu(100), 0);
+
+    std::string cmd = "rm -rf " + root;
+    EXPECT_EQ(system(cmd.c_str()), 0);
+}
+
+/**
+ * @tc.name: FallbackTest
+ * @tc.desc: Test whether a tree without topology information is one node and one llc group.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CpuTopologyTest, FallbackTest, TestSize.Level1)
+{
+    CpuTopology topology("/nonexistent", false);
+    EXPECT_EQ(topology.CpuNum(), static_cast<int>(std::max(1U, std::thread::hardware_concurrency())));
+    EXPECT_EQ(topology.NodeNum(), 1);
+    EXPECT_EQ(topology.LlcNum(), 1);
+    EXPECT_EQ(topology.CurrentLlc(), 0);
+    EXPECT_EQ(topology.CurrentNodeSlot(), 0);
+}
@@ -56,5 +56,5 @@ protected:
 HWTEST_F(CpuworkerManagerTest, NotifyTaskAdded, TestSize.Level1)
 {
     auto *it = new CPUWorkerManager();
-    it->NotifyTaskAdded(qos(5));
+    it->NotifyTaskAdded(qos(5), 1);
 }
@@ -19,6 +19,7 @@
 #include "internal_inc/osal.h"
 #include "sched/interval.h"
 #include "core/dependence_manager.h"
+#include "cpp/task.h"
 #include "sched/frame_interval.h"
 #include "dfx/log/ffrt_log_api.h"
 
@@ -163,3 +164,18 @@ HWTEST_F(DeadlineTest, qos_interval_leave_test, TestSize.Level1)
     interval ret1 = qos_interval_create(deadline_us, qos);
     qos_interval_leave(ret1);
 }
+
+/**
+ * @tc.name: deadline_miss_block_test
+ * @tc.desc: Test whether a late task that blocks on the way counts as one miss once it ends.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeadlineTest, deadline_miss_block_test, TestSize.Level1)
+{
+    QoS qos(static_cast<int>(qos_user_initiated));
+    uint64_t before = FFRTScheduler::Instance()->GetDeadlineMissNum(qos);
+    ffrt::submit([] { ffrt::this_task::sleep_for(std::chrono::milliseconds(2)); }, {}, {},
+        ffrt::task_attr().qos(qos_user_initiated).deadline(1));
+    ffrt::wait();
+    EXPECT_EQ(FFRTScheduler::Instance()->GetDeadlineMissNum(qos) - before, 1);
+}
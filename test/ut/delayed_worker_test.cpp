@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "sync/delayed_worker.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+class DelayedWorkerTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: ExpireTest
+ * @tc.desc: Test whether armed entries fire once and never before their deadline.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DelayedWorkerTest, ExpireTest, TestSize.Level1)
+{
+    constexpr int entryNum = 200;
+    DelayedWorker worker;
+    std::vector<WaitEntry> entries(entryNum);
+    std::vector<time_point_t> deadlines(entryNum);
+    std::vector<std::atomic_int> fired(entryNum);
+    std::atomic_int early {0};
+    std::function<void(WaitEntry*)> cb = [&](WaitEntry* we) {
+        int i = static_cast<int>(we - entries.data());
+        if (std::chrono::steady_clock::now() < deadlines[i]) {
+            early++;
+        }
+        fired[i]++;
+    };
+
+    auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < entryNum; i++) {
+        // spread over the first two levels of the wheel
+        deadlines[i] = now + std::chrono::microseconds(500 + (i * 997) % 200000);
+        EXPECT_TRUE(worker.dispatch(deadlines[i], &entries[i], cb));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    for (int i = 0; i < entryNum; i++) {
+        EXPECT_EQ(fired[i].load(), 1);
+    }
+    EXPECT_EQ(early.load(), 0);
+    EXPECT_FALSE(worker.dispatch(now, &entries[0], cb));
+}
+
+/**
+ * @tc.name: CancelTest
+ * @tc.desc: Test whether cancelled entries do not fire and fired ones can not be cancelled.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DelayedWorkerTest, CancelTest, TestSize.Level1)
+{
+    constexpr int entryNum = 1000;
+    DelayedWorker worker;
+    std::vector<WaitEntry> entries(entryNum);
+    std::atomic_int fired {0};
+    std::function<void(WaitEntry*)> cb = [&](WaitEntry*) { fired++; };
+
+    auto to = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    for (int i = 0; i < entryNum; i++) {
+        EXPECT_TRUE(worker.dispatch(to, &entries[i], cb));
+    }
+    for (int i = 0; i < entryNum; i += 2) {
+        EXPECT_TRUE(worker.cancel(&entries[i]));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(fired.load(), entryNum / 2);
+    EXPECT_FALSE(worker.cancel(&entries[1]));
+
+    // a cancelled entry can be armed again
+    EXPECT_TRUE(worker.dispatch(std::chrono::steady_clock::now() + std::chrono::milliseconds(1), &entries[0], cb));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(fired.load(), entryNum / 2 + 1);
+}
+
+/**
+ * @tc.name: FarExpireTest
+ * @tc.desc: Test whether entries on the upper levels are cascaded and fire in time.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DelayedWorkerTest, FarExpireTest, TestSize.Level1)
+{
+    DelayedWorker worker;
+    WaitEntry entry;
+    std::atomic<time_point_t> firedAt {time_point_t {}};
+    std::function<void(WaitEntry*)> cb = [&](WaitEntry*) { firedAt = std::chrono::steady_clock::now(); };
+
+    auto to = std::chrono::steady_clock::now() + std::chrono::milliseconds(800);
+    EXPECT_TRUE(worker.dispatch(to, &entry, cb));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+    EXPECT_GE(firedAt.load(), to);
+    EXPECT_LT(firedAt.load(), to + std::chrono::milliseconds(100));
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+class FutureTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: ThenChainTest
+ * @tc.desc: Test whether continuations run on the value set by a task and chain their results.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FutureTest, ThenChainTest, TestSize.Level1)
+{
+    ffrt::promise<int> p;
+    std::string out;
+    auto f = p.get_future()
+        .then([](int v) { return std::to_string(v * 2); })
+        .then([&out](std::string s) { out = s; });
+    ffrt::submit([&p] { p.set_value(21); }, {}, {});
+    f.get();
+    EXPECT_EQ(out, "42");
+
+    ffrt::promise<void> pv;
+    auto fv = pv.get_future().then([] { return 7; });
+    pv.set_value();
+    EXPECT_EQ(fv.get(), 7);
+    ffrt::wait();
+}
+
+/**
+ * @tc.name: ThenReadyTest
+ * @tc.desc: Test whether a continuation added to a ready future still runs.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FutureTest, ThenReadyTest, TestSize.Level1)
+{
+    ffrt::promise<int> p;
+    auto f = p.get_future();
+    p.set_value(5);
+    EXPECT_EQ(f.wait_for(std::chrono::milliseconds(0)), ffrt::future_status::ready);
+    EXPECT_EQ(f.then([](int v) { return v + 1; }).get(), 6);
+    EXPECT_FALSE(f.valid());
+    ffrt::wait();
+}
+
+/**
+ * @tc.name: WhenAllTest
+ * @tc.desc: Test whether when_all becomes ready once every future is, with all of them ready.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FutureTest, WhenAllTest, TestSize.Level1)
+{
+    constexpr int num = 8;
+    std::vector<ffrt::promise<int>> ps(num);
+    std::vector<ffrt::future<int>> fs;
+    for (auto& p : ps) {
+        fs.push_back(p.get_future());
+    }
+    auto all = ffrt::when_all(std::move(fs)).then([](std::vector<ffrt::future<int>> ready) {
+        int sum = 0;
+        for (auto& f : ready) {
+            sum += f.get();
+        }
+        return sum;
+    });
+    for (int i = 0; i < num; i++) {
+        ffrt::submit([&ps, i] { ps[i].set_value(i); }, {}, {});
+    }
+    EXPECT_EQ(all.get(), num * (num - 1) / 2);
+    EXPECT_EQ(ffrt::when_all(std::vector<ffrt::future<int>> {}).get().size(), 0U);
+    ffrt::wait();
+}
+
+/**
+ * @tc.name: WhenAnyTest
+ * @tc.desc: Test whether when_any reports the first future set and keeps the others usable.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FutureTest, WhenAnyTest, TestSize.Level1)
+{
+    std::vector<ffrt::promise<int>> ps(3);
+    std::vector<ffrt::future<int>> fs;
+    for (auto& p : ps) {
+        fs.push_back(p.get_future());
+    }
+    auto any = ffrt::when_any(std::move(fs));
+    ps[1].set_value(10);
+    auto res = any.get();
+    EXPECT_EQ(res.index, 1U);
+    EXPECT_EQ(res.futures[1].get(), 10);
+    ps[0].set_value(1);
+    ps[2].set_value(2);
+    EXPECT_EQ(res.futures[2].get(), 2);
+    ffrt::wait();
+}
+
+/**
+ * @tc.name: ReleaseTest
+ * @tc.desc: Test whether continuations are released when a promise goes away without a value.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FutureTest, ReleaseTest, TestSize.Level1)
+{
+    auto sentinel = std::make_shared<int>(0);
+    {
+        ffrt::promise<int> p;
+        auto f = p.get_future().then([sentinel](int v) { return v + *sentinel; });
+    }
+    EXPECT_EQ(sentinel.use_count(), 1);
+    {
+        std::vector<ffrt::promise<int>> ps(2);
+        std::vector<ffrt::future<int>> fs;
+        for (auto& p : ps) {
+            fs.push_back(p.get_future());
+        }
+        auto all = ffrt::when_all(std::move(fs)).then([sentinel](std::vector<ffrt::future<int>>) {
+            return 0;
+        });
+    }
+    EXPECT_EQ(sentinel.use_count(), 1);
+    {
+        std::vector<ffrt::promise<int>> ps(2);
+        std::vector<ffrt::future<int>> fs;
+        for (auto& p : ps) {
+            fs.push_back(p.get_future());
+        }
+        auto any = ffrt::when_any(std::move(fs)).then([sentinel](ffrt::when_any_result<std::vector<ffrt::future<int>>>) {
+            return 0;
+        });
+    }
+    EXPECT_EQ(sentinel.use_count(), 1);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <set>
+#include "util/inline_set.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+namespace {
+struct Item {
+    const void* key;
+};
+
+struct ItemKey {
+    const void* operator()(const Item* item) const
+    {
+        return item->key;
+    }
+};
+}
+
+class InlineSetTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: SpillTest
+ * @tc.desc: Test whether lookups, inserts and erases stay consistent once the set spills to the heap.
+ * @tc.type: FUNC
+ */
+HWTEST_F(InlineSetTest, SpillTest, TestSize.Level1)
+{
+    constexpr int num = 100;
+    int vals[num];
+    InlineSet<int*, 4> set;
+    for (int i = 0; i < num; i++) {
+        EXPECT_TRUE(set.insert(&vals[i]));
+        EXPECT_FALSE(set.insert(&vals[i]));
+    }
+    EXPECT_EQ(set.size(), static_cast<uint32_t>(num));
+    for (int i = 0; i < num; i += 2) {
+        EXPECT_TRUE(set.erase(&vals[i]));
+        EXPECT_FALSE(set.erase(&vals[i]));
+    }
+    std::set<int*> left(set.begin(), set.end());
+    EXPECT_EQ(left.size(), static_cast<size_t>(num / 2));
+    for (int i = 0; i < num; i++) {
+        EXPECT_EQ(set.find(&vals[i]) != set.end(), i % 2 == 1);
+    }
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert(&vals[0]));
+    EXPECT_EQ(set.find(&vals[1]), set.end());
+}
+
+/**
+ * @tc.name: KeyTest
+ * @tc.desc: Test whether values are unique by key and found by it, inline and spilled.
+ * @tc.type: FUNC
+ */
+HWTEST_F(InlineSetTest, KeyTest, TestSize.Level1)
+{
+    constexpr int num = 20;
+    int keys[num];
+    Item items[num];
+    Item others[num];
+    InlineSet<Item*, 2, ItemKey> set;
+    for (int i = 0; i < num; i++) {
+        items[i].key = &keys[i];
+        others[i].key = &keys[i];
+        EXPECT_TRUE(set.insert(&items[i]));
+        EXPECT_FALSE(set.insert(&others[i]));
+        EXPECT_EQ(set.find(&others[i]), set.end());
+    }
+    for (int i = 0; i < num; i++) {
+        auto it = set.find_key(&keys[i]);
+        ASSERT_NE(it, set.end());
+        EXPECT_EQ(*it, &items[i]);
+    }
+    // swap the value of a key the way a version merge does
+    EXPECT_TRUE(set.erase(&items[3]));
+    EXPECT_TRUE(set.insert(&others[3]));
+    EXPECT_EQ(*set.find_key(&keys[3]), &others[3]);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace {
+constexpr int TASK_NUM = 16;
+constexpr int LOCK_NUM = 1000;
+
+void Contend(ffrt::mutex& mtx, int& counter)
+{
+    for (int i = 0; i < TASK_NUM; i++) {
+        ffrt::submit([&]() {
+            for (int j = 0; j < LOCK_NUM; j++) {
+                std::lock_guard<ffrt::mutex> lk(mtx);
+                counter++;
+                if (j % 100 == 0) {
+                    ffrt::this_task::yield();
+                }
+            }
+        }, {}, {});
+    }
+    ffrt::wait();
+}
+}
+
+class MutexTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: AttrTest
+ * @tc.desc: Test whether mutex attrs keep the type and reject unknown ones.
+ * @tc.type: FUNC
+ */
+HWTEST_F(MutexTest, AttrTest, TestSize.Level1)
+{
+    ffrt_mutexattr_t attr;
+    int type = -1;
+    EXPECT_EQ(ffrt_mutexattr_init(&attr), ffrt_success);
+    EXPECT_EQ(ffrt_mutexattr_gettype(&attr, &type), ffrt_success);
+    EXPECT_EQ(type, ffrt_mutex_normal);
+    EXPECT_EQ(ffrt_mutexattr_settype(&attr, ffrt_mutex_handoff), ffrt_success);
+    EXPECT_EQ(ffrt_mutexattr_gettype(&attr, &type), ffrt_success);
+    EXPECT_EQ(type, ffrt_mutex_handoff);
+    EXPECT_EQ(ffrt_mutexattr_settype(&attr, 100), ffrt_error_inval);
+    EXPECT_EQ(ffrt_mutexattr_destroy(&attr), ffrt_success);
+}
+
+/**
+ * @tc.name: NormalContendTest
+ * @tc.desc: Test whether a contended normal mutex keeps the critical sections exclusive.
+ * @tc.type: FUNC
+ */
+HWTEST_F(MutexTest, NormalContendTest, TestSize.Level1)
+{
+    ffrt::mutex mtx;
+    int counter = 0;
+    Contend(mtx, counter);
+    EXPECT_EQ(counter, TASK_NUM * LOCK_NUM);
+    ffrt_mutex_stat_t s = mtx.stat();
+    EXPECT_EQ(s.handoff, 0U);
+    EXPECT_LE(s.spun, s.contended);
+}
+
+/**
+ * @tc.name: HandoffContendTest
+ * @tc.desc: Test whether a handoff mutex keeps the critical sections exclusive and grants parked waiters.
+ * @tc.type: FUNC
+ */
+HWTEST_F(MutexTest, HandoffContendTest, TestSize.Level1)
+{
+    ffrt::mutex mtx(ffrt_mutex_handoff);
+    int counter = 0;
+    Contend(mtx, counter);
+    EXPECT_EQ(counter, TASK_NUM * LOCK_NUM);
+
+    // a thread parked on a mutex a task holds gets it handed over
+    ffrt_mutex_stat_t before = mtx.stat();
+    mtx.lock();
+    std::thread t([&]() {
+        std::lock_guard<ffrt::mutex> lk(mtx);
+        counter++;
+    });
+    while (mtx.stat().parked == before.parked) {
+        std::this_thread::yield();
+    }
+    mtx.unlock();
+    t.join();
+    EXPECT_EQ(counter, TASK_NUM * LOCK_NUM + 1);
+    EXPECT_EQ(mtx.stat().handoff, before.handoff + 1);
+}
+
+/**
+ * @tc.name: CondMorphTest
+ * @tc.desc: Test whether waiters a notify moves onto a locked mutex all get it back, in both mutex modes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(MutexTest, CondMorphTest, TestSize.Level1)
+{
+    for (auto type : {ffrt_mutex_normal, ffrt_mutex_handoff}) {
+        ffrt::mutex mtx(type);
+        ffrt::condition_variable cv;
+        int waiting = 0;
+        int woken = 0;
+        bool go = false;
+        for (int i = 0; i < TASK_NUM; i++) {
+            ffrt::submit([&]() {
+                std::unique_lock<ffrt::mutex> lk(mtx);
+                waiting++;
+                cv.wait(lk, [&go] { return go; });
+                woken++;
+            }, {}, {});
+        }
+        ffrt::submit([&]() {
+            std::unique_lock<ffrt::mutex> lk(mtx);
+            while (waiting < TASK_NUM) {
+                lk.unlock();
+                ffrt::this_task::yield();
+                lk.lock();
+            }
+            go = true;
+            cv.notify_one();
+            cv.notify_all();
+        }, {}, {});
+        ffrt::wait();
+        EXPECT_EQ(woken, TASK_NUM);
+        EXPECT_TRUE(mtx.try_lock());
+        mtx.unlock();
+    }
+}
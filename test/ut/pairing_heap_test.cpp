@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "util/pairing_heap.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+namespace {
+struct HeapItem {
+    int64_t key;
+    uint64_t seq;
+    PairingHeapNode node;
+};
+
+struct HeapItemLess {
+    bool operator()(const HeapItem* a, const HeapItem* b) const
+    {
+        return a->key < b->key || (a->key == b->key && a->seq < b->seq);
+    }
+};
+
+using ItemHeap = PairingHeap<HeapItem, &HeapItem::node, HeapItemLess>;
+}
+
+class PairingHeapTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: OrderTest
+ * @tc.desc: Test whether elements are popped in key order and equal keys keep the push order.
+ * @tc.type: FUNC
+ */
+HWTEST_F(PairingHeapTest, OrderTest, TestSize.Level1)
+{
+    constexpr int itemNum = 10000;
+    std::mt19937 rng(1);
+    std::vector<HeapItem> items(itemNum);
+    ItemHeap heap;
+    for (int i = 0; i < itemNum; i++) {
+        items[i].key = static_cast<int64_t>(rng() % 100);
+        items[i].seq = static_cast<uint64_t>(i);
+        heap.Push(&items[i]);
+    }
+
+    const HeapItem* last = nullptr;
+    int popped = 0;
+    while (!heap.Empty()) {
+        HeapItem* item = heap.Pop();
+        if (last != nullptr) {
+            EXPECT_TRUE(HeapItemLess()(last, item));
+        }
+        last = item;
+        popped++;
+    }
+    EXPECT_EQ(popped, itemNum);
+    EXPECT_EQ(heap.Pop(), nullptr);
+}
+
+/**
+ * @tc.name: InterleaveTest
+ * @tc.desc: Test whether the top stays the minimum when pushes and pops interleave.
+ * @tc.type: FUNC
+ */
+HWTEST_F(PairingHeapTest, InterleaveTest, TestSize.Level1)
+{
+    constexpr int itemNum = 2000;
+    std::mt19937 rng(2);
+    std::vector<HeapItem> items(itemNum);
+    std::vector<HeapItem*> ref;
+    ItemHeap heap;
+    for (int i = 0; i < itemNum; i++) {
+        items[i].key = static_cast<int64_t>(rng() % 1000);
+        items[i].seq = static_cast<uint64_t>(i);
+        heap.Push(&items[i]);
+        ref.push_back(&items[i]);
+        if (i % 3 == 2) {
+            auto min = std::min_element(ref.begin(), ref.end(), HeapItemLess());
+            EXPECT_EQ(heap.Top(), *min);
+            EXPECT_EQ(heap.Pop(), *min);
+            ref.erase(min);
+        }
+    }
+}
+
+/**
+ * @tc.name: DecreaseKeyTest
+ * @tc.desc: Test whether lowered keys move elements up and popped elements are no longer contained.
+ * @tc.type: FUNC
+ */
+HWTEST_F(PairingHeapTest, DecreaseKeyTest, TestSize.Level1)
+{
+    constexpr int itemNum = 2000;
+    std::mt19937 rng(3);
+    std::vector<HeapItem> items(itemNum);
+    std::vector<HeapItem*> ref;
+    ItemHeap heap;
+    for (int i = 0; i < itemNum; i++) {
+        items[i].key = static_cast<int64_t>(rng() % 1000) + 1000;
+        items[i].seq = static_cast<uint64_t>(i);
+        heap.Push(&items[i]);
+        ref.push_back(&items[i]);
+    }
+    while (!ref.empty()) {
+        for (int j = 0; j < 3; j++) {
+            HeapItem* item = ref[rng() % ref.size()];
+            EXPECT_TRUE(heap.Contains(item));
+            item->key -= static_cast<int64_t>(rng() % 500);
+            heap.DecreaseKey(item);
+        }
+        auto min = std::min_element(ref.begin(), ref.end(), HeapItemLess());
+        EXPECT_EQ(heap.Top(), *min);
+        HeapItem* top = heap.Pop();
+        EXPECT_EQ(top, *min);
+        EXPECT_FALSE(heap.Contains(top));
+        ref.erase(min);
+    }
+    EXPECT_TRUE(heap.Empty());
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+class ParallelTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: ParallelForTest
+ * @tc.desc: Test whether parallel_for visits every index exactly once.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ParallelTest, ParallelForTest, TestSize.Level1)
+{
+    constexpr uint64_t size = 100000;
+    std::vector<std::atomic<int>> visited(size);
+    ffrt::parallel_for(0, size, 0, [&visited](uint64_t i) { visited[i]++; });
+    for (uint64_t i = 0; i < size; i++) {
+        EXPECT_EQ(visited[i].load(), 1);
+    }
+
+    // an empty range and a range of one grain run nothing and inline respectively
+    std::atomic<int> cnt {0};
+    ffrt::parallel_for(10, 10, 1, [&cnt](uint64_t) { cnt++; });
+    EXPECT_EQ(cnt, 0);
+    ffrt::parallel_for(0, 100, 100, [&cnt](uint64_t) { cnt++; });
+    EXPECT_EQ(cnt, 100);
+}
+
+/**
+ * @tc.name: ParallelReduceTest
+ * @tc.desc: Test whether parallel_reduce folds every index once, also when nested in a task.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ParallelTest, ParallelReduceTest, TestSize.Level1)
+{
+    constexpr uint64_t size = 100000;
+    auto sum = ffrt::parallel_reduce(0, size, 16, uint64_t(0), [](uint64_t i) { return i; },
+        [](uint64_t a, uint64_t b) { return a + b; });
+    EXPECT_EQ(sum, size * (size - 1) / 2);
+
+    uint64_t nested = 0;
+    ffrt::submit([&nested] {
+        nested = ffrt::parallel_reduce(0, size, 0, uint64_t(0), [](uint64_t i) {
+            // an inner loop per index
+            return ffrt::parallel_reduce(0, 4, 1, uint64_t(0), [i](uint64_t) { return i; },
+                [](uint64_t a, uint64_t b) { return a + b; });
+        }, [](uint64_t a, uint64_t b) { return a + b; }, ffrt::task_attr().qos(ffrt::qos_user_initiated));
+    }, {}, {&nested});
+    ffrt::wait({&nested});
+    EXPECT_EQ(nested, 4 * size * (size - 1) / 2);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+class SemaphoreTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: TryAcquireTest
+ * @tc.desc: Test whether the permits are taken and given back without waiters.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SemaphoreTest, TryAcquireTest, TestSize.Level1)
+{
+    ffrt::counting_semaphore<> sem(2);
+    EXPECT_TRUE(sem.try_acquire());
+    EXPECT_TRUE(sem.try_acquire());
+    EXPECT_FALSE(sem.try_acquire());
+    sem.release(3);
+    int value = 0;
+    EXPECT_EQ(ffrt_sem_getvalue(&sem, &value), ffrt_success);
+    EXPECT_EQ(value, 3);
+}
+
+/**
+ * @tc.name: BoundedConcurrencyTest
+ * @tc.desc: Test whether a semaphore bounds the tasks and threads inside while they switch out.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SemaphoreTest, BoundedConcurrencyTest, TestSize.Level1)
+{
+    constexpr int permits = 3;
+    constexpr int taskNum = 32;
+    ffrt::counting_semaphore<> sem(permits);
+    std::atomic<int> inside {0};
+    std::atomic<int> maxInside {0};
+    std::atomic<int> done {0};
+    auto body = [&] {
+        for (int i = 0; i < 20; i++) {
+            sem.acquire();
+            int n = ++inside;
+            int m = maxInside.load();
+            while (n > m && !maxInside.compare_exchange_weak(m, n)) {
+            }
+            ffrt::this_task::yield();
+            inside--;
+            sem.release();
+        }
+        done++;
+    };
+    for (int i = 0; i < taskNum; i++) {
+        ffrt::submit(body, {}, {});
+    }
+    std::thread t(body);
+    ffrt::wait();
+    t.join();
+    EXPECT_EQ(done.load(), taskNum + 1);
+    EXPECT_LE(maxInside.load(), permits);
+    int value = 0;
+    ffrt_sem_getvalue(&sem, &value);
+    EXPECT_EQ(value, permits);
+}
+
+/**
+ * @tc.name: BinarySemaphoreTest
+ * @tc.desc: Test whether a release wakes a task parked on a binary semaphore.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SemaphoreTest, BinarySemaphoreTest, TestSize.Level1)
+{
+    ffrt::binary_semaphore sem(0);
+    int x = 0;
+    ffrt::submit([&] {
+        sem.acquire();
+        x = 1;
+    }, {}, {});
+    ffrt::submit([&] { sem.release(); }, {}, {});
+    ffrt::wait();
+    EXPECT_EQ(x, 1);
+    EXPECT_FALSE(sem.try_acquire());
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+class SerialQueueTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: ProducerWaitTest
+ * @tc.desc: Test whether a task pushing to a queue does not wait for the queue in its wait for its children.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialQueueTest, ProducerWaitTest, TestSize.Level1)
+{
+    std::atomic<bool> produced {false};
+    queue q("producer_wait");
+    task_handle handle;
+    ffrt::submit([&] {
+        handle = q.submit_h([&] {
+            while (!produced.load()) {
+                this_task::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+        ffrt::wait();
+        produced = true;
+    }, {}, {});
+    ffrt::wait();
+    q.wait(handle);
+    EXPECT_TRUE(produced.load());
+}
+
+/**
+ * @tc.name: OrderTest
+ * @tc.desc: Test whether tasks run in submission order and due delayed tasks before later immediate ones.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialQueueTest, OrderTest, TestSize.Level1)
+{
+    std::vector<int> order;
+    queue q("order");
+    q.submit([&] {
+        order.push_back(0);
+        this_task::sleep_for(std::chrono::milliseconds(10));
+    });
+    // due while the first task still runs
+    q.submit([&] { order.push_back(1); }, task_attr().delay(1000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    for (int i = 2; i < 100; i++) {
+        q.submit([&order, i] { order.push_back(i); });
+    }
+    task_handle last = q.submit_h([&] { order.push_back(100); }, task_attr().delay(20000));
+    q.wait(last);
+
+    std::vector<int> expected;
+    for (int i = 0; i <= 100; i++) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(order, expected);
+}
+
+/**
+ * @tc.name: CancelTest
+ * @tc.desc: Test whether a cancelled immediate task and a cancelled delayed task do not run.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialQueueTest, CancelTest, TestSize.Level1)
+{
+    std::atomic<bool> release {false};
+    std::atomic<int> ran {0};
+    queue q("cancel");
+    q.submit([&] {
+        while (!release.load()) {
+            this_task::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    task_handle immediate = q.submit_h([&] { ran += 10; });
+    task_handle delayed = q.submit_h([&] { ran += 100; }, task_attr().delay(5000));
+    task_handle kept = q.submit_h([&] { ran++; });
+    EXPECT_EQ(q.cancel(immediate), 0);
+    EXPECT_EQ(q.cancel(delayed), 0);
+    release = true;
+
+    q.wait(immediate);
+    q.wait(delayed);
+    q.wait(kept);
+    task_handle last = q.submit_h([&] { ran++; }, task_attr().delay(10000));
+    q.wait(last);
+    EXPECT_EQ(ran.load(), 2);
+    EXPECT_NE(q.cancel(kept), 0);
+    EXPECT_NE(q.cancel(last), 0);
+}
+
+/**
+ * @tc.name: DestroyTest
+ * @tc.desc: Test whether a queue with pending delayed tasks goes down while its tasks keep pushing to it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialQueueTest, DestroyTest, TestSize.Level1)
+{
+    std::atomic<int> ran {0};
+    std::atomic<int> dropped {0};
+    // outlives the queue, a drain running it while the queue goes down still pushes through it
+    std::function<void()> produce;
+    {
+        queue q("destroy");
+        for (int i = 0; i < 20; i++) {
+            q.submit([&] { dropped++; }, task_attr().delay(1000000));
+        }
+        produce = [&] {
+            ran++;
+            q.submit(produce);
+            q.submit(produce, task_attr().delay(100));
+        };
+        q.submit(produce);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    int after = ran.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_GT(after, 0);
+    EXPECT_EQ(ran.load(), after);
+    EXPECT_EQ(dropped.load(), 0);
+}
+
+/**
+ * @tc.name: BudgetTest
+ * @tc.desc: Test whether a drain handing the worker back after its budget keeps the order of the rest.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialQueueTest, BudgetTest, TestSize.Level1)
+{
+    constexpr int taskNum = 400;
+    constexpr auto taskTime = std::chrono::microseconds(20);
+    std::vector<int> order;
+    std::atomic<bool> otherRan {false};
+    bool otherRanBeforeLast = false;
+    queue q("budget");
+    for (int i = 0; i < taskNum; i++) {
+        q.submit([&order, i, taskTime] {
+            auto end = std::chrono::steady_clock::now() + taskTime;
+            while (std::chrono::steady_clock::now() < end) {
+            }
+            order.push_back(i);
+        });
+    }
+    // the queue runs for several budgets, a task submitted meanwhile is not held back until it is empty
+    ffrt::submit([&] { otherRan = true; }, {}, {});
+    task_handle last = q.submit_h([&] { otherRanBeforeLast = otherRan.load(); });
+    q.wait(last);
+    ffrt::wait();
+
+    ASSERT_EQ(order.size(), static_cast<size_t>(taskNum));
+    for (int i = 0; i < taskNum; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+    EXPECT_TRUE(otherRanBeforeLast);
+}
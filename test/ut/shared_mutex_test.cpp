@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include "ffrt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+class SharedMutexTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: TryLockTest
+ * @tc.desc: Test whether try locks respect the readers and the writer holding the lock.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SharedMutexTest, TryLockTest, TestSize.Level1)
+{
+    ffrt::shared_mutex smtx;
+    EXPECT_TRUE(smtx.try_lock_shared());
+    EXPECT_TRUE(smtx.try_lock_shared());
+    EXPECT_FALSE(smtx.try_lock());
+    smtx.unlock_shared();
+    smtx.unlock_shared();
+    EXPECT_TRUE(smtx.try_lock());
+    EXPECT_FALSE(smtx.try_lock_shared());
+    EXPECT_FALSE(smtx.try_lock());
+    smtx.unlock();
+    EXPECT_TRUE(smtx.try_lock_shared());
+    smtx.unlock_shared();
+}
+
+/**
+ * @tc.name: ExclusiveTest
+ * @tc.desc: Test whether writers exclude each other and the readers while tasks and threads contend.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SharedMutexTest, ExclusiveTest, TestSize.Level1)
+{
+    constexpr int taskNum = 16;
+    constexpr int loopNum = 500;
+    ffrt::shared_mutex smtx;
+    int a = 0;
+    int b = 0;
+    std::atomic<int> torn {0};
+    auto body = [&](int i) {
+        for (int j = 0; j < loopNum; j++) {
+            if ((i + j) % 4 == 0) {
+                std::unique_lock lk(smtx);
+                a++;
+                ffrt::this_task::yield();
+                b++;
+            } else {
+                std::shared_lock lk(smtx);
+                if (a != b) {
+                    torn++;
+                }
+            }
+        }
+    };
+    for (int i = 0; i < taskNum; i++) {
+        ffrt::submit([&, i] { body(i); }, {}, {});
+    }
+    std::thread t(body, taskNum);
+    ffrt::wait();
+    t.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, (taskNum + 1) * loopNum / 4);
+}
+
+/**
+ * @tc.name: WriterPreferenceTest
+ * @tc.desc: Test whether a waiting writer turns new readers away and runs before them.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SharedMutexTest, WriterPreferenceTest, TestSize.Level1)
+{
+    ffrt::shared_mutex smtx;
+    std::atomic<int> step {0};
+    int order = 0;
+    int writerOrder = 0;
+    int readerOrder = 0;
+    smtx.lock_shared();
+    ffrt::submit([&] {
+        step = 1;
+        std::unique_lock lk(smtx);
+        writerOrder = ++order;
+    }, {}, {});
+    while (smtx.try_lock_shared()) {
+        smtx.unlock_shared();
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(step.load(), 1);
+    ffrt::submit([&] {
+        std::shared_lock lk(smtx);
+        readerOrder = ++order;
+    }, {}, {});
+    smtx.unlock_shared();
+    ffrt::wait();
+    EXPECT_EQ(writerOrder, 1);
+    EXPECT_EQ(readerOrder, 2);
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <set>
+#include "util/slab.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+namespace {
+struct SlabObj {
+    uint64_t payload[24];
+};
+
+struct TrimObj {
+    uint64_t payload[64];
+};
+
+struct alignas(64) AlignedObj {
+    uint64_t payload[3];
+};
+}
+
+class SlabTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: AllocFreeTest
+ * @tc.desc: Test whether allocated objects are distinct and recycled.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SlabTest, AllocFreeTest, TestSize.Level1)
+{
+    std::set<SlabObj*> objs;
+    for (int i = 0; i < 10000; i++) {
+        auto obj = new (SimpleAllocator<SlabObj>::allocMem()) SlabObj();
+        EXPECT_TRUE(objs.insert(obj).second);
+    }
+    auto stats = SimpleAllocator<SlabObj>::getStats();
+    EXPECT_GE(stats.carvedObjs, 10000);
+    EXPECT_EQ(SimpleAllocator<SlabObj>::getUnfreedMem().size(), 10000);
+
+    for (auto obj : objs) {
+        SimpleAllocator<SlabObj>::freeMem(obj);
+    }
+    EXPECT_EQ(SimpleAllocator<SlabObj>::getUnfreedMem().size(), 0);
+
+    // freed objects are reused before new ones are carved
+    auto obj = SimpleAllocator<SlabObj>::allocMem();
+    EXPECT_TRUE(objs.count(obj) == 1);
+    EXPECT_EQ(SimpleAllocator<SlabObj>::getStats().carvedObjs, stats.carvedObjs);
+    SimpleAllocator<SlabObj>::freeMem(new (obj) SlabObj());
+}
+
+/**
+ * @tc.name: CrossThreadTest
+ * @tc.desc: Test whether objects freed by other threads and exited threads are recycled.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SlabTest, CrossThreadTest, TestSize.Level1)
+{
+    constexpr int threadNum = 4;
+    constexpr int objNum = 5000;
+    std::vector<std::vector<SlabObj*>> objs(threadNum);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; i++) {
+        threads.emplace_back([&objs, i] {
+            for (int j = 0; j < objNum; j++) {
+                objs[i].push_back(new (SimpleAllocator<SlabObj>::allocMem()) SlabObj());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    threads.clear();
+
+    std::set<SlabObj*> uniq;
+    for (int i = 0; i < threadNum; i++) {
+        uniq.insert(objs[i].begin(), objs[i].end());
+        threads.emplace_back([&objs, i] {
+            // free what the neighbour allocated
+            for (auto obj : objs[(i + 1) % threadNum]) {
+                SimpleAllocator<SlabObj>::freeMem(obj);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(uniq.size(), static_cast<size_t>(threadNum * objNum));
+    EXPECT_EQ(SimpleAllocator<SlabObj>::getUnfreedMem().size(), 0);
+}
+
+/**
+ * @tc.name: TrimTest
+ * @tc.desc: Test whether fully free chunks are returned to the os.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SlabTest, TrimTest, TestSize.Level1)
+{
+    std::vector<TrimObj*> objs;
+    for (int i = 0; i < 50000; i++) {
+        objs.push_back(SimpleAllocator<TrimObj>::allocMem());
+    }
+    auto before = SimpleAllocator<TrimObj>::getStats();
+    EXPECT_GT(before.chunkNum, 1);
+
+    // objects freed on an exiting thread end up in the depot
+    std::thread t([&objs] {
+        for (auto obj : objs) {
+            SimpleAllocator<TrimObj>::freeMem(obj);
+        }
+    });
+    t.join();
+
+    SimpleAllocator<TrimObj>::trimMem();
+    auto after = SimpleAllocator<TrimObj>::getStats();
+    EXPECT_LT(after.chunkNum, before.chunkNum);
+    EXPECT_GT(after.releasedChunks, 0);
+    EXPECT_EQ(after.reservedBytes, after.chunkNum * after.chunkSize);
+}
+
+/**
+ * @tc.name: AlignTest
+ * @tc.desc: Test whether over-aligned objects are carved at their alignment.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SlabTest, AlignTest, TestSize.Level1)
+{
+    std::vector<AlignedObj*> objs;
+    for (int i = 0; i < 1000; i++) {
+        auto obj = SimpleAllocator<AlignedObj>::allocMem();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(obj) % alignof(AlignedObj), 0);
+        objs.push_back(obj);
+    }
+    for (auto obj : objs) {
+        SimpleAllocator<AlignedObj>::freeMem(obj);
+    }
+}
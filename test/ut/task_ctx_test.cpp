@@ -14,6 +14,7 @@
  */
 #include <gtest/gtest.h>
 #include <thread>
+#include <atomic>
 #include "core/task_ctx.h"
 #include "core/dependence_manager.h"
 #include "sched/qos.h"
@@ -73,3 +74,119 @@ HWTEST_F(TaskCtxTest, ChargeQoSSubmit, TestSize.Level1)
     EXPECT_EQ(task3->qos, qos_user_interactive);
     delete task3;
 }
+
+/**
+ * @tc.name: NonblockingTask
+ * @tc.desc: Test whether non-blocking tasks run without a coroutine.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskCtxTest, NonblockingTask, TestSize.Level1)
+{
+    int x = 0;
+    bool stackless = false;
+    ffrt::submit([&] {
+        stackless = ExecuteCtx::Cur()->task->coRoutine == nullptr;
+        x++;
+    }, {}, {&x}, task_attr().nonblocking(true));
+    ffrt::wait({&x});
+    EXPECT_TRUE(stackless);
+    EXPECT_EQ(x, 1);
+}
+
+/**
+ * @tc.name: NonblockingTaskBlocks
+ * @tc.desc: Test whether a non-blocking task that blocks aborts instead of holding its worker.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskCtxTest, NonblockingTaskBlocks, TestSize.Level1)
+{
+#ifndef FFRT_RELEASE
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_DEATH({
+        int x = 0;
+        ffrt::submit([&] { ffrt::this_task::sleep_for(std::chrono::microseconds(10)); }, {}, {&x},
+            task_attr().nonblocking(true));
+        ffrt::wait({&x});
+    }, "");
+#endif
+}
+
+/**
+ * @tc.name: SubmitBatch
+ * @tc.desc: Test whether tasks submitted in a batch run once and honour the deps inside the batch.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskCtxTest, SubmitBatch, TestSize.Level1)
+{
+    constexpr int taskNum = 1000;
+    std::atomic<int> cnt {0};
+    std::vector<std::function<void()>> funcs;
+    for (int i = 0; i < taskNum; i++) {
+        funcs.emplace_back([&cnt] { cnt++; });
+    }
+    ffrt::submit_n(std::move(funcs));
+    ffrt::wait();
+    EXPECT_EQ(cnt, taskNum);
+
+    // every task reads and writes x, so they run in submit order
+    int x = 0;
+    std::vector<int> order;
+    std::vector<std::vector<const void*>> deps;
+    funcs.clear();
+    for (int i = 0; i < taskNum; i++) {
+        funcs.emplace_back([&order, i] { order.push_back(i); });
+        deps.push_back({&x});
+    }
+    ffrt::submit_n(std::move(funcs), deps, deps, task_attr().qos(qos_user_initiated));
+    ffrt::wait({&x});
+    ASSERT_EQ(order.size(), static_cast<size_t>(taskNum));
+    for (int i = 0; i < taskNum; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+
+    // delayed tasks fall back to single submits
+    funcs.clear();
+    funcs.emplace_back([&cnt] { cnt++; });
+    funcs.emplace_back([&cnt] { cnt++; });
+    ffrt::submit_n(std::move(funcs), {}, {}, task_attr().delay(100));
+    ffrt::wait();
+    EXPECT_EQ(cnt, taskNum + 2);
+}
+
+/**
+ * @tc.name: DeadlineBoost
+ * @tc.desc: Test whether a deadline given to a data wait is lent to the producers upstream only.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskCtxTest, DeadlineBoost, TestSize.Level1)
+{
+    auto boosted = [](const task_handle& h) {
+        auto task = static_cast<TaskCtx*>(CVT_HANDLE_TO_TASK(static_cast<void*>(h)));
+        return task->boostDdl.load() != INT64_MAX;
+    };
+    std::atomic<bool> release {false};
+    int x = 0;
+    int y = 0;
+    int z = 0;
+    auto first = ffrt::submit_h([&] {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        x++;
+    }, {}, {&x});
+    auto second = ffrt::submit_h([&] { y = x + 1; }, {&x}, {&y});
+    auto other = ffrt::submit_h([&] { z++; }, {}, {&z});
+
+    std::thread waiter([&] { ffrt::wait({&y}, 1000000); });
+    for (int i = 0; i < 10000 && !boosted(first); i++) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    EXPECT_TRUE(boosted(first));
+    EXPECT_TRUE(boosted(second));
+    release = true;
+    waiter.join();
+    EXPECT_EQ(y, 2);
+
+    ffrt::wait({&z});
+    EXPECT_FALSE(boosted(other));
+}
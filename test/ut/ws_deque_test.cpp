@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "sched/task_runqueue.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace ffrt;
+
+namespace {
+TaskCtx* FakeTask(uintptr_t i)
+{
+    return reinterpret_cast<TaskCtx*>(i << 4);
+}
+}
+
+class WSDequeTest : public testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * @tc.name: OwnerLifoTest
+ * @tc.desc: Test whether the owner side pops in LIFO order and the deque grows.
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSDequeTest, OwnerLifoTest, TestSize.Level1)
+{
+    WSDeque que(4);
+    EXPECT_TRUE(que.Empty());
+    for (uintptr_t i = 1; i <= 100; i++) {
+        que.EnQueue(FakeTask(i));
+    }
+    EXPECT_EQ(que.Size(), 100);
+    for (uintptr_t i = 100; i >= 1; i--) {
+        EXPECT_EQ(que.DeQueue(), FakeTask(i));
+    }
+    EXPECT_EQ(que.DeQueue(), nullptr);
+    EXPECT_TRUE(que.Empty());
+}
+
+/**
+ * @tc.name: StealFifoTest
+ * @tc.desc: Test whether thieves take from the opposite end in FIFO order.
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSDequeTest, StealFifoTest, TestSize.Level1)
+{
+    WSDeque que;
+    for (uintptr_t i = 1; i <= 3; i++) {
+        que.EnQueue(FakeTask(i));
+    }
+    EXPECT_EQ(que.Steal(), FakeTask(1));
+    EXPECT_EQ(que.DeQueue(), FakeTask(3));
+    EXPECT_EQ(que.Steal(), FakeTask(2));
+    EXPECT_EQ(que.Steal(), nullptr);
+    EXPECT_EQ(que.DeQueue(), nullptr);
+}
+
+/**
+ * @tc.name: ConcurrentStealTest
+ * @tc.desc: Test whether every task is taken exactly once under concurrent stealing.
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSDequeTest, ConcurrentStealTest, TestSize.Level1)
+{
+    constexpr uintptr_t taskNum = 100000;
+    constexpr int thiefNum = 4;
+    WSDeque que(8);
+    std::vector<std::atomic<int>> taken(taskNum + 1);
+    std::atomic<bool> done {false};
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < thiefNum; i++) {
+        thieves.emplace_back([&] {
+            while (!done.load() || !que.Empty()) {
+                TaskCtx* task = que.Steal();
+                if (task != nullptr) {
+                    taken[reinterpret_cast<uintptr_t>(task) >> 4]++;
+                }
+            }
+        });
+    }
+
+    for (uintptr_t i = 1; i <= taskNum; i++) {
+        que.EnQueue(FakeTask(i));
+        if (i % 3 == 0) {
+            TaskCtx* task = que.DeQueue();
+            if (task != nullptr) {
+                taken[reinterpret_cast<uintptr_t>(task) >> 4]++;
+            }
+        }
+    }
+    done = true;
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    for (uintptr_t i = 1; i <= taskNum; i++) {
+        EXPECT_EQ(taken[i].load(), 1);
+    }
+}